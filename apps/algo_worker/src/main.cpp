@@ -6,7 +6,9 @@
 #include "common/ipc/IpcServer.h"
 #include "common/ipc/Protocol.h"
 #include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/time/MonotonicClock.h"
+#include "common/trace/Spans.h"
 
 #include <cstdint>
 #include <iostream>
@@ -51,6 +53,14 @@ class AlgoWorkerApp : public ServerApplication {
     loadConfiguration();
     ServerApplication::initialize(self);
     common::log::InitFromConfig(common::config::WrapPocoConfig(config()), this->commandName());
+    common::rt::InitFromConfig(common::config::WrapPocoConfig(config()));
+    common::trace::StartSpans(common::trace::LoadSpanParams(common::config::WrapPocoConfig(config())), this->commandName());
+  }
+
+  void uninitialize() override {
+    common::trace::StopSpans();
+    common::log::StopAsync();
+    ServerApplication::uninitialize();
   }
 
   int main(const std::vector<std::string>& args) override {
@@ -58,6 +68,7 @@ class AlgoWorkerApp : public ServerApplication {
     signal(SIGTERM, handle_signal);
 
     common::log::SetThreadName("main");
+    common::rt::ConfigureCurrentThread("main");
     common::log::Info("main", "algo_worker starting");
 
     common::fault::FaultInjector fault(common::fault::FaultInjector::LoadFromConfig(common::config::WrapPocoConfig(config())));
@@ -99,6 +110,7 @@ class AlgoWorkerApp : public ServerApplication {
 
 private:
     common::ipc::AlgoResult makeResult(const common::ipc::SensorFrame& in, int computeDelayMs, common::fault::FaultInjector& fault) {
+        MRCD_TRACE_SPAN_SEQ("worker.compute", in.seq);
         const auto t0 = common::time::NowMonotonicNs();
 
         fault.applyExtraDelay();
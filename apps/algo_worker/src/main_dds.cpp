@@ -4,8 +4,12 @@
 
 #include "common/config/ConfigPoco.h"
 #include "common/ipc/Protocol.h"
+#include "common/log/BinaryLog.h"
 #include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/time/MonotonicClock.h"
+#include "common/trace/SampleTrace.h"
+#include "common/trace/Spans.h"
 
 #include <Poco/Util/ServerApplication.h>
 
@@ -16,6 +20,7 @@
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <cstdint>
 #include <thread>
 #if defined(_WIN32)
 #include <io.h>
@@ -30,8 +35,12 @@ static std::atomic<bool> g_shutdown{false};
 
 void on_signal(int) { g_shutdown.store(true); }
 
-static ControlCommand makeControlCommand(const JointState& js, int computeDelayMs) {
+static ControlCommand makeControlCommand(const JointState& js, std::uint64_t receivedNs, int computeDelayMs) {
+  using common::trace::Index;
+  using common::trace::Stage;
+
   ControlCommand cmd;
+  const auto computeStartNs = common::time::NowMonotonicNs();
   for (int i = 0; i < 6; ++i) {
     cmd.target_position()[i] = 0.6 * js.position()[i] + 0.3 * js.velocity()[i] + 0.1 * (i + 1);
   }
@@ -39,6 +48,14 @@ static ControlCommand makeControlCommand(const JointState& js, int computeDelayM
     std::this_thread::sleep_for(std::chrono::milliseconds(computeDelayMs));
   }
   cmd.timestamp(common::time::NowMonotonicNs());
+  cmd.sensor_seq(js.sensor_seq());
+  // Echo the controller's trace and add the worker stages; untraced (repeated) samples stay all-zero.
+  if (js.trace_ns()[Index(Stage::ControlPickup)] != 0) {
+    cmd.trace_ns() = js.trace_ns();
+    cmd.trace_ns()[Index(Stage::WorkerReceive)] = receivedNs;
+    cmd.trace_ns()[Index(Stage::ComputeStart)] = computeStartNs;
+    cmd.trace_ns()[Index(Stage::ComputeEnd)] = cmd.timestamp();
+  }
   return cmd;
 }
 
@@ -51,6 +68,17 @@ class AlgoWorkerDdsApp : public ServerApplication {
     loadConfiguration();
     ServerApplication::initialize(self);
     common::log::InitFromConfig(common::config::WrapPocoConfig(config()), commandName());
+    common::rt::InitFromConfig(common::config::WrapPocoConfig(config()));
+    common::trace::StartSpans(common::trace::LoadSpanParams(common::config::WrapPocoConfig(config())), commandName());
+    common::log::binary::StartBinaryLog(common::log::binary::LoadBinaryLogParams(common::config::WrapPocoConfig(config())),
+                                        commandName());
+  }
+
+  void uninitialize() override {
+    common::trace::StopSpans();
+    common::log::binary::StopBinaryLog();
+    common::log::StopAsync();
+    ServerApplication::uninitialize();
   }
 
   int main(const std::vector<std::string>& args) override {
@@ -58,6 +86,7 @@ class AlgoWorkerDdsApp : public ServerApplication {
     std::signal(SIGTERM, on_signal);
 
     common::log::SetThreadName("main");
+    common::rt::ConfigureCurrentThread("main");
     common::log::Info("main", "algo_worker (DDS PlannerNode) starting");
 
     int domain_id = config().getInt("dds.domain_id", 0);
@@ -96,9 +125,13 @@ class AlgoWorkerDdsApp : public ServerApplication {
     while (!g_shutdown.load()) {
       if (reader->wait_for_unread_message(timeout)) {
         while (eprosima::fastdds::dds::RETCODE_OK == reader->take_next_sample(&js, &info)) {
+          const auto receivedNs = common::time::NowMonotonicNs();
           if (info.valid_data) {
-            cmd = makeControlCommand(js, computeDelayMs);
+            MRCD_TRACE_SPAN_SEQ("worker.compute", js.sensor_seq());
+            cmd = makeControlCommand(js, receivedNs, computeDelayMs);
             writer->write(&cmd);
+            MRCD_BLOG("worker", "compute seq={} receive_to_write_ns={}", js.sensor_seq(),
+                      common::time::NowMonotonicNs() - receivedNs);
           }
         }
       }
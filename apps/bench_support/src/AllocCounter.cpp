@@ -0,0 +1,159 @@
+#include "AllocCounter.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+// Counts heap allocations per thread for stress_test and ui_bench. The cost is one thread-local increment per call.
+//
+// glibc: malloc, calloc, realloc, reallocarray, posix_memalign, aligned_alloc, memalign, valloc and pvalloc are
+// interposed and forwarded to glibc's __libc_* entry points. operator new in every form (plain, array, nothrow,
+// aligned) ends in one of these, as do the allocations Qt and other libraries make with malloc.
+// Elsewhere: only the replaceable operator new forms are covered, all of them; direct malloc calls are not counted.
+
+namespace {
+
+#if defined(__GLIBC__)
+// initial-exec: reading the counter must not call __tls_get_addr, which may itself allocate.
+__attribute__((tls_model("initial-exec")))
+#endif
+thread_local std::uint64_t tAllocations = 0;
+
+} // namespace
+
+namespace bench {
+
+std::uint64_t ThreadAllocations() {
+  return tAllocations;
+}
+
+} // namespace bench
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void* __libc_valloc(std::size_t size);
+void* __libc_pvalloc(std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_realloc(p, size);
+}
+
+void* reallocarray(void* p, std::size_t count, std::size_t size) noexcept {
+  ++tAllocations;
+  if (size != 0 && count > static_cast<std::size_t>(-1) / size) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+  return __libc_realloc(p, count * size);
+}
+
+int posix_memalign(void** out, std::size_t alignment, std::size_t size) noexcept {
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0) return EINVAL;
+  ++tAllocations;
+  void* p = __libc_memalign(alignment, size);
+  if (!p) return ENOMEM;
+  *out = p;
+  return 0;
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_memalign(alignment, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_memalign(alignment, size);
+}
+
+void* valloc(std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_valloc(size);
+}
+
+void* pvalloc(std::size_t size) noexcept {
+  ++tAllocations;
+  return __libc_pvalloc(size);
+}
+}
+#else
+namespace {
+
+void* Allocate(std::size_t size) noexcept {
+  ++tAllocations;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* AllocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+  ++tAllocations;
+  const auto align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+  return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+  void* p = nullptr;
+  return posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align, size == 0 ? 1 : size) == 0 ? p : nullptr;
+#endif
+}
+
+void FreeAligned(void* p) noexcept {
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  if (void* p = Allocate(size)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if (void* p = AllocateAligned(size, alignment)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+#endif
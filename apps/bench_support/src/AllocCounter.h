@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bench {
+
+/**
+ * Heap allocations made by the calling thread so far; diff two reads around the code under test. Linking
+ * bench_support replaces the allocator entry points of the whole binary (see AllocCounter.cpp for what is
+ * covered on each platform). Frees are not counted.
+ */
+std::uint64_t ThreadAllocations();
+
+} // namespace bench
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+/** Nearest-rank percentile (p in [0,1], rank rounded half up), 0 when empty. Sorts samples in place. */
+inline std::uint64_t Percentile(std::vector<std::uint64_t>& samples, double p) {
+  if (samples.empty()) return 0;
+  std::sort(samples.begin(), samples.end());
+  const auto idx = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+  return samples[std::min(idx, samples.size() - 1)];
+}
+
+} // namespace bench
@@ -6,7 +6,6 @@
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QLabel>
-#include <QMetaObject>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
@@ -20,16 +19,21 @@
 #include "common/config/ConfigPoco.h"
 #include "ControllerRuntimeDds.h"
 #include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/sensor/SensorPipeline.h"
 #include "common/status/Models.h"
 #include "common/status/StatusSnapshot.h"
 #include "DemoController.h"
 #include "MainWindow.h"
+#include "ui/DecimatedSeries.h"
+#include "ui/LogPanel.h"
+#include "ui/TelemetryChart.h"
 
 #include <Poco/Path.h>
-#include <chrono>
+#include <algorithm>
+#include <memory>
 #include <string>
-#include <thread>
+#include <vector>
 
 static void AddRow(QGridLayout* grid, int row, const QString& name, QLabel*& valueOut, QWidget* parent) {
   auto* nameLbl = new QLabel(name, parent);
@@ -39,35 +43,16 @@ static void AddRow(QGridLayout* grid, int row, const QString& name, QLabel*& val
   valueOut = valLbl;
 }
 
-ControllerApp::ControllerApp() {
-  setUnixOptions(true);  // Parse --verify-startup (Windows default uses /option)
-}
+ControllerApp::ControllerApp() : ControllerAppBase("controller_app") {}
 
-void ControllerApp::initialize(Poco::Util::Application& self) {
+void ControllerApp::configure() {
   loadConfiguration();
   addSubsystem(new QtSubsystem);
-  Application::initialize(self);
-  common::log::InitFromConfig(common::config::WrapPocoConfig(config()), "controller_app");
-}
-
-void ControllerApp::defineOptions(Poco::Util::OptionSet& options) {
-  Application::defineOptions(options);
-  options.addOption(Poco::Util::Option("verify-startup", "v", "Verify startup handshake and exit")
-                        .required(false)
-                        .repeatable(false)
-                        .callback(Poco::Util::OptionCallback<ControllerApp>(this, &ControllerApp::handleOption)));
-}
-
-void ControllerApp::handleOption(const std::string& name, const std::string& value) {
-  if (name == "verify-startup") {
-    _verifyStartup = true;
-    return;
-  }
-  Application::handleOption(name, value);
 }
 
 int ControllerApp::main(const std::vector<std::string>& args) {
   common::log::SetThreadName("ui");
+  common::rt::ConfigureCurrentThread("ui");
   common::log::Info("main", "controller_app starting");
 
   auto& qtSys = getSubsystem<QtSubsystem>();
@@ -83,41 +68,31 @@ int ControllerApp::main(const std::vector<std::string>& args) {
   appDirPath = appPath.parent().absolute().toString();
 
   auto cfg = common::config::WrapPocoConfig(config());
-  const int sensorRateHz = config().getInt("sensor.rate_hz", 200);
   const int uiRefreshHz = config().getInt("ui.refresh_hz", 30);
+  // Same lower bound as TelemetryChart::setWindow, so both charts and the raster plot show the same span.
+  const int chartWindowSetting = config().getInt("ui.chart_window", 300);
+  const int chartWindow = std::max(ui::TelemetryChart::kMinWindow, chartWindowSetting);
+  if (chartWindow != chartWindowSetting) {
+    common::log::Warn("main", "ui.chart_window=" + std::to_string(chartWindowSetting) + " raised to " +
+                                  std::to_string(chartWindow));
+  }
+  const int chartHistory = std::max(chartWindow, config().getInt("ui.chart_history", 262144));
+  const auto chartDecimation =
+      config().getString("ui.chart_decimation", "minmax") == "lttb" ? ui::Decimation::Lttb : ui::Decimation::MinMax;
 
-  common::sensor::SensorPipeline sensor(common::sensor::SensorPipeline::Params{sensorRateHz});
+  common::sensor::SensorPipeline sensor(common::sensor::LoadSensorParams(cfg));
   sensor.start();
 
   common::status::StatusStore statusStore;
   controller_app::ControllerRuntimeDds runtime(cfg, sensor, statusStore, appDirPath);
   runtime.start();
+  logStartup("runtime_ms");
 
-  if (_verifyStartup) {
-    const int timeoutMs = config().getInt("ipc.ready_timeout_ms", 10000) + 5000;
-    const int pollMs = 200;
-    int elapsed = 0;
-    while (elapsed < timeoutMs) {
-      const auto st = statusStore.read();
-      if (st.algoHealth == common::status::AlgoHealthState::Healthy) {
-        runtime.stop();
-        sensor.stop();
-        common::log::Info("main", "verify-startup: handshake OK");
-        return Application::EXIT_OK;
-      }
-      if (st.systemState == common::status::SystemState::Degraded && st.lastError != common::status::ErrorCode::Ok) {
-        runtime.stop();
-        sensor.stop();
-        common::log::Error("main", "verify-startup: handshake failed");
-        return Application::EXIT_UNAVAILABLE;
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
-      elapsed += pollMs;
-    }
+  if (verifyStartup()) {
+    const int rc = controller_app::VerifyStartup(statusStore, config());
     runtime.stop();
     sensor.stop();
-    common::log::Error("main", "verify-startup: timeout waiting for healthy");
-    return Application::EXIT_UNAVAILABLE;
+    return rc;
   }
 
   QWidget window;
@@ -126,15 +101,30 @@ int ControllerApp::main(const std::vector<std::string>& args) {
   auto* root = new QVBoxLayout(&window);
 
   auto* demoView = new MainWindow(&window);
+  demoView->setFrameRate(uiRefreshHz);
+  if (config().getString("ui.chart_renderer", "charts") == "raster") {
+    demoView->useRasterTelemetry(chartWindow);
+  } else {
+    demoView->telemetryChart()->setHistory(chartHistory);
+    demoView->telemetryChart()->setWindow(chartWindow);
+    demoView->telemetryChart()->setDecimation(chartDecimation);
+  }
+  demoView->logPanel()->setView(config().getString("ui.log_view", "text") == "list" ? ui::LogPanel::View::List
+                                                                                    : ui::LogPanel::View::Text);
+  demoView->logPanel()->setMaxLines(config().getInt("ui.log_max_lines", 5000));
   root->addWidget(demoView);
   DemoController demoController(demoView);
-  const int simIntervalMs = 50;
-  demoController.startSimulationTimer(simIntervalMs);
-
-  common::log::SetSink([demoView](common::log::Level level, const std::string& module, const std::string& message) {
-    QString line = QString::fromStdString("[" + common::log::LevelToString(level) + "][" + module + "] " + message);
-    QMetaObject::invokeMethod(demoView, "appendLog", Qt::QueuedConnection, Q_ARG(QString, line));
-  });
+  // The simulator steps on its own thread at device.sim_rate_hz; the UI timer below samples it once per frame.
+  demoController.startSimulation(
+      common::rt::PeriodicTimer::WithRate(common::rt::LoadTimerParams(cfg, "device", common::rt::OverrunPolicy::Skip),
+                                          std::max(1, config().getInt("device.sim_rate_hz", 100))));
+
+  // Log lines are buffered and drained by the UI timer; the log panel shows each batch with one edit per frame.
+  auto logBuffer = std::make_shared<common::log::BufferedSink>();
+  const auto logSinkId =
+      common::log::AddSink(logBuffer->sink(), common::log::LevelFromString(config().getString("ui.log_level", "information")));
+  std::vector<common::log::LogLine> logLines;
+  auto& logDropped = statusStore.registry().counter("log.ui_dropped");
 
   auto* grpSignals = new QGroupBox("Signals", &window);
   auto* grpHealth = new QGroupBox("Process/Health", &window);
@@ -151,40 +141,58 @@ int ControllerApp::main(const std::vector<std::string>& args) {
   AddRow(gridSignals, 3, "Value B:", valB, grpSignals);
   AddRow(gridSignals, 4, "Value C:", valC, grpSignals);
   AddRow(gridSignals, 5, "Missed deadlines:", valMiss, grpSignals);
+  QLabel* valFilter;
+  AddRow(gridSignals, 6, "Filter cost avg/max (us):", valFilter, grpSignals);
+  QLabel* valJitter;
+  AddRow(gridSignals, 7, "Wake jitter avg/max (us), overruns:", valJitter, grpSignals);
 
   QLabel *valState, *valAlgo, *valRtt, *valRestarts;
   AddRow(gridHealth, 0, "System state:", valState, grpHealth);
   AddRow(gridHealth, 1, "Algo health:", valAlgo, grpHealth);
   AddRow(gridHealth, 2, "Heartbeat RTT (ms):", valRtt, grpHealth);
   AddRow(gridHealth, 3, "Algo restarts:", valRestarts, grpHealth);
+  QLabel* valLogDropped;
+  AddRow(gridHealth, 4, "UI log lines dropped:", valLogDropped, grpHealth);
 
   QLabel *valCmd, *valPos, *valVel, *valAlgoLat;
   AddRow(gridControl, 0, "Last command:", valCmd, grpControl);
   AddRow(gridControl, 1, "Actuator position:", valPos, grpControl);
   AddRow(gridControl, 2, "Actuator velocity:", valVel, grpControl);
   AddRow(gridControl, 3, "Algo latency (ms):", valAlgoLat, grpControl);
+  QLabel* valE2e;
+  AddRow(gridControl, 4, "Sensor to actuator p50/p99 (ms):", valE2e, grpControl);
+  QLabel* valTelemetryDropped;
+  AddRow(gridControl, 5, "Telemetry samples dropped:", valTelemetryDropped, grpControl);
 
   auto* seriesCmd = new QLineSeries(&window);
   seriesCmd->setName("cmd");
+  auto* seriesSensor = new QLineSeries(&window);
+  seriesSensor->setName("sensor");
+  auto* seriesPos = new QLineSeries(&window);
+  seriesPos->setName("position");
 
   auto* chart = new QChart();
   chart->addSeries(seriesCmd);
-  chart->legend()->hide();
-  chart->setTitle("Control Command Trend");
+  chart->addSeries(seriesSensor);
+  chart->addSeries(seriesPos);
+  chart->legend()->setAlignment(Qt::AlignTop);
+  chart->setTitle("Control Trend (every control step)");
 
   auto* axisX = new QValueAxis();
   axisX->setLabelFormat("%d");
   axisX->setTitleText("samples");
-  axisX->setRange(0, 299);
+  axisX->setRange(0, chartWindow - 1);
 
   auto* axisY = new QValueAxis();
-  axisY->setTitleText("cmd");
+  axisY->setTitleText("value");
   axisY->setRange(-2.0, 2.0);
 
   chart->addAxis(axisX, Qt::AlignBottom);
   chart->addAxis(axisY, Qt::AlignLeft);
-  seriesCmd->attachAxis(axisX);
-  seriesCmd->attachAxis(axisY);
+  for (auto* s : {seriesCmd, seriesSensor, seriesPos}) {
+    s->attachAxis(axisX);
+    s->attachAxis(axisY);
+  }
 
   auto* chartView = new QChartView(chart, &window);
   chartView->setRenderHint(QPainter::Antialiasing);
@@ -195,11 +203,24 @@ int ControllerApp::main(const std::vector<std::string>& args) {
   root->addWidget(grpControl);
   root->addWidget(chartView);
 
-  static constexpr int kWindow = 300;
-  int sampleIndex = 0;
+  // Every control step arrives through the runtime's telemetry ring, drained once per frame; x is the step index.
+  // The pyramids keep chart_history steps and render ~2 points per pixel.
+  ui::DecimatedSeries cmdTrend(seriesCmd, static_cast<std::size_t>(chartHistory));
+  ui::DecimatedSeries sensorTrend(seriesSensor, static_cast<std::size_t>(chartHistory));
+  ui::DecimatedSeries posTrend(seriesPos, static_cast<std::size_t>(chartHistory));
+  std::vector<common::control::TelemetrySample> telemetry;
+  bool healthySeen = false;
 
   QTimer timer;
   QObject::connect(&timer, &QTimer::timeout, [&]() {
+    demoController.onFrame();
+
+    logLines.clear();
+    logBuffer->drain(logLines);
+    for (const auto& l : logLines) {
+      demoView->appendLog(QString::fromStdString(l.text));
+    }
+
     const auto snap = sensor.latest();
 
     valRate->setText(QString::number(snap.effectiveRateHz, 'f', 1));
@@ -208,43 +229,77 @@ int ControllerApp::main(const std::vector<std::string>& args) {
     valB->setText(QString::number(snap.latest.valueB, 'f', 4));
     valC->setText(QString::number(snap.latest.valueC, 'f', 4));
     valMiss->setText(QString::number(static_cast<qulonglong>(snap.missedDeadlines)));
+    valFilter->setText(QString::number(snap.filterCostNs / 1000.0, 'f', 2) + " / " +
+                       QString::number(static_cast<double>(snap.filterCostMaxNs) / 1000.0, 'f', 2));
+    const auto timing = sensor.timing();
+    valJitter->setText(QString::number(timing.jitter.meanNs() / 1000.0, 'f', 1) + " / " +
+                       QString::number(static_cast<double>(timing.jitter.maxNs) / 1000.0, 'f', 1) + ", " +
+                       QString::number(static_cast<qulonglong>(timing.overruns)));
 
     const auto st = statusStore.read();
+    if (!healthySeen && st.algoHealth == common::status::AlgoHealthState::Healthy) {
+      healthySeen = true;
+      logStartup("healthy_ms");
+    }
     valState->setText(QString::fromLatin1(common::status::ToString(st.systemState)));
     valAlgo->setText(QString::fromLatin1(common::status::ToString(st.algoHealth)));
     valRtt->setText(QString::number(st.heartbeatRttMs, 'f', 2));
     valRestarts->setText(QString::number(static_cast<qulonglong>(st.algoRestarts)));
+    logDropped.set(logBuffer->dropped());
+    valLogDropped->setText(QString::number(static_cast<qulonglong>(logDropped.load())));
 
     valCmd->setText(QString::number(st.lastCommand, 'f', 4));
     valPos->setText(QString::number(st.actuatorPosition, 'f', 4));
     valVel->setText(QString::number(st.actuatorVelocity, 'f', 4));
     valAlgoLat->setText(QString::number(st.algoLatencyMs, 'f', 2));
-
-    if (seriesCmd->count() >= kWindow) {
-      seriesCmd->removePoints(0, seriesCmd->count() - (kWindow - 1));
-    }
-    seriesCmd->append(sampleIndex++, st.lastCommand);
-
-    const int minX = std::max(0, sampleIndex - kWindow);
-    axisX->setRange(minX, minX + (kWindow - 1));
-
-    const double y = st.lastCommand;
-    if (y < axisY->min() || y > axisY->max()) {
-      const double pad = 0.2;
-      axisY->setRange(y - 1.0 - pad, y + 1.0 + pad);
+    const auto e2e = runtime.endToEndLatency();
+    valE2e->setText(QString::number(static_cast<double>(e2e.percentileNs(0.5)) / 1e6, 'f', 2) + " / " +
+                    QString::number(static_cast<double>(e2e.percentileNs(0.99)) / 1e6, 'f', 2));
+
+    valTelemetryDropped->setText(QString::number(static_cast<qulonglong>(runtime.telemetryDropped())));
+
+    telemetry.clear();
+    if (runtime.drainTelemetry(telemetry) > 0) {
+      for (const auto& t : telemetry) {
+        cmdTrend.append(t.command);
+        sensorTrend.append(t.sensor);
+        posTrend.append(t.position);
+      }
+      const std::uint64_t count = cmdTrend.count();
+      const std::uint64_t minX = count > static_cast<std::uint64_t>(chartWindow) ? count - chartWindow : 0;
+      const int pixels = static_cast<int>(chart->plotArea().width());
+      double lo = axisY->min();
+      double hi = axisY->max();
+      bool grow = false;
+      for (auto* trend : {&cmdTrend, &sensorTrend, &posTrend}) {
+        trend->render(minX, pixels, chartDecimation);
+        double tLo = 0.0;
+        double tHi = 0.0;
+        if (trend->yRange(tLo, tHi) && (tLo < lo || tHi > hi)) {
+          lo = std::min(lo, tLo);
+          hi = std::max(hi, tHi);
+          grow = true;
+        }
+      }
+      axisX->setRange(static_cast<double>(minX), static_cast<double>(minX + (chartWindow - 1)));
+      if (grow) {
+        const double pad = 0.2;
+        axisY->setRange(lo - pad, hi + pad);
+      }
     }
   });
 
-  const int intervalMs = (uiRefreshHz > 0) ? (1000 / uiRefreshHz) : 33;
-  timer.start(intervalMs);
+  // One frame rate for the whole window: the same interval the charts and log panel flush at.
+  timer.start(demoView->frameInterval());
 
   window.resize(760, 900);
   window.show();
 
   const int rc = qtApp->exec();
 
-  demoController.stopSimulationTimer();
+  demoController.stopSimulation();
   timer.stop();
+  common::log::RemoveSink(logSinkId);
   runtime.stop();
   sensor.stop();
 
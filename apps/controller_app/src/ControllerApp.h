@@ -1,20 +1,16 @@
 #pragma once
 
+#include "ControllerAppBase.h"
+
 #include <Poco/Util/Application.h>
-#include <Poco/Util/OptionSet.h>
 
 class QtSubsystem;
 
-class ControllerApp : public Poco::Util::Application {
+class ControllerApp : public controller_app::ControllerAppBase<Poco::Util::Application> {
 public:
   ControllerApp();
 
 protected:
-  void initialize(Poco::Util::Application& self) override;
-  void defineOptions(Poco::Util::OptionSet& options) override;
-  void handleOption(const std::string& name, const std::string& value) override;
+  void configure() override;
   int main(const std::vector<std::string>& args) override;
-
-private:
-  bool _verifyStartup{false};
 };
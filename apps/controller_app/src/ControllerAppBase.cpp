@@ -0,0 +1,58 @@
+#include "ControllerAppBase.h"
+
+#include "common/config/ConfigPoco.h"
+#include "common/log/BinaryLog.h"
+#include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
+#include "common/status/ProcessStats.h"
+#include "common/status/StatusSnapshot.h"
+#include "common/trace/Spans.h"
+
+#include <chrono>
+#include <thread>
+
+namespace controller_app {
+
+void StartProcessServices(Poco::Util::AbstractConfiguration& config, const std::string& processName) {
+  const auto cfg = common::config::WrapPocoConfig(config);
+  common::log::InitFromConfig(cfg, processName);
+  common::rt::InitFromConfig(cfg);
+
+  // The controller starts first and launches algo_worker, so it owns a fresh trace file; the worker appends.
+  auto spans = common::trace::LoadSpanParams(cfg);
+  spans.truncate = true;
+  common::trace::StartSpans(spans, processName);
+  common::log::binary::StartBinaryLog(common::log::binary::LoadBinaryLogParams(cfg), processName);
+}
+
+void StopProcessServices() {
+  common::trace::StopSpans();
+  common::log::binary::StopBinaryLog();
+  common::log::StopAsync();
+}
+
+int VerifyStartup(const common::status::StatusStore& status, Poco::Util::AbstractConfiguration& config) {
+  const int timeoutMs = config.getInt("ipc.ready_timeout_ms", 10000) + 5000;
+  const int pollMs = 200;
+  for (int elapsed = 0; elapsed < timeoutMs; elapsed += pollMs) {
+    const auto st = status.read();
+    if (st.algoHealth == common::status::AlgoHealthState::Healthy) {
+      common::log::Info("main", "verify-startup: handshake OK");
+      return Poco::Util::Application::EXIT_OK;
+    }
+    if (st.systemState == common::status::SystemState::Degraded && st.lastError != common::status::ErrorCode::Ok) {
+      common::log::Error("main", "verify-startup: handshake failed");
+      return Poco::Util::Application::EXIT_UNAVAILABLE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+  }
+  common::log::Error("main", "verify-startup: timeout waiting for healthy");
+  return Poco::Util::Application::EXIT_UNAVAILABLE;
+}
+
+void LogStartup(const std::string& what, std::uint64_t startNs) {
+  common::log::Info("main", "startup: " + what + "=" + std::to_string((common::time::NowMonotonicNs() - startNs) / 1000000) +
+                                " " + common::status::DescribeMemory());
+}
+
+} // namespace controller_app
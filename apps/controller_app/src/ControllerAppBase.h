@@ -0,0 +1,87 @@
+#pragma once
+
+#include "common/time/MonotonicClock.h"
+
+#include <Poco/Util/AbstractConfiguration.h>
+#include <Poco/Util/Application.h>
+#include <Poco/Util/OptionCallback.h>
+#include <Poco/Util/OptionSet.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace common::status {
+class StatusStore;
+}
+
+namespace controller_app {
+
+/** Logging, thread policy, span trace (a fresh file; algo_worker appends) and binary log, named processName. */
+void StartProcessServices(Poco::Util::AbstractConfiguration& config, const std::string& processName);
+/** Stops what StartProcessServices started. */
+void StopProcessServices();
+
+/**
+ * --verify-startup: polls the status store until algo_worker is healthy (EXIT_OK), the runtime reports a failed
+ * handshake, or ipc.ready_timeout_ms + 5 s pass (EXIT_UNAVAILABLE). Logs the outcome.
+ */
+int VerifyStartup(const common::status::StatusStore& status, Poco::Util::AbstractConfiguration& config);
+
+/** "startup: <what>=<ms since startNs> rss_mb=... peak_rss_mb=...", compared between the two front ends. */
+void LogStartup(const std::string& what, std::uint64_t startNs);
+
+/**
+ * Bootstrap shared by controller_app (Base = Application) and controller_headless (Base = ServerApplication):
+ * configuration hook, process services, the --verify-startup option and the process start time.
+ */
+template <typename Base>
+class ControllerAppBase : public Base {
+public:
+  explicit ControllerAppBase(std::string processName)
+      : _processName(std::move(processName)), _startNs(common::time::NowMonotonicNs()) {
+    this->setUnixOptions(true);  // Parse --verify-startup (Windows default uses /option)
+  }
+
+protected:
+  /** Loads configuration files and adds subsystems; runs before Base::initialize(). */
+  virtual void configure() = 0;
+
+  void initialize(Poco::Util::Application& self) override {
+    configure();
+    Base::initialize(self);
+    StartProcessServices(this->config(), _processName);
+  }
+
+  void uninitialize() override {
+    StopProcessServices();
+    Base::uninitialize();
+  }
+
+  void defineOptions(Poco::Util::OptionSet& options) override {
+    Base::defineOptions(options);
+    options.addOption(Poco::Util::Option("verify-startup", "v", "Verify startup handshake and exit")
+                          .required(false)
+                          .repeatable(false)
+                          .callback(Poco::Util::OptionCallback<ControllerAppBase>(this, &ControllerAppBase::handleOption)));
+  }
+
+  void handleOption(const std::string& name, const std::string& value) override {
+    if (name == "verify-startup") {
+      _verifyStartup = true;
+      return;
+    }
+    Base::handleOption(name, value);
+  }
+
+  bool verifyStartup() const { return _verifyStartup; }
+  void logStartup(const std::string& what) const { LogStartup(what, _startNs); }
+
+private:
+  const std::string _processName;
+  /** Process start, for the "startup:" log lines. */
+  const std::uint64_t _startNs;
+  bool _verifyStartup{false};
+};
+
+} // namespace controller_app
@@ -4,9 +4,14 @@
 #include "ControlCommand.hpp"
 
 #include "common/control/ControlModels.h"
+#include "common/log/BinaryLog.h"
 #include "common/log/Log.h"
+#include "common/rt/PeriodicTimer.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/status/Models.h"
 #include "common/time/MonotonicClock.h"
+#include "common/trace/SampleTrace.h"
+#include "common/trace/Spans.h"
 
 #include <Poco/Exception.h>
 #include <Poco/Path.h>
@@ -16,8 +21,11 @@
 #include <fastdds/dds/subscriber/DataReader.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <thread>
+#include <vector>
 
 namespace controller_app {
 
@@ -28,9 +36,15 @@ ControllerRuntimeDds::ControllerRuntimeDds(const common::config::Config& cfg,
     : _sensor(sensor),
       _status(status),
       _algoExePath(Poco::Path(applicationDirPath).append("algo_worker").toString()),
+      _traceEnabled(cfg.getBool("trace.enabled", true)),
+      _traceExportPath(cfg.getString("trace.export_path", "")),
+      _trace(common::trace::TraceAggregator::Params{
+          static_cast<std::uint32_t>(std::max(0, cfg.getInt("trace.export_every", 100))), 256}),
+      _telemetry(static_cast<std::size_t>(std::max(2, cfg.getInt("ui.telemetry_capacity", 4096)))),
       _domainId(cfg.getInt("dds.domain_id", 0)),
       _sensorRateHz(cfg.getInt("sensor.rate_hz", 200)),
-      _algoTimeoutMs(cfg.getInt("ipc.heartbeat_timeout_ms", 500)) {}
+      _algoTimeoutMs(cfg.getInt("ipc.heartbeat_timeout_ms", 500)),
+      _timing(common::rt::LoadTimerParams(cfg, "control", common::rt::OverrunPolicy::Skip)) {}
 
 ControllerRuntimeDds::~ControllerRuntimeDds() {
   stop();
@@ -70,6 +84,9 @@ void ControllerRuntimeDds::start() {
   _pubThread = std::thread([this]() { runPublisher(); });
   _subThread = std::thread([this]() { runSubscriber(); });
   _statusThread = std::thread([this]() { runStatusUpdater(); });
+  if (_traceEnabled && !_traceExportPath.empty()) {
+    _traceThread = std::thread([this]() { runTraceExport(); });
+  }
 }
 
 void ControllerRuntimeDds::stop() {
@@ -77,40 +94,72 @@ void ControllerRuntimeDds::stop() {
   if (_pubThread.joinable()) _pubThread.join();
   if (_subThread.joinable()) _subThread.join();
   if (_statusThread.joinable()) _statusThread.join();
+  if (_traceThread.joinable()) _traceThread.join();
   if (_node) _node->shutdown();
 }
 
 void ControllerRuntimeDds::runPublisher() {
   common::log::SetThreadName("dds_pub");
-  const auto period = std::chrono::microseconds(2000);  // 2ms
+  common::rt::ConfigureCurrentThread("dds_pub");
+  auto timing = _timing;
+  timing.period = std::chrono::microseconds(2000);  // 2ms
+  common::rt::PeriodicTimer timer(timing);
   auto* writer = static_cast<eprosima::fastdds::dds::DataWriter*>(_jsWriter);
+  const auto& notifier = _sensor.notifier();
+  std::uint64_t lastTracedSeq = 0;
 
+  timer.start();
   while (_running.load()) {
-    const auto t0 = std::chrono::steady_clock::now();
-    const auto snap = _sensor.latest();
-
+    MRCD_TRACE_SPAN_VAR(span, "dds_pub.publish");
     JointState js;
-    js.position()[0] = snap.latest.valueA;
-    js.position()[1] = snap.latest.valueB;
-    js.position()[2] = snap.latest.valueC;
-    js.position()[3] = 0;
-    js.position()[4] = 0;
-    js.position()[5] = 0;
+    common::sensor::SensorFrameView frame;
+    std::uint64_t pickupNs = 0;
+    bool consistent = false;
+    // Copy, then validate; if the slot was reused while copying, re-read once (the writer has moved to a fresh slot).
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      frame = _sensor.latestFrame();
+      pickupNs = common::time::NowMonotonicNs();
+      const std::size_t n = std::min<std::size_t>(frame.channels, js.position().size());
+      for (std::size_t i = 0; i < js.position().size(); ++i) {
+        js.position()[i] = i < n ? frame.values[i] : 0.0;
+      }
+      consistent = frame.empty() || frame.valid();
+      if (consistent) break;
+    }
+    if (!consistent) {
+      timer.wait();  // Still torn: skip this cycle without breaking the pacing.
+      continue;
+    }
     js.velocity()[0] = js.velocity()[1] = js.velocity()[2] = 0;
     js.velocity()[3] = js.velocity()[4] = js.velocity()[5] = 0;
     js.timestamp(common::time::NowMonotonicNs());
+    js.sensor_seq(frame.seq);
+
+    // Trace each sample once; the 2 ms republishes of the same frame go out untraced.
+    if (_traceEnabled && !frame.empty() && frame.seq != lastTracedSeq) {
+      lastTracedSeq = frame.seq;
+      MRCD_TRACE_SET_SEQ(span, frame.seq);
+      common::trace::SampleTrace t;
+      t.sensorSeq = frame.seq;
+      t.stamp(common::trace::Stage::SensorSample, frame.monotonicNs);
+      const auto publishNs = notifier.lastPublishNs();
+      if (notifier.current() == frame.seq) t.stamp(common::trace::Stage::SensorPublish, publishNs);
+      t.stamp(common::trace::Stage::ControlPickup, pickupNs);
+      t.stamp(common::trace::Stage::IpcSend);
+      js.trace_ns() = t.ns;
+    }
 
     writer->write(&js);
+    MRCD_TRACE_SPAN_END(span);
 
-    const auto elapsed = std::chrono::steady_clock::now() - t0;
-    if (elapsed < period) {
-      std::this_thread::sleep_for(period - elapsed);
-    }
+    timer.wait();
   }
+  common::log::Info("controller_dds", "dds_pub timing: " + common::rt::Describe(timer.stats()));
 }
 
 void ControllerRuntimeDds::runSubscriber() {
   common::log::SetThreadName("dds_sub");
+  common::rt::ConfigureCurrentThread("dds_sub");
   auto* reader = static_cast<eprosima::fastdds::dds::DataReader*>(_ccReader);
   ::ControlCommand cmd;  // DDS type
   eprosima::fastdds::dds::SampleInfo info;
@@ -119,12 +168,24 @@ void ControllerRuntimeDds::runSubscriber() {
   while (_running.load()) {
     if (reader->wait_for_unread_message(timeout)) {
       while (eprosima::fastdds::dds::RETCODE_OK == reader->take_next_sample(&cmd, &info)) {
+        const auto receivedNs = common::time::NowMonotonicNs();
         if (info.valid_data) {
+          MRCD_TRACE_SPAN_SEQ("dds_sub.take", cmd.sensor_seq());
           double sum = 0;
           for (int i = 0; i < 6; ++i) sum += cmd.target_position()[i];
           _lastCmdValue.store(sum / 6.0);
           _lastCmdTimestamp.store(cmd.timestamp());
+          _lastCmdSensorSeq.store(cmd.sensor_seq());
           _hasAlgo.store(true);
+          MRCD_BLOG("dds_sub", "command seq={} value={}", cmd.sensor_seq(), sum / 6.0);
+          // Published after the command value, so a reader that sees this trace applies at least this command.
+          if (cmd.trace_ns()[common::trace::Index(common::trace::Stage::ControlPickup)] != 0) {
+            auto& t = _cmdTrace.back();
+            t.sensorSeq = cmd.sensor_seq();
+            t.ns = cmd.trace_ns();
+            t.stamp(common::trace::Stage::ResultReceive, receivedNs);
+            _cmdTrace.publishSwap();
+          }
         }
       }
     }
@@ -133,35 +194,80 @@ void ControllerRuntimeDds::runSubscriber() {
 
 void ControllerRuntimeDds::runStatusUpdater() {
   common::log::SetThreadName("dds_status");
+  common::rt::ConfigureCurrentThread("dds_status");
   const double dt = 1.0 / std::max(1, _sensorRateHz);
   uint64_t lastSeq = 0;
+  uint64_t lastTracedSeq = 0;
+  common::rt::PeriodicTimer timer(common::rt::PeriodicTimer::WithRate(_timing, _sensorRateHz));
+  auto& metrics = _status.control();
+  auto& sensorMetrics = _status.sensor();
+  metrics.loopHz.set(static_cast<double>(_sensorRateHz));
+  _status.setSystemState(common::status::SystemState::Running);
 
+  timer.start();
   while (_running.load()) {
-    const auto t0 = std::chrono::steady_clock::now();
     const auto snap = _sensor.latest();
     if (snap.latest.seq != lastSeq) {
       lastSeq = snap.latest.seq;
+      MRCD_TRACE_SPAN_VAR(span, "actuator.apply");
+      const auto trace = _traceEnabled ? _cmdTrace.readSnapshot() : common::trace::SampleTrace{};
       common::control::ControlCommand internalCmd;
-      internalCmd.basedOnSensorSeq = snap.latest.seq;
+      internalCmd.basedOnSensorSeq = _lastCmdSensorSeq.load();
       internalCmd.cmdValue = _lastCmdValue.load();
       _actuator.apply(internalCmd, dt);
+      // Never blocks: with the UI stalled the ring fills and the step is counted as dropped.
+      _telemetry.tryPush(common::control::TelemetrySample{snap.latest.seq, snap.latest.valueA, internalCmd.cmdValue,
+                                                          _actuator.state().position});
+
+      if (trace.sensorSeq > lastTracedSeq) {
+        lastTracedSeq = trace.sensorSeq;
+        MRCD_TRACE_SET_SEQ(span, trace.sensorSeq);
+        auto t = trace;
+        t.stamp(common::trace::Stage::ActuatorApply);
+        _trace.record(t);
+        const auto computeNs = t.at(common::trace::Stage::ComputeEnd) - t.at(common::trace::Stage::ComputeStart);
+        metrics.algoLatencyMs.set(common::time::NsToMs(computeNs));
+        MRCD_BLOG("dds_status", "apply seq={} sample_to_apply_ns={} compute_ns={}", t.sensorSeq,
+                  t.at(common::trace::Stage::ActuatorApply) - t.at(common::trace::Stage::SensorSample), computeNs);
+      }
     }
 
-    auto st = _status.read();
-    st.systemState = common::status::SystemState::Running;
-    st.algoHealth = _hasAlgo.load() ? common::status::AlgoHealthState::Healthy
-                                    : common::status::AlgoHealthState::Disconnected;
-    st.lastCommand = _lastCmdValue.load();
+    _status.setAlgoHealth(_hasAlgo.load() ? common::status::AlgoHealthState::Healthy
+                                          : common::status::AlgoHealthState::Disconnected);
+    metrics.lastCommand.set(_lastCmdValue.load());
     const auto act = _actuator.state();
-    st.actuatorPosition = act.position;
-    st.actuatorVelocity = act.velocity;
-    _status.update(st);
-
-    const auto elapsed = std::chrono::steady_clock::now() - t0;
-    const auto period = std::chrono::duration<double>(dt);
-    if (elapsed < period) {
-      std::this_thread::sleep_for(period - elapsed);
-    }
+    metrics.actuatorPosition.set(act.position);
+    metrics.actuatorVelocity.set(act.velocity);
+    sensorMetrics.rateHz.set(snap.effectiveRateHz);
+    sensorMetrics.seq.set(snap.latest.seq);
+    sensorMetrics.missedDeadlines.set(snap.missedDeadlines);
+
+    timer.wait();
+  }
+  common::log::Info("controller_dds", "dds_status timing: " + common::rt::Describe(timer.stats()));
+  if (_traceEnabled) common::log::Info("controller_dds", "sample trace: " + _trace.describe());
+}
+
+void ControllerRuntimeDds::runTraceExport() {
+  common::log::SetThreadName("trace_export");
+  common::rt::ConfigureCurrentThread("trace_export");
+
+  std::ofstream out(_traceExportPath, std::ios::app);
+  if (!out) {
+    common::log::Warn("controller_dds", "cannot open trace export file: " + _traceExportPath);
+    return;
+  }
+  if (out.tellp() == 0) out << common::trace::CsvHeader() << '\n';
+
+  std::vector<common::trace::SampleTrace> batch;
+  bool last = false;
+  while (!last) {
+    last = !_running.load();  // One final drain after stop().
+    batch.clear();
+    _trace.drainSamples(batch);
+    for (const auto& t : batch) out << common::trace::ToCsvRow(t) << '\n';
+    out.flush();
+    if (!last) std::this_thread::sleep_for(std::chrono::milliseconds(500));
   }
 }
 
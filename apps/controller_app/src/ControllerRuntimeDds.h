@@ -2,14 +2,22 @@
 
 #include "common/config/Config.h"
 #include "common/control/ActuatorSimulator.h"
+#include "common/control/ControlModels.h"
+#include "common/rt/LatencyHistogram.h"
+#include "common/rt/PeriodicTimer.h"
+#include "common/rt/SeqlockChannel.h"
+#include "common/rt/SpscRing.h"
 #include "common/sensor/SensorPipeline.h"
 #include "common/status/StatusSnapshot.h"
+#include "common/trace/SampleTrace.h"
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 struct JointState;
 struct ControlCommand;
@@ -31,10 +39,21 @@ class ControllerRuntimeDds {
   void start();
   void stop();
 
+  /** Sensor sample to actuator apply, per traced sample ([trace] enabled). */
+  common::rt::LatencySnapshot endToEndLatency() const { return _trace.endToEnd(); }
+
+  /**
+   * Every control step since the last call, oldest first (one consumer thread only, the UI).
+   * While nobody drains, the ring fills up and later steps are counted in telemetryDropped().
+   */
+  std::size_t drainTelemetry(std::vector<common::control::TelemetrySample>& out) { return _telemetry.drain(out); }
+  std::uint64_t telemetryDropped() const { return _telemetry.dropped(); }
+
 private:
   void runPublisher();
   void runSubscriber();
   void runStatusUpdater();
+  void runTraceExport();
 
   const common::sensor::SensorPipeline& _sensor;
   common::status::StatusStore& _status;
@@ -47,16 +66,27 @@ class ControllerRuntimeDds {
   common::control::ActuatorSimulator _actuator;
   std::atomic<double> _lastCmdValue{0.0};
   std::atomic<uint64_t> _lastCmdTimestamp{0};
+  std::atomic<std::uint64_t> _lastCmdSensorSeq{0};
   std::atomic<bool> _hasAlgo{false};
 
+  bool _traceEnabled{true};
+  std::string _traceExportPath;
+  /** Trace of the newest traced command (dds_sub -> dds_status). */
+  common::rt::SeqlockChannel<common::trace::SampleTrace> _cmdTrace;
+  common::trace::TraceAggregator _trace;
+  /** Control step feed (dds_status -> UI), see drainTelemetry(). */
+  common::rt::SpscRing<common::control::TelemetrySample> _telemetry;
+
   std::atomic<bool> _running{false};
   std::thread _pubThread;
   std::thread _subThread;
   std::thread _statusThread;
+  std::thread _traceThread;
 
   int _domainId{0};
   int _sensorRateHz{200};
   std::chrono::milliseconds _algoTimeoutMs{500};
+  common::rt::PeriodicTimer::Params _timing;
 };
 
 }  // namespace controller_app
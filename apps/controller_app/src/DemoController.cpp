@@ -2,13 +2,9 @@
 #include "DeviceSimulator.h"
 #include "MainWindow.h"
 
-#include <QTimer>
-#include <QDateTime>
-
 DemoController::DemoController(MainWindow* view, QObject* parent) : QObject(parent), _view(view) {
   _device = new DeviceSimulator(this);
 
-  connect(_device, &DeviceSimulator::stateUpdated, this, &DemoController::onStateUpdated, Qt::DirectConnection);
   connect(_device, &DeviceSimulator::started, this, &DemoController::onDeviceStarted);
   connect(_device, &DeviceSimulator::stopped, this, &DemoController::onDeviceStopped);
 
@@ -21,35 +17,29 @@ DemoController::DemoController(MainWindow* view, QObject* parent) : QObject(pare
 }
 
 DemoController::~DemoController() {
-  stopSimulationTimer();
-}
-
-void DemoController::startSimulationTimer(int intervalMs) {
-  if (_simTimer) return;
-  _simTimer = new QTimer(this);
-  connect(_simTimer, &QTimer::timeout, this, &DemoController::onSimulationTimeout);
-  _lastStepTimeMs = QDateTime::currentMSecsSinceEpoch();
-  _simTimer->start(intervalMs);
+  stopSimulation();
 }
 
-void DemoController::stopSimulationTimer() {
-  if (_simTimer) {
-    _simTimer->stop();
-    _simTimer->deleteLater();
-    _simTimer = nullptr;
-  }
+void DemoController::startSimulation(const common::rt::PeriodicTimer::Params& simTiming) {
+  if (_simulating) return;
+  _simulating = true;
+  _device->startStepping(simTiming);
 }
 
-void DemoController::onSimulationTimeout() {
-  const qint64 now = QDateTime::currentMSecsSinceEpoch();
-  const double dt = (_lastStepTimeMs > 0) ? ((now - _lastStepTimeMs) / 1000.0) : 0.02;
-  _lastStepTimeMs = now;
-  if (dt > 0 && dt < 1.0)
-    _device->step(dt);
+void DemoController::stopSimulation() {
+  _simulating = false;
+  _device->stopStepping();
 }
 
-void DemoController::onStateUpdated(double position, double velocity, double sensorValue) {
-  _view->updateState(position, velocity, sensorValue);
+void DemoController::onFrame() {
+  // 每帧取一次快照；两帧之间仿真走了多少步都只显示最新状态。
+  if (!_simulating) return;
+  const std::uint64_t step = _device->stepCount();
+  if (step == _lastStep) return;
+  _lastStep = step;
+  const auto snap = _device->latestSnapshot();
+  if (!snap.running || !_device->isRunning()) return;
+  _view->updateState(snap.position, snap.velocity, snap.sensorValue);
 }
 
 void DemoController::onStartClicked() {
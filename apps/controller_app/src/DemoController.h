@@ -1,15 +1,18 @@
 #pragma once
 
+#include "common/rt/PeriodicTimer.h"
+
 #include <QObject>
 
+#include <cstdint>
+
 class DeviceSimulator;
 class MainWindow;
-class QTimer;
 
 /**
- * Controller：创建 Model 与 View，用 QTimer 驱动 step()，
- * 连接 Model 的 signal 到 View 的 slot；连接 View 的按钮/滑块信号到 Model。
- * 不向 View 暴露 Model 指针。
+ * Controller：创建 Model 与 View，Model 在自己的仿真线程上固定频率步进；
+ * 宿主的 UI 帧定时器（渲染频率）每帧调用 onFrame()，从 Model 的无锁快照取一次最新状态交给 View，两个频率分别配置。
+ * 连接 View 的按钮/滑块信号到 Model。不向 View 暴露 Model 指针。
  */
 class DemoController : public QObject {
   Q_OBJECT
@@ -17,15 +20,17 @@ class DemoController : public QObject {
   explicit DemoController(MainWindow* view, QObject* parent = nullptr);
   ~DemoController();
 
-  /** 启动周期定时器（用于设备模拟步进）。调用前 View 与 Model 已创建并连接。 */
-  void startSimulationTimer(int intervalMs);
-  void stopSimulationTimer();
+  /** 启动仿真线程（周期取自 simTiming.period）。 */
+  void startSimulation(const common::rt::PeriodicTimer::Params& simTiming);
+  void stopSimulation();
 
   DeviceSimulator* deviceSimulator() const { return _device; }
 
+public slots:
+  /** 每个 UI 帧调用一次：仿真有新步数时把最新快照交给 View。 */
+  void onFrame();
+
 private slots:
-  void onSimulationTimeout();
-  void onStateUpdated(double position, double velocity, double sensorValue);
   void onStartClicked();
   void onStopClicked();
   void onTargetChanged(int value);
@@ -35,6 +40,6 @@ private slots:
 private:
   MainWindow* _view{nullptr};
   DeviceSimulator* _device{nullptr};
-  QTimer* _simTimer{nullptr};
-  qint64 _lastStepTimeMs{0};
+  bool _simulating{false};
+  std::uint64_t _lastStep{0};
 };
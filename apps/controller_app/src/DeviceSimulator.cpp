@@ -1,5 +1,9 @@
 #include "DeviceSimulator.h"
 
+#include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
+
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 
@@ -10,36 +14,71 @@ constexpr double kSensorNoiseAmplitude = 0.05;  // 稍大以便图表可见波
 
 DeviceSimulator::DeviceSimulator(QObject* parent) : QObject(parent) {}
 
+DeviceSimulator::~DeviceSimulator() {
+  stopStepping();
+}
+
 void DeviceSimulator::setTarget(double positionOrVelocity) {
-  _targetPosition = positionOrVelocity;
+  _targetPosition.store(positionOrVelocity, std::memory_order_relaxed);
 }
 
 void DeviceSimulator::start() {
-  if (_running) return;
-  _running = true;
+  if (_running.exchange(true)) return;
   emit started();
 }
 
 void DeviceSimulator::stop() {
-  if (!_running) return;
-  _running = false;
+  if (!_running.exchange(false)) return;
   emit stopped();
 }
 
 common::device::DeviceSnapshot DeviceSimulator::latestSnapshot() const {
-  return {_position, _velocity, _sensorValue, _running};
+  return _snapshot.readSnapshot();
 }
 
-void DeviceSimulator::step(double dtSeconds) {
-  if (!_running) return;
+void DeviceSimulator::startStepping(const common::rt::PeriodicTimer::Params& timing) {
+  if (_stepping.exchange(true)) return;
+  _thread = std::thread([this, timing] { run(timing); });
+}
 
-  const double error = _targetPosition - _position;
-  _velocity = kProportionalGain * error;
-  _position += _velocity * dtSeconds;
+void DeviceSimulator::stopStepping() {
+  if (!_stepping.exchange(false)) return;
+  if (_thread.joinable()) _thread.join();
+}
+
+void DeviceSimulator::run(common::rt::PeriodicTimer::Params timing) {
+  common::log::SetThreadName("device_sim");
+  common::rt::ConfigureCurrentThread("device_sim");
+  // 固定 dt：错过的周期按 overrun 策略处理，不把 UI 或调度抖动带进仿真。
+  const double dt = std::chrono::duration<double>(timing.period).count();
+  common::rt::PeriodicTimer timer(timing);
+  timer.start();
+  while (_stepping.load(std::memory_order_acquire)) {
+    step(dt);
+    timer.wait();
+  }
+  common::log::Info("device_sim", "device_sim timing: " + common::rt::Describe(timer.stats()));
+}
+
+void DeviceSimulator::step(double dtSeconds) {
+  const bool running = _running.load(std::memory_order_acquire);
+  // 停止期间状态不变，只发布一次 running=false。
+  if (!running && !_wasRunning) return;
+  _wasRunning = running;
+  if (running) {
+    const double error = _targetPosition.load(std::memory_order_relaxed) - _position;
+    _velocity = kProportionalGain * error;
+    _position += _velocity * dtSeconds;
 
-  _rng = _rng * 1103515245u + 12345u;
-  const double noise = (static_cast<double>(_rng % 65536) / 65536.0 - 0.5) * 2.0 * kSensorNoiseAmplitude;
-  _sensorValue = _position + noise;
+    _rng = _rng * 1103515245u + 12345u;
+    const double noise = (static_cast<double>(_rng % 65536) / 65536.0 - 0.5) * 2.0 * kSensorNoiseAmplitude;
+    _sensorValue = _position + noise;
+  }
 
-  emit stateUpdated(_position, _velocity, _sensorValue);
+  auto& s = _snapshot.back();
+  s.position = _position;
+  s.velocity = _velocity;
+  s.sensorValue = _sensorValue;
+  s.running = running;
+  _snapshot.publishSwap();
 }
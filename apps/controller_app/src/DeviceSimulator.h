@@ -2,44 +2,62 @@
 
 #include "common/device/IDataAcquisition.h"
 #include "common/device/IHardwareControl.h"
+#include "common/rt/PeriodicTimer.h"
+#include "common/rt/SeqlockChannel.h"
 
 #include <QObject>
 
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
 /**
- * 设备模拟 Model：目标位置/速度、当前位置/速度、运行状态；
- * 比例逼近逻辑，步进后发出 stateUpdated 供 View/Controller 连接。
+ * 设备模拟 Model：目标位置/速度、当前位置/速度、运行状态；比例逼近逻辑。
+ * 在独立线程 "device_sim" 上按固定频率步进（dt 固定，不受 UI 卡顿影响），每步把状态发布到无锁快照，
+ * View 每帧通过 latestSnapshot() 取一次最新状态。setTarget/start/stop 可在任意线程调用。
  * 实现硬件控制接口与数据采集接口（预留扩展）。
  */
 class DeviceSimulator : public QObject, public common::device::IHardwareControl, public common::device::IDataAcquisition {
   Q_OBJECT
 public:
   explicit DeviceSimulator(QObject* parent = nullptr);
+  ~DeviceSimulator() override;
 
   void setTarget(double positionOrVelocity) override;
   void start() override;
   void stop() override;
 
+  /** 最新发布的状态（任意线程，不阻塞仿真线程）。 */
   common::device::DeviceSnapshot latestSnapshot() const override;
+  /** 已发布的步数；View 用它判断两帧之间是否有新状态。 */
+  std::uint64_t stepCount() const { return _snapshot.publishCount(); }
 
-  /** 每周期步进，由 QTimer 或 Controller 调用（主线程）。 */
-  void step(double dtSeconds);
+  /** 启动仿真线程，周期取自 timing.period。 */
+  void startStepping(const common::rt::PeriodicTimer::Params& timing);
+  void stopStepping();
 
-  bool isRunning() const { return _running; }
-  double targetPosition() const { return _targetPosition; }
-  double currentPosition() const { return _position; }
-  double currentVelocity() const { return _velocity; }
-  double currentSensorValue() const { return _sensorValue; }
+  bool isRunning() const { return _running.load(std::memory_order_acquire); }
+  double targetPosition() const { return _targetPosition.load(std::memory_order_relaxed); }
 
 signals:
-  void stateUpdated(double position, double velocity, double sensorValue);
   void started();
   void stopped();
 
 private:
-  double _targetPosition{0.0};
+  /** 前进 dtSeconds 并发布快照，仅在仿真线程调用。 */
+  void step(double dtSeconds);
+  void run(common::rt::PeriodicTimer::Params timing);
+
+  std::atomic<double> _targetPosition{0.0};
+  std::atomic<bool> _running{false};
+  // 以下仅由仿真线程读写
   double _position{0.0};
   double _velocity{0.0};
   double _sensorValue{0.0};
-  bool _running{false};
-  mutable unsigned _rng{1}; // 简单 LCG 用于传感器噪声
+  unsigned _rng{1}; // 简单 LCG 用于传感器噪声
+  bool _wasRunning{false};
+
+  common::rt::SeqlockChannel<common::device::DeviceSnapshot> _snapshot;
+  std::atomic<bool> _stepping{false};
+  std::thread _thread;
 };
@@ -0,0 +1,121 @@
+#include "HeadlessControllerApp.h"
+
+#include "common/config/ConfigPoco.h"
+#include "ControllerRuntimeDds.h"
+#include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
+#include "common/sensor/SensorPipeline.h"
+#include "common/status/Models.h"
+#include "common/status/ProcessStats.h"
+#include "common/status/StatusServer.h"
+#include "common/status/StatusSnapshot.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Poco::Util::Application;
+
+HeadlessControllerApp::HeadlessControllerApp() : ControllerAppBase("controller_headless") {}
+
+void HeadlessControllerApp::configure() {
+  // controller_headless.ini (if any) overrides the shared controller_app.ini next to the executable.
+  loadConfiguration();
+  const std::string shared = Poco::Path(config().getString("application.dir", "")).append("controller_app.ini").toString();
+  if (Poco::File(shared).exists()) loadConfiguration(shared, PRIO_DEFAULT + 1);
+}
+
+int HeadlessControllerApp::main(const std::vector<std::string>&) {
+  common::log::SetThreadName("main");
+  common::rt::ConfigureCurrentThread("main");
+  common::log::Info("main", "controller_headless starting");
+
+  Poco::Path appPath;
+  getApplicationPath(appPath);
+  const std::string appDirPath = appPath.parent().absolute().toString();
+
+  auto cfg = common::config::WrapPocoConfig(config());
+  common::sensor::SensorPipeline sensor(common::sensor::LoadSensorParams(cfg));
+  sensor.start();
+
+  common::status::StatusStore statusStore;
+  controller_app::ControllerRuntimeDds runtime(cfg, sensor, statusStore, appDirPath);
+  runtime.start();
+  logStartup("runtime_ms");
+
+  if (verifyStartup()) {
+    const int rc = controller_app::VerifyStartup(statusStore, config());
+    runtime.stop();
+    sensor.stop();
+    return rc;
+  }
+
+  common::status::StatusServer server(statusStore, common::status::LoadStatusServerParams(cfg), [&](std::string& out) {
+    const auto snap = sensor.latest();
+    const auto e2e = runtime.endToEndLatency();
+    char buf[256];
+    std::snprintf(buf, sizeof buf,
+                  "sensor.filter_cost_us %.2f\ne2e.p50_ms %.3f\ne2e.p99_ms %.3f\nprocess.rss_bytes %llu\n"
+                  "process.peak_rss_bytes %llu\n",
+                  snap.filterCostNs / 1000.0, static_cast<double>(e2e.percentileNs(0.5)) / 1e6,
+                  static_cast<double>(e2e.percentileNs(0.99)) / 1e6,
+                  static_cast<unsigned long long>(common::status::ResidentBytes()),
+                  static_cast<unsigned long long>(common::status::PeakResidentBytes()));
+    out += buf;
+  });
+  server.start();
+
+  const auto logPeriod = std::chrono::seconds(std::max(1, config().getInt("status.log_s", 10)));
+  std::mutex mu;
+  std::condition_variable cv;
+  bool stopping = false;
+  std::thread reporter([&] {
+    common::log::SetThreadName("status_log");
+    common::rt::ConfigureCurrentThread("status_log");
+    // Nothing renders the control steps here; drain them so the ring never reports drops.
+    std::vector<common::control::TelemetrySample> telemetry;
+    std::uint64_t steps = 0;
+    bool healthySeen = false;
+    auto nextLog = std::chrono::steady_clock::now() + logPeriod;
+    std::unique_lock<std::mutex> lk(mu);
+    while (!cv.wait_for(lk, std::chrono::milliseconds(100), [&] { return stopping; })) {
+      telemetry.clear();
+      steps += runtime.drainTelemetry(telemetry);
+      const auto st = statusStore.read();
+      if (!healthySeen && st.algoHealth == common::status::AlgoHealthState::Healthy) {
+        healthySeen = true;
+        logStartup("healthy_ms");
+      }
+      if (std::chrono::steady_clock::now() < nextLog) continue;
+      nextLog += logPeriod;
+      char buf[256];
+      std::snprintf(buf, sizeof buf, "state=%s algo=%s sensor_hz=%.1f loop_hz=%.1f algo_ms=%.2f steps=%llu ",
+                    common::status::ToString(st.systemState), common::status::ToString(st.algoHealth), st.sensorRateHz,
+                    st.controlLoopHz, st.algoLatencyMs, static_cast<unsigned long long>(steps));
+      common::log::Info("status", buf + common::status::DescribeMemory());
+    }
+  });
+
+  waitForTerminationRequest();
+
+  {
+    std::lock_guard<std::mutex> lk(mu);
+    stopping = true;
+  }
+  cv.notify_all();
+  reporter.join();
+  server.stop();
+  runtime.stop();
+  sensor.stop();
+
+  common::log::Info("main", "controller_headless exiting");
+  return Application::EXIT_OK;
+}
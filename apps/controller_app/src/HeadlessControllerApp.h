@@ -0,0 +1,19 @@
+#pragma once
+
+#include "ControllerAppBase.h"
+
+#include <Poco/Util/ServerApplication.h>
+
+/**
+ * controller_app without Qt: same sensor pipeline, DDS runtime and algo_worker, with status served over HTTP
+ * ([status]) and a periodic status log line instead of the console window. Reads controller_app.ini, overridden
+ * by controller_headless.ini when present. Runs until SIGINT/SIGTERM (or as a service/daemon via Poco options).
+ */
+class HeadlessControllerApp : public controller_app::ControllerAppBase<Poco::Util::ServerApplication> {
+public:
+  HeadlessControllerApp();
+
+protected:
+  void configure() override;
+  int main(const std::vector<std::string>& args) override;
+};
@@ -1,6 +1,7 @@
 #include "MainWindow.h"
 #include "ui/ControlPanel.h"
 #include "ui/LogPanel.h"
+#include "ui/RasterPlot.h"
 #include "ui/ReadoutStrip.h"
 #include "ui/StatusStrip.h"
 #include "ui/StyleHelper.h"
@@ -9,6 +10,8 @@
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 MainWindow::MainWindow(QWidget* parent) : QWidget(parent) {
   setObjectName("mainContainer");
   setWindowTitle(QStringLiteral("Medical Robot Control Demo"));
@@ -61,6 +64,34 @@ QPlainTextEdit* MainWindow::logEdit() const {
 void MainWindow::updateState(double position, double velocity, double sensorValue) {
   if (_readoutStrip) _readoutStrip->updateValues(position, velocity, sensorValue);
   if (_telemetryChart) _telemetryChart->appendSample(position, sensorValue);
+  if (_rasterPlot) _rasterPlot->appendSample({position, sensorValue});
+}
+
+void MainWindow::setFrameRate(int hz) {
+  setFrameInterval(hz > 0 ? 1000 / hz : 33);
+}
+
+void MainWindow::setFrameInterval(int ms) {
+  _frameIntervalMs = std::max(0, ms);
+  if (_telemetryChart) _telemetryChart->setFrameInterval(_frameIntervalMs);
+  if (_rasterPlot) _rasterPlot->setFrameInterval(_frameIntervalMs);
+  if (_logPanel) _logPanel->setFrameInterval(_frameIntervalMs);
+}
+
+void MainWindow::useRasterTelemetry(int window) {
+  if (!_rasterPlot) {
+    _rasterPlot = new ui::RasterPlot(this);
+    _rasterPlot->setTitle(tr("TELEMETRY"));
+    _rasterPlot->addSeries(tr("Position"), QColor(0x00, 0xd4, 0xaa), 2);
+    _rasterPlot->addSeries(tr("Sensor"), QColor(0x7e, 0xe8, 0xc9), 1);
+    _rasterPlot->setFrameInterval(_frameIntervalMs);
+    if (_telemetryChart) {
+      delete layout()->replaceWidget(_telemetryChart, _rasterPlot);
+      _telemetryChart->deleteLater();
+      _telemetryChart = nullptr;
+    }
+  }
+  _rasterPlot->setWindow(window);
 }
 
 void MainWindow::appendLog(const QString& text) {
@@ -73,4 +104,11 @@ void MainWindow::setStatusText(const QString& text) {
 
 void MainWindow::clearChart() {
   if (_telemetryChart) _telemetryChart->clearChart();
+  if (_rasterPlot) _rasterPlot->clearChart();
+}
+
+void MainWindow::flushFrame() {
+  if (_telemetryChart) _telemetryChart->flushFrame();
+  if (_rasterPlot) _rasterPlot->flushFrame();
+  if (_logPanel) _logPanel->flushFrame();
 }
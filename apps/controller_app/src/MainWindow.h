@@ -9,6 +9,7 @@ namespace ui {
 class StatusStrip;
 class ControlPanel;
 class TelemetryChart;
+class RasterPlot;
 class ReadoutStrip;
 class LogPanel;
 }
@@ -26,13 +27,26 @@ class MainWindow : public QWidget {
   QPushButton* stopButton() const;
   QSlider* targetSlider() const;
   QPlainTextEdit* logEdit() const;
+  /** 使用 RasterPlot 时为 nullptr。 */
+  ui::TelemetryChart* telemetryChart() const { return _telemetryChart; }
+  ui::RasterPlot* rasterPlot() const { return _rasterPlot; }
+  ui::LogPanel* logPanel() const { return _logPanel; }
 
   void updateState(double position, double velocity, double sensorValue);
+  /** 图表和日志的刷新频率（每秒帧数），与数据更新频率无关。 */
+  void setFrameRate(int hz);
+  /** 帧间隔（ms）；0 表示图表和日志不自动刷新，由调用方每帧调用 flushFrame()。 */
+  void setFrameInterval(int ms);
+  int frameInterval() const { return _frameIntervalMs; }
+  /** 用 RasterPlot 替换 TelemetryChart 显示遥测（每帧开销更低，不支持缩放历史），window 为显示的采样点数。 */
+  void useRasterTelemetry(int window);
 
 public slots:
   void appendLog(const QString& text);
   void setStatusText(const QString& text);
   void clearChart();
+  /** 立即把图表和日志面板缓存的数据画入视图（一帧的工作）。 */
+  void flushFrame();
 
 signals:
   void startClicked();
@@ -43,6 +57,8 @@ public slots:
   ui::StatusStrip* _statusStrip{nullptr};
   ui::ControlPanel* _controlPanel{nullptr};
   ui::TelemetryChart* _telemetryChart{nullptr};
+  ui::RasterPlot* _rasterPlot{nullptr};
   ui::ReadoutStrip* _readoutStrip{nullptr};
   ui::LogPanel* _logPanel{nullptr};
+  int _frameIntervalMs{33};
 };
@@ -0,0 +1,4 @@
+#include "HeadlessControllerApp.h"
+#include <Poco/Util/ServerApplication.h>
+
+POCO_SERVER_MAIN(HeadlessControllerApp)
@@ -0,0 +1,42 @@
+#include "DecimatedSeries.h"
+
+#include <QXYSeries>
+
+#include <algorithm>
+
+namespace ui {
+
+DecimatedSeries::DecimatedSeries(QXYSeries* series, std::size_t history) : _series(series), _pyramid(history) {}
+
+void DecimatedSeries::append(double y) {
+  _pyramid.push(y);
+}
+
+void DecimatedSeries::clear() {
+  _pyramid.clear();
+  _points.clear();
+  _series->clear();
+}
+
+void DecimatedSeries::setHistory(std::size_t samples) {
+  _pyramid.reset(samples);
+  clear();
+}
+
+void DecimatedSeries::render(std::uint64_t first, int pixels, Decimation mode) {
+  _pyramid.query(first, static_cast<std::size_t>(std::max(pixels, 2)), mode, _points);
+  _qpoints.resize(static_cast<qsizetype>(_points.size()));
+  for (std::size_t i = 0; i < _points.size(); ++i) _qpoints[static_cast<qsizetype>(i)] = QPointF(_points[i].x, _points[i].y);
+  _series->replace(_qpoints);
+}
+
+bool DecimatedSeries::yRange(double& minY, double& maxY) const {
+  if (_points.empty()) return false;
+  const auto [lo, hi] = std::minmax_element(_points.begin(), _points.end(),
+                                            [](const PlotPoint& a, const PlotPoint& b) { return a.y < b.y; });
+  minY = lo->y;
+  maxY = hi->y;
+  return true;
+}
+
+} // namespace ui
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "MinMaxPyramid.h"
+
+#include <QList>
+#include <QPointF>
+
+#include <cstdint>
+#include <vector>
+
+class QXYSeries;
+
+namespace ui {
+
+/**
+ * 曲线前的抽样层：采样进入 MinMaxPyramid，render() 每帧按绘图区像素宽度取点并对曲线做一次 replace()。
+ * 不拥有 series。
+ */
+class DecimatedSeries {
+public:
+  DecimatedSeries(QXYSeries* series, std::size_t history);
+
+  void append(double y);
+  void clear();
+  /** 改变保留的历史采样数并清空。 */
+  void setHistory(std::size_t samples);
+  std::size_t history() const { return _pyramid.history(); }
+  /** 已追加的采样总数；最新采样的 x 为 count() - 1。 */
+  std::uint64_t count() const { return _pyramid.count(); }
+
+  /** 用 x ∈ [first, count()) 的采样刷新曲线，约 2 点/像素。 */
+  void render(std::uint64_t first, int pixels, Decimation mode);
+  /** 最近一次 render() 输出点的 y 范围；没有点时返回 false。 */
+  bool yRange(double& minY, double& maxY) const;
+
+private:
+  QXYSeries* _series;
+  MinMaxPyramid _pyramid;
+  std::vector<PlotPoint> _points;
+  QList<QPointF> _qpoints;
+};
+
+} // namespace ui
@@ -0,0 +1,49 @@
+#include "LogModel.h"
+
+#include <algorithm>
+
+namespace ui {
+
+LogModel::LogModel(int capacity, QObject* parent) : QAbstractListModel(parent), _capacity(std::max(1, capacity)) {}
+
+int LogModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : static_cast<int>(_lines.size());
+}
+
+QVariant LogModel::data(const QModelIndex& index, int role) const {
+  if (role != Qt::DisplayRole || !index.isValid() || index.row() >= static_cast<int>(_lines.size())) return {};
+  return _lines[static_cast<std::size_t>(index.row())];
+}
+
+void LogModel::append(const QStringList& lines) {
+  // 一批比容量还大时只有尾部会留下，前面的行不必插入。
+  const int skip = std::max(0, static_cast<int>(lines.size()) - _capacity);
+  const int incoming = static_cast<int>(lines.size()) - skip;
+  if (incoming == 0) return;
+  trimFront(_capacity - incoming);
+  const int first = static_cast<int>(_lines.size());
+  beginInsertRows(QModelIndex(), first, first + incoming - 1);
+  for (int i = skip; i < static_cast<int>(lines.size()); ++i) _lines.push_back(lines[i]);
+  endInsertRows();
+}
+
+void LogModel::clear() {
+  beginResetModel();
+  _lines.clear();
+  endResetModel();
+}
+
+void LogModel::setCapacity(int capacity) {
+  _capacity = std::max(1, capacity);
+  trimFront(_capacity);
+}
+
+void LogModel::trimFront(int keep) {
+  const int excess = static_cast<int>(_lines.size()) - keep;
+  if (excess <= 0) return;
+  beginRemoveRows(QModelIndex(), 0, excess - 1);
+  _lines.erase(_lines.begin(), _lines.begin() + excess);
+  endRemoveRows();
+}
+
+} // namespace ui
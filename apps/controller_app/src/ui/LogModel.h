@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+
+#include <deque>
+
+namespace ui {
+
+/**
+ * 日志列表模型：最多保留 capacity 行的环，配合 QListView（uniformItemSizes）只绘制可见行，
+ * 适合几十万行的历史。append() 一次插入一批，超出容量时先从头部批量删除。
+ */
+class LogModel : public QAbstractListModel {
+  Q_OBJECT
+public:
+  explicit LogModel(int capacity, QObject* parent = nullptr);
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+  void append(const QStringList& lines);
+  void clear();
+  /** 保留的最大行数，多出的旧行立即删除。 */
+  void setCapacity(int capacity);
+  int capacity() const { return _capacity; }
+
+private:
+  void trimFront(int keep);
+
+  std::deque<QString> _lines;
+  int _capacity;
+};
+
+} // namespace ui
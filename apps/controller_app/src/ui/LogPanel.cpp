@@ -1,6 +1,11 @@
 #include "LogPanel.h"
-#include <QVBoxLayout>
+#include "LogModel.h"
+#include <QListView>
 #include <QScrollBar>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include <algorithm>
 
 namespace ui {
 
@@ -12,12 +17,73 @@ LogPanel::LogPanel(QWidget* parent) : QWidget(parent) {
   _edit->setReadOnly(true);
   _edit->setMinimumHeight(100);
   _edit->setPlaceholderText(tr("> System log..."));
+  _edit->setMaximumBlockCount(_maxLines);
   lay->addWidget(_edit);
+
+  _model = new LogModel(_maxLines, this);
+  _list = new QListView(this);
+  _list->setObjectName("logBox");
+  _list->setMinimumHeight(100);
+  _list->setModel(_model);
+  // 行高一致时 QListView 不逐行测量，只布局和绘制可见行。
+  _list->setUniformItemSizes(true);
+  _list->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  _list->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  _list->hide();
+  lay->addWidget(_list);
+
+  _frameTimer = new QTimer(this);
+  connect(_frameTimer, &QTimer::timeout, this, &LogPanel::flushFrame);
+  _frameTimer->start(33);
 }
 
 void LogPanel::appendLog(const QString& text) {
-  _edit->appendPlainText(text);
-  _edit->verticalScrollBar()->setValue(_edit->verticalScrollBar()->maximum());
+  _pending.append(text);
+  // 视图停更时待显示队列也不超过上限，只留最新的行。
+  if (_pending.size() > 2 * _maxLines) _pending.erase(_pending.begin(), _pending.end() - _maxLines);
+}
+
+void LogPanel::flushFrame() {
+  if (_pending.isEmpty()) return;
+  if (_pending.size() > _maxLines) _pending.erase(_pending.begin(), _pending.end() - _maxLines);
+
+  QScrollBar* bar = _view == View::Text ? _edit->verticalScrollBar() : _list->verticalScrollBar();
+  const bool follow = bar->value() >= bar->maximum();
+  if (_view == View::Text) {
+    // 一次文档编辑；超出 maximumBlockCount 的旧块由文档自己删除。
+    _edit->appendPlainText(_pending.join(QLatin1Char('\n')));
+  } else {
+    _model->append(_pending);
+  }
+  _pending.clear();
+  if (follow) bar->setValue(bar->maximum());
+}
+
+void LogPanel::setView(View view) {
+  if (view == _view) return;
+  _view = view;
+  _edit->clear();
+  _model->clear();
+  _edit->setVisible(view == View::Text);
+  _list->setVisible(view == View::List);
+}
+
+void LogPanel::setMaxLines(int lines) {
+  _maxLines = std::max(1, lines);
+  _edit->setMaximumBlockCount(_maxLines);
+  _model->setCapacity(_maxLines);
+}
+
+int LogPanel::lineCount() const {
+  return _view == View::Text ? (_edit->document()->isEmpty() ? 0 : _edit->blockCount()) : _model->rowCount();
+}
+
+void LogPanel::setFrameInterval(int ms) {
+  if (ms > 0) {
+    _frameTimer->start(ms);
+  } else {
+    _frameTimer->stop();
+  }
 }
 
 } // namespace ui
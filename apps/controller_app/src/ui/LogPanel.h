@@ -1,23 +1,55 @@
 #pragma once
 
 #include <QPlainTextEdit>
+#include <QStringList>
 #include <QWidget>
 
+class QListView;
+class QTimer;
+
 namespace ui {
 
-/** 日志层：只读文本框，接收追加的日志行。 */
+class LogModel;
+
+/**
+ * 日志层：appendLog() 只把行放进待显示队列，每帧（帧定时器或 flushFrame()）一次性写入视图，
+ * 只在原本停在底部时跟随滚动。保留行数有上限（超出后丢弃最旧的行）。
+ * Text 视图为只读文本框（一次文档编辑/帧）；List 视图为虚拟化的 QListView + LogModel，只绘制可见行，用于很长的历史。
+ */
 class LogPanel : public QWidget {
   Q_OBJECT
 public:
+  enum class View { Text, List };
+
   explicit LogPanel(QWidget* parent = nullptr);
 
   QPlainTextEdit* logEdit() const { return _edit; }
 
+  /** 切换视图，会清空已显示的行。 */
+  void setView(View view);
+  View view() const { return _view; }
+  /** 保留的最大行数。 */
+  void setMaxLines(int lines);
+  int maxLines() const { return _maxLines; }
+  /** 当前显示的行数。 */
+  int lineCount() const;
+  /** 帧定时器间隔（ms）；0 表示不自动刷新，由调用方每帧调用 flushFrame()。 */
+  void setFrameInterval(int ms);
+
 public slots:
   void appendLog(const QString& text);
+  /** 把两帧之间到达的行一次写入视图。 */
+  void flushFrame();
 
 private:
   QPlainTextEdit* _edit{nullptr};
+  QListView* _list{nullptr};
+  LogModel* _model{nullptr};
+  QTimer* _frameTimer{nullptr};
+  QStringList _pending;
+  View _view{View::Text};
+  int _maxLines{kDefaultMaxLines};
+  static constexpr int kDefaultMaxLines = 5000;
 };
 
 } // namespace ui
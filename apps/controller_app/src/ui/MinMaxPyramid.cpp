@@ -0,0 +1,211 @@
+#include "MinMaxPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+
+namespace {
+constexpr std::uint64_t kFanOut = 4;
+} // namespace
+
+void MinMaxPyramid::BucketEmitter::add(const Bucket& b) {
+  if (_inGroup == 0) {
+    _merged = b;
+  } else {
+    // 桶按 x 递增到达，相等时保留较早的点。
+    if (b.min < _merged.min) {
+      _merged.min = b.min;
+      _merged.minX = b.minX;
+    }
+    if (b.max > _merged.max) {
+      _merged.max = b.max;
+      _merged.maxX = b.maxX;
+    }
+  }
+  if (++_inGroup == _group) flush();
+}
+
+void MinMaxPyramid::BucketEmitter::flush() {
+  if (_inGroup == 0) return;
+  _inGroup = 0;
+  const Bucket& b = _merged;
+  const bool minFirst = b.minX <= b.maxX;
+  _out.push_back(PlotPoint{static_cast<double>(minFirst ? b.minX : b.maxX), minFirst ? b.min : b.max});
+  if (b.minX != b.maxX) _out.push_back(PlotPoint{static_cast<double>(minFirst ? b.maxX : b.minX), minFirst ? b.max : b.min});
+}
+
+MinMaxPyramid::MinMaxPyramid(std::size_t history) {
+  reset(history);
+}
+
+void MinMaxPyramid::reset(std::size_t history) {
+  history = std::max<std::size_t>(history, kFanOut);
+  _raw.assign(history, 0.0);
+  _levels.clear();
+  // 最粗一层仍保留至少 kFanOut 个桶。
+  for (std::uint64_t size = kFanOut; history / size >= kFanOut; size *= kFanOut) {
+    Level lv;
+    lv.bucketSize = size;
+    lv.buckets.resize(history / size + 1);
+    _levels.push_back(std::move(lv));
+  }
+  clear();
+}
+
+void MinMaxPyramid::clear() {
+  _count = 0;
+  for (auto& lv : _levels) lv.partialCount = 0;
+}
+
+void MinMaxPyramid::push(double y) {
+  const std::uint64_t x = _count++;
+  _raw[x % _raw.size()] = y;
+  for (auto& lv : _levels) {
+    auto& p = lv.partial;
+    if (lv.partialCount == 0 || y < p.min) {
+      p.min = y;
+      p.minX = x;
+    }
+    if (lv.partialCount == 0 || y > p.max) {
+      p.max = y;
+      p.maxX = x;
+    }
+    if (++lv.partialCount == lv.bucketSize) {
+      lv.buckets[(x / lv.bucketSize) % lv.buckets.size()] = p;
+      lv.partialCount = 0;
+    }
+  }
+}
+
+void MinMaxPyramid::emitRaw(std::uint64_t first, std::vector<PlotPoint>& out) const {
+  for (std::uint64_t x = first; x < _count; ++x) out.push_back(PlotPoint{static_cast<double>(x), _raw[x % _raw.size()]});
+}
+
+void MinMaxPyramid::emitGroupedRaw(std::uint64_t first, std::uint64_t group, std::vector<PlotPoint>& out) const {
+  BucketEmitter emitter(1, out);
+  for (std::uint64_t x = first; x < _count; x += group) emitter.add(rawBucket(x, std::min(x + group, _count)));
+}
+
+void MinMaxPyramid::emitBuckets(std::size_t level, std::uint64_t first, std::uint64_t group,
+                                std::vector<PlotPoint>& out) const {
+  const auto& lv = _levels[level - 1];
+  BucketEmitter emitter(group, out);
+  const auto emit = [&emitter](const Bucket& b) { emitter.add(b); };
+  const std::uint64_t completed = _count / lv.bucketSize;
+  const std::uint64_t retained = std::min<std::uint64_t>(completed, lv.buckets.size());
+  std::uint64_t k = std::max(first / lv.bucketSize, completed - retained);
+  bool partialDone = false;
+  // 起始桶若从 first 之前开始，改用原始采样汇总 [first, 桶尾)，不输出 x < first 的点。
+  if (k * lv.bucketSize < first) {
+    emit(rawBucket(first, std::min((k + 1) * lv.bucketSize, _count)));
+    partialDone = k == completed;
+    ++k;
+  }
+  for (; k < completed; ++k) {
+    emit(lv.buckets[k % lv.buckets.size()]);
+  }
+  if (lv.partialCount > 0 && !partialDone) emit(lv.partial);
+  emitter.flush();
+}
+
+MinMaxPyramid::Bucket MinMaxPyramid::rawBucket(std::uint64_t begin, std::uint64_t end) const {
+  Bucket b;
+  for (std::uint64_t x = begin; x < end; ++x) {
+    const double y = _raw[x % _raw.size()];
+    if (x == begin || y < b.min) {
+      b.min = y;
+      b.minX = x;
+    }
+    if (x == begin || y > b.max) {
+      b.max = y;
+      b.maxX = x;
+    }
+  }
+  return b;
+}
+
+void MinMaxPyramid::query(std::uint64_t first, std::size_t maxBuckets, Decimation mode,
+                          std::vector<PlotPoint>& out) const {
+  out.clear();
+  const std::uint64_t oldest = _count - std::min<std::uint64_t>(_count, _raw.size());
+  first = std::max(first, oldest);
+  if (first >= _count) return;
+  maxBuckets = std::max<std::size_t>(maxBuckets, 2);
+
+  // 最细的、[first, count) 触及的桶数（含首尾不完整的桶）不超过 maxBuckets 的层级；0 = 原始采样。
+  const auto touched = [&](std::uint64_t size) { return (_count - 1) / size - first / size + 1; };
+  std::size_t level = 0;
+  std::uint64_t size = 1;
+  while (touched(size) > maxBuckets && level < _levels.size()) {
+    ++level;
+    size *= kFanOut;
+  }
+  // 最粗一层仍超出时（窗口极窄或历史很短），每 group 个桶再合并为一个。
+  const std::uint64_t group = (touched(size) + maxBuckets - 1) / maxBuckets;
+
+  if (mode == Decimation::MinMax || level == 0) {
+    if (level == 0) {
+      if (group > 1) {
+        emitGroupedRaw(first, group, out);
+      } else {
+        emitRaw(first, out);
+      }
+    } else {
+      emitBuckets(level, first, group, out);
+    }
+    return;
+  }
+  // Lttb：从细一层（至多 4 倍的点）选出 2 * maxBuckets 个点。
+  _scratch.clear();
+  if (level == 1) {
+    emitRaw(first, _scratch);
+  } else {
+    emitBuckets(level - 1, first, 1, _scratch);
+  }
+  Lttb(_scratch, 2 * maxBuckets, out);
+}
+
+void Lttb(const std::vector<PlotPoint>& in, std::size_t threshold, std::vector<PlotPoint>& out) {
+  out.clear();
+  const std::size_t n = in.size();
+  if (threshold >= n || threshold < 3) {
+    out = in;
+    return;
+  }
+  out.reserve(threshold);
+  out.push_back(in.front());
+  const double every = static_cast<double>(n - 2) / static_cast<double>(threshold - 2);
+  std::size_t a = 0;
+  for (std::size_t i = 0; i + 2 < threshold; ++i) {
+    // 下一个桶的平均点作为三角形的第三个顶点。
+    const auto nextBegin = static_cast<std::size_t>(std::floor(static_cast<double>(i + 1) * every)) + 1;
+    const auto nextEnd = std::min(static_cast<std::size_t>(std::floor(static_cast<double>(i + 2) * every)) + 1, n);
+    double avgX = 0.0;
+    double avgY = 0.0;
+    for (std::size_t j = nextBegin; j < nextEnd; ++j) {
+      avgX += in[j].x;
+      avgY += in[j].y;
+    }
+    const auto cnt = static_cast<double>(std::max<std::size_t>(nextEnd - nextBegin, 1));
+    avgX /= cnt;
+    avgY /= cnt;
+
+    const auto begin = static_cast<std::size_t>(std::floor(static_cast<double>(i) * every)) + 1;
+    const auto end = static_cast<std::size_t>(std::floor(static_cast<double>(i + 1) * every)) + 1;
+    double bestArea = -1.0;
+    std::size_t best = begin;
+    for (std::size_t j = begin; j < end; ++j) {
+      const double area = std::abs((in[a].x - avgX) * (in[j].y - in[a].y) - (in[a].x - in[j].x) * (avgY - in[a].y));
+      if (area > bestArea) {
+        bestArea = area;
+        best = j;
+      }
+    }
+    out.push_back(in[best]);
+    a = best;
+  }
+  out.push_back(in.back());
+}
+
+} // namespace ui
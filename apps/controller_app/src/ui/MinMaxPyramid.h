@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+
+struct PlotPoint {
+  double x{0.0};
+  double y{0.0};
+};
+
+/** 抽样方式：MinMax 每个桶画最小/最大两点（不丢尖峰）；Lttb 保留视觉形状最大的点（曲线更平滑）。 */
+enum class Decimation { MinMax, Lttb };
+
+/**
+ * 单通道多分辨率 min/max 金字塔：第 0 层为原始采样环，第 L 层每个桶汇总 4^L 个采样的最小/最大值。
+ * push() 逐层增量更新（O(层数)，不分配内存），query() 选取桶数不超过像素宽度的最粗层级，
+ * 因此无论显示几百个点还是几分钟的历史，每帧输出都不超过约 2 点/像素。x 为采样序号（从 0 递增）。
+ */
+class MinMaxPyramid {
+public:
+  /** history：保留的原始采样数。 */
+  explicit MinMaxPyramid(std::size_t history);
+
+  /** 改变保留的历史长度并清空。 */
+  void reset(std::size_t history);
+  void clear();
+  void push(double y);
+
+  /** 已追加的采样总数（即下一个采样的 x）。 */
+  std::uint64_t count() const { return _count; }
+  std::size_t history() const { return _raw.size(); }
+
+  /**
+   * 输出 x ∈ [first, count()) 的曲线（first 早于保留的历史时从最旧的保留采样开始），
+   * 至多 2 * maxBuckets 个点，x 递增。
+   */
+  void query(std::uint64_t first, std::size_t maxBuckets, Decimation mode, std::vector<PlotPoint>& out) const;
+
+private:
+  struct Bucket {
+    double min{0.0};
+    double max{0.0};
+    std::uint64_t minX{0};
+    std::uint64_t maxX{0};
+  };
+  struct Level {
+    std::uint64_t bucketSize{1};
+    std::vector<Bucket> buckets;  // 按桶序号取模存放
+    Bucket partial;               // 尚未填满的最新桶
+    std::uint64_t partialCount{0};
+  };
+
+  /** 每 group 个相邻桶合并为一个，按 x 顺序输出合并桶的最小/最大点。 */
+  class BucketEmitter {
+  public:
+    BucketEmitter(std::uint64_t group, std::vector<PlotPoint>& out) : _group(group), _out(out) {}
+    void add(const Bucket& b);
+    /** 输出未凑满 group 的最后一组。 */
+    void flush();
+
+  private:
+    const std::uint64_t _group;
+    std::vector<PlotPoint>& _out;
+    Bucket _merged;
+    std::uint64_t _inGroup{0};
+  };
+
+  /** 第 level 层（>= 1）覆盖 [first, count()) 的桶，每 group 个合并后输出最小/最大点。 */
+  void emitBuckets(std::size_t level, std::uint64_t first, std::uint64_t group, std::vector<PlotPoint>& out) const;
+  void emitRaw(std::uint64_t first, std::vector<PlotPoint>& out) const;
+  /** 原始采样每 group 个一桶输出最小/最大点（没有足够层级时）。 */
+  void emitGroupedRaw(std::uint64_t first, std::uint64_t group, std::vector<PlotPoint>& out) const;
+  /** 原始采样 [begin, end) 的最小/最大值（end > begin，且都在保留的历史内）。 */
+  Bucket rawBucket(std::uint64_t begin, std::uint64_t end) const;
+
+  std::vector<double> _raw;
+  std::vector<Level> _levels;  // _levels[0] 为第 1 层
+  std::uint64_t _count{0};
+  mutable std::vector<PlotPoint> _scratch;  // Lttb 的输入
+};
+
+/** Largest-Triangle-Three-Buckets：把 in 降为 threshold 个点，保留首尾点。 */
+void Lttb(const std::vector<PlotPoint>& in, std::size_t threshold, std::vector<PlotPoint>& out);
+
+} // namespace ui
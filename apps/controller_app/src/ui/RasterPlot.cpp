@@ -0,0 +1,307 @@
+#include "RasterPlot.h"
+#include <QFont>
+#include <QLineF>
+#include <QPainter>
+#include <QResizeEvent>
+#include <QTimer>
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ui {
+
+namespace {
+
+const QColor kBackground(0x0a, 0x0e, 0x14);
+const QColor kGrid(0x1e, 0x3a, 0x2f);
+const QColor kLabel(0x5a, 0x9b, 0x8a);
+const QColor kTitle(0x00, 0xd4, 0xaa);
+const QColor kLegend(0x7e, 0xe8, 0xc9);
+constexpr int kGridRows = 4;
+constexpr int kGridColumns = 6;
+
+bool IsValid(double min, double max) {
+  return min <= max;
+}
+
+} // namespace
+
+RasterPlot::RasterPlot(QWidget* parent) : QWidget(parent) {
+  setMinimumHeight(240);
+  setAttribute(Qt::WA_OpaquePaintEvent);
+
+  _frameTimer = new QTimer(this);
+  connect(_frameTimer, &QTimer::timeout, this, &RasterPlot::flushFrame);
+  _frameTimer->start(33);
+}
+
+int RasterPlot::addSeries(const QString& name, const QColor& color, qreal width) {
+  _series.push_back(Series{name, QPen(color, width), {}});
+  _partial.resize(_series.size());
+  clearChart();
+  return static_cast<int>(_series.size()) - 1;
+}
+
+void RasterPlot::setTitle(const QString& title) {
+  _title = title;
+  _fullRedraw = true;
+}
+
+void RasterPlot::appendSample(std::initializer_list<double> values) {
+  const auto slot = static_cast<std::size_t>(_sampleCount % static_cast<std::uint64_t>(_window));
+  std::size_t i = 0;
+  for (const double v : values) {
+    if (i == _series.size()) break;
+    _series[i].raw[slot] = v;
+    Column& p = _partial[i];
+    p.min = std::min(p.min, v);
+    p.max = std::max(p.max, v);
+    p.last = v;
+    ++i;
+  }
+  ++_sampleCount;
+  if (_columns.empty() || ++_partialCount < _samplesPerColumn) return;
+
+  // 一列凑满：存入环，超出 Y 范围时整幅重画。
+  for (std::size_t s = 0; s < _series.size(); ++s) {
+    column(s, _columnCount) = _partial[s];
+    if (expandRange(_partial[s].min, _partial[s].max)) _fullRedraw = true;
+    _partial[s] = Column{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0.0};
+  }
+  _partialCount = 0;
+  ++_columnCount;
+}
+
+void RasterPlot::clearChart() {
+  for (auto& s : _series) s.raw.assign(static_cast<std::size_t>(_window), 0.0);
+  _sampleCount = 0;
+  rebuildColumns();
+  _fullRedraw = true;
+}
+
+void RasterPlot::setWindow(int points) {
+  _window = std::max(2, points);
+  clearChart();
+  relayout();
+}
+
+void RasterPlot::setYRange(double min, double max) {
+  if (!(min < max)) return;
+  _yMin = min;
+  _yMax = max;
+  _fullRedraw = true;
+}
+
+void RasterPlot::setFrameInterval(int ms) {
+  if (ms > 0) {
+    _frameTimer->start(ms);
+  } else {
+    _frameTimer->stop();
+  }
+}
+
+void RasterPlot::flushFrame() {
+  if (_plotRect.isEmpty() || _columns.empty()) return;
+  const std::uint64_t fresh = _columnCount - _drawnColumns;
+  if (!_fullRedraw && fresh == 0) return;
+
+  const bool full = _fullRedraw || fresh >= static_cast<std::uint64_t>(_visibleColumns);
+  if (full) {
+    if (_fullRedraw) drawBackground();
+    _trace.fill(Qt::transparent);
+    drawColumns(0);
+  } else {
+    // 已画好的列按最左可见列的前移量整体左移（blit），只清空并重画右侧新列；窗口未填满时不移动。
+    const auto visible = static_cast<std::uint64_t>(_visibleColumns);
+    const std::uint64_t oldFirst = _drawnColumns > visible ? _drawnColumns - visible : 0;
+    const std::uint64_t newFirst = _columnCount > visible ? _columnCount - visible : 0;
+    const int dx = static_cast<int>(newFirst - oldFirst) * _pixelsPerColumn;
+    if (dx > 0) {
+      const int used = _visibleColumns * _pixelsPerColumn;
+      _trace.scroll(-dx, 0, _trace.rect());
+      QPainter p(&_trace);
+      p.setCompositionMode(QPainter::CompositionMode_Clear);
+      p.fillRect(QRect(used - dx, 0, _trace.width() - (used - dx), _trace.height()), Qt::transparent);
+    }
+    drawColumns(_drawnColumns);
+  }
+  _drawnColumns = _columnCount;
+  if (_fullRedraw) {
+    _fullRedraw = false;
+    update();
+  } else {
+    update(_plotRect);
+  }
+}
+
+void RasterPlot::paintEvent(QPaintEvent*) {
+  QPainter p(this);
+  if (_background.isNull()) {
+    p.fillRect(rect(), kBackground);
+    return;
+  }
+  p.drawPixmap(0, 0, _background);
+  p.drawPixmap(_plotRect.topLeft(), _trace);
+}
+
+void RasterPlot::resizeEvent(QResizeEvent* event) {
+  QWidget::resizeEvent(event);
+  relayout();
+  flushFrame();
+}
+
+void RasterPlot::relayout() {
+  _plotRect = rect().adjusted(52, 30, -12, -26);
+  if (_plotRect.width() < 2 || _plotRect.height() < 2) {
+    _plotRect = QRect();
+    _columns.clear();
+    return;
+  }
+  const int plotWidth = _plotRect.width();
+  if (_window >= plotWidth) {
+    _pixelsPerColumn = 1;
+    _samplesPerColumn = (_window + plotWidth - 1) / plotWidth;
+    _visibleColumns = plotWidth;
+  } else {
+    _samplesPerColumn = 1;
+    _pixelsPerColumn = std::max(1, plotWidth / _window);
+    _visibleColumns = plotWidth / _pixelsPerColumn;
+  }
+  _trace = QPixmap(_plotRect.size());
+  rebuildColumns();
+  _fullRedraw = true;
+}
+
+void RasterPlot::rebuildColumns() {
+  const Column empty{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0.0};
+  for (auto& p : _partial) p = empty;
+  _drawnColumns = 0;
+  if (_plotRect.isEmpty()) {
+    _columns.clear();
+    return;
+  }
+  _columns.assign(_series.size(), std::vector<Column>(static_cast<std::size_t>(_visibleColumns) + 1, empty));
+  const auto spc = static_cast<std::uint64_t>(_samplesPerColumn);
+  _columnCount = _sampleCount / spc;
+  _partialCount = static_cast<int>(_sampleCount % spc);
+  const std::uint64_t ring = _columns.empty() ? 0 : _columns[0].size();
+  const std::uint64_t first = _columnCount > ring ? _columnCount - ring : 0;
+  for (std::size_t s = 0; s < _series.size(); ++s) {
+    for (std::uint64_t c = first; c <= _columnCount; ++c) {
+      Column col = empty;
+      const std::uint64_t end = std::min((c + 1) * spc, _sampleCount);
+      for (std::uint64_t k = c * spc; k < end; ++k) {
+        const double v = rawAt(s, k);
+        if (std::isnan(v)) continue;
+        col.min = std::min(col.min, v);
+        col.max = std::max(col.max, v);
+        col.last = v;
+      }
+      if (c < _columnCount) {
+        column(s, c) = col;
+      } else {
+        _partial[s] = col;
+      }
+    }
+  }
+}
+
+double RasterPlot::rawAt(std::size_t series, std::uint64_t sample) const {
+  const auto window = static_cast<std::uint64_t>(_window);
+  if (sample >= _sampleCount || sample + window < _sampleCount) return std::numeric_limits<double>::quiet_NaN();
+  return _series[series].raw[static_cast<std::size_t>(sample % window)];
+}
+
+bool RasterPlot::expandRange(double min, double max) {
+  if (!IsValid(min, max) || (min >= _yMin && max <= _yMax)) return false;
+  const double pad = 0.2;
+  if (min < _yMin) _yMin = min - pad;
+  if (max > _yMax) _yMax = max + pad;
+  return true;
+}
+
+double RasterPlot::mapY(double v) const {
+  const double h = _trace.height() - 1;
+  return h - (v - _yMin) / (_yMax - _yMin) * h;
+}
+
+void RasterPlot::drawBackground() {
+  _background = QPixmap(size());
+  _background.fill(kBackground);
+  QPainter p(&_background);
+
+  QFont titleFont = font();
+  titleFont.setBold(true);
+  p.setFont(titleFont);
+  p.setPen(kTitle);
+  p.drawText(QRect(8, 4, width() / 2, 22), Qt::AlignLeft | Qt::AlignVCenter, _title);
+
+  // 图例：从右往左排。
+  p.setFont(font());
+  int x = width() - 12;
+  for (auto it = _series.rbegin(); it != _series.rend(); ++it) {
+    const int textWidth = p.fontMetrics().horizontalAdvance(it->name);
+    x -= textWidth;
+    p.setPen(kLegend);
+    p.drawText(QRect(x, 4, textWidth, 22), Qt::AlignLeft | Qt::AlignVCenter, it->name);
+    x -= 20;
+    p.setPen(QPen(it->pen.color(), 2));
+    p.drawLine(x, 15, x + 14, 15);
+    x -= 12;
+  }
+
+  p.setPen(kGrid);
+  for (int r = 0; r <= kGridRows; ++r) {
+    const int y = _plotRect.top() + (_plotRect.height() - 1) * r / kGridRows;
+    p.drawLine(_plotRect.left(), y, _plotRect.right(), y);
+  }
+  for (int c = 0; c <= kGridColumns; ++c) {
+    const int x = _plotRect.left() + (_plotRect.width() - 1) * c / kGridColumns;
+    p.drawLine(x, _plotRect.top(), x, _plotRect.bottom());
+  }
+
+  p.setPen(kLabel);
+  for (int r = 0; r <= kGridRows; ++r) {
+    const int y = _plotRect.top() + (_plotRect.height() - 1) * r / kGridRows;
+    const double v = _yMax - (_yMax - _yMin) * r / kGridRows;
+    p.drawText(QRect(0, y - 8, _plotRect.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter, QString::number(v, 'f', 2));
+  }
+  // X 轴标签：相对最新采样的偏移（采样数）。
+  const long long span = static_cast<long long>(_visibleColumns) * _samplesPerColumn;
+  for (int c = 0; c <= kGridColumns; ++c) {
+    const int x = _plotRect.left() + (_plotRect.width() - 1) * c / kGridColumns;
+    const long long offset = span * (kGridColumns - c) / kGridColumns;
+    p.drawText(QRect(x - 40, _plotRect.bottom() + 4, 80, 18), Qt::AlignHCenter | Qt::AlignTop,
+               offset == 0 ? tr("0 samples") : QString::number(-offset));
+  }
+}
+
+void RasterPlot::drawColumns(std::uint64_t from) {
+  const auto visible = static_cast<std::uint64_t>(_visibleColumns);
+  const std::uint64_t firstVisible = _columnCount > visible ? _columnCount - visible : 0;
+  from = std::max(from, firstVisible);
+  if (from >= _columnCount) return;
+
+  QPainter p(&_trace);
+  QVarLengthArray<QLineF, 512> lines;
+  for (std::size_t s = 0; s < _series.size(); ++s) {
+    lines.clear();
+    for (std::uint64_t c = from; c < _columnCount; ++c) {
+      const Column& col = column(s, c);
+      if (!IsValid(col.min, col.max)) continue;
+      const double x = static_cast<double>((c - firstVisible) * _pixelsPerColumn) + _pixelsPerColumn / 2;
+      // 环比可见列多一列，c - 1 总在环里。
+      if (c > 0) {
+        const Column& prev = column(s, c - 1);
+        if (IsValid(prev.min, prev.max)) lines.append(QLineF(x - _pixelsPerColumn, mapY(prev.last), x, mapY(col.last)));
+      }
+      if (col.max > col.min) lines.append(QLineF(x, mapY(col.min), x, mapY(col.max)));
+    }
+    p.setPen(_series[s].pen);
+    p.drawLines(lines.constData(), static_cast<int>(lines.size()));
+  }
+}
+
+} // namespace ui
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QColor>
+#include <QPen>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+#include <QWidget>
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+class QTimer;
+
+namespace ui {
+
+/**
+ * 轻量遥测曲线（CPU 光栅绘制）：网格、坐标轴、标签、图例画在缓存的背景 pixmap 中，只在尺寸或 Y 范围变化时重画；
+ * 曲线画在单独的透明 pixmap 上，每帧把它向左 scroll（blit）新增的列数，只画右侧新列。
+ * 每个像素列汇总若干采样的最小/最大值，窗口大于绘图区宽度时不丢尖峰。
+ * 与 TelemetryChart 相比不支持缩放历史，换来每帧极低的绘制开销。
+ */
+class RasterPlot : public QWidget {
+  Q_OBJECT
+public:
+  explicit RasterPlot(QWidget* parent = nullptr);
+
+  /** 添加一条曲线，返回其序号；appendSample() 的值按此顺序给出。会清空曲线。 */
+  int addSeries(const QString& name, const QColor& color, qreal width = 1.0);
+  void setTitle(const QString& title);
+  /** 追加一个采样（每条曲线一个值），下一帧显示。 */
+  void appendSample(std::initializer_list<double> values);
+  void clearChart();
+
+  /** 显示的采样点数（窗口），会清空曲线。 */
+  void setWindow(int points);
+  int window() const { return _window; }
+  /** 初始 Y 范围；数据超出时自动扩大。 */
+  void setYRange(double min, double max);
+  /** 帧定时器间隔（ms）；0 表示不自动刷新，由调用方每帧调用 flushFrame()。 */
+  void setFrameInterval(int ms);
+
+public slots:
+  /** 把新完成的列画进曲线层并请求重绘绘图区。 */
+  void flushFrame();
+
+protected:
+  void paintEvent(QPaintEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+
+private:
+  struct Series {
+    QString name;
+    QPen pen;
+    std::vector<double> raw;  // 最近 _window 个采样的环
+  };
+  struct Column {
+    double min;
+    double max;
+    double last;
+  };
+
+  /** 按当前尺寸和窗口重新计算列宽/每列采样数，并从原始采样重建列。 */
+  void relayout();
+  void rebuildColumns();
+  void drawBackground();
+  /** 把 [from, _columnCount) 列画进曲线层。 */
+  void drawColumns(std::uint64_t from);
+  Column& column(std::size_t series, std::uint64_t c) { return _columns[series][c % _columns[series].size()]; }
+  double rawAt(std::size_t series, std::uint64_t sample) const;
+  bool expandRange(double min, double max);
+  double mapY(double v) const;
+
+  QString _title;
+  std::vector<Series> _series;
+  std::vector<std::vector<Column>> _columns;  // 每条曲线一个环，容量为可见列数 + 1
+  std::vector<Column> _partial;
+  int _partialCount{0};
+  std::uint64_t _sampleCount{0};
+  std::uint64_t _columnCount{0};
+  std::uint64_t _drawnColumns{0};
+
+  int _window{kDefaultWindow};
+  int _samplesPerColumn{1};
+  int _pixelsPerColumn{1};
+  int _visibleColumns{1};
+  double _yMin{-1.5};
+  double _yMax{1.5};
+
+  QRect _plotRect;
+  QPixmap _background;
+  QPixmap _trace;
+  bool _fullRedraw{true};
+  QTimer* _frameTimer{nullptr};
+  static constexpr int kDefaultWindow = 300;
+};
+
+} // namespace ui
@@ -68,7 +68,7 @@ inline QString sciFiStylesheet() {
   }
   QSlider::handle:horizontal:hover { background: #33e0b8; }
   QSlider::sub-page:horizontal { background: #1e3a2f; border-radius: 3px; }
-  QPlainTextEdit#logBox {
+  QPlainTextEdit#logBox, QListView#logBox {
     background-color: #05080c;
     color: #7ee8c9;
     border: 1px solid #1e3a2f;
@@ -2,19 +2,28 @@
 #include <QChart>
 #include <QChartView>
 #include <QColor>
+#include <QEvent>
 #include <QLineSeries>
+#include <QTimer>
 #include <QValueAxis>
 #include <QVBoxLayout>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <cmath>
 
 namespace ui {
 
-TelemetryChart::TelemetryChart(QWidget* parent) : QWidget(parent) {
+TelemetryChart::TelemetryChart(QWidget* parent)
+    : QWidget(parent),
+      _seriesPosition(new QLineSeries(this)),
+      _seriesSensor(new QLineSeries(this)),
+      _position(_seriesPosition, kDefaultHistory),
+      _sensor(_seriesSensor, kDefaultHistory) {
   auto* lay = new QVBoxLayout(this);
   lay->setContentsMargins(0, 0, 0, 0);
 
-  _seriesPosition = new QLineSeries(this);
   _seriesPosition->setName(tr("Position"));
-  _seriesSensor = new QLineSeries(this);
   _seriesSensor->setName(tr("Sensor"));
 
   _chart = new QChart();
@@ -33,7 +42,7 @@ TelemetryChart::TelemetryChart(QWidget* parent) : QWidget(parent) {
   _axisX = new QValueAxis();
   _axisX->setLabelFormat("%d");
   _axisX->setTitleText(tr("samples"));
-  _axisX->setRange(0, kWindow - 1);
+  _axisX->setRange(0, kDefaultWindow - 1);
   _axisX->setLabelsColor(QColor(0x5a, 0x9b, 0x8a));
   _axisX->setGridLineColor(QColor(0x1e, 0x3a, 0x2f));
   _axisX->setLinePenColor(QColor(0x1e, 0x3a, 0x2f));
@@ -59,33 +68,90 @@ TelemetryChart::TelemetryChart(QWidget* parent) : QWidget(parent) {
   _chartView->setRenderHint(QPainter::Antialiasing);
   _chartView->setMinimumHeight(240);
   _chartView->setBackgroundBrush(QBrush(QColor(0x0a, 0x0e, 0x14)));
+  _chartView->viewport()->installEventFilter(this);
   lay->addWidget(_chartView);
+
+  _frameTimer = new QTimer(this);
+  connect(_frameTimer, &QTimer::timeout, this, &TelemetryChart::flushFrame);
+  _frameTimer->start(33);
 }
 
 void TelemetryChart::appendSample(double position, double sensorValue) {
-  const int idx = _sampleIndex++;
-  if (_seriesPosition->count() >= kWindow) {
-    _seriesPosition->removePoints(0, _seriesPosition->count() - (kWindow - 1));
-    _seriesSensor->removePoints(0, _seriesSensor->count() - (kWindow - 1));
-  }
-  _seriesPosition->append(idx, position);
-  _seriesSensor->append(idx, sensorValue);
+  _position.append(position);
+  _sensor.append(sensorValue);
+  _dirty = true;
+}
+
+void TelemetryChart::flushFrame() {
+  if (!_dirty) return;
+  _dirty = false;
 
-  const int minX = qMax(0, _sampleIndex - kWindow);
-  _axisX->setRange(minX, minX + kWindow - 1);
+  const std::uint64_t count = _position.count();
+  const std::uint64_t window = static_cast<std::uint64_t>(_window);
+  const std::uint64_t first = count > window ? count - window : 0;
+  int pixels = static_cast<int>(_chart->plotArea().width());
+  if (pixels <= 0) pixels = width();
+  // replace() 发出一次 pointsReplaced，而不是每个点一次 pointAdded/pointsRemoved。
+  _position.render(first, pixels, _decimation);
+  _sensor.render(first, pixels, _decimation);
 
-  const double y = qMax(qAbs(position), qAbs(sensorValue));
-  if (y > 0 && (y < _axisY->min() || y > _axisY->max())) {
+  _axisX->setRange(static_cast<double>(first), static_cast<double>(first + window - 1));
+  double lo = 0.0;
+  double hi = 0.0;
+  double yAbs = 0.0;
+  if (_position.yRange(lo, hi)) yAbs = std::max(yAbs, std::max(std::abs(lo), std::abs(hi)));
+  if (_sensor.yRange(lo, hi)) yAbs = std::max(yAbs, std::max(std::abs(lo), std::abs(hi)));
+  if (yAbs > 0 && (-yAbs < _axisY->min() || yAbs > _axisY->max())) {
     const double pad = 0.2;
-    _axisY->setRange(-y - pad, y + pad);
+    _axisY->setRange(-yAbs - pad, yAbs + pad);
   }
 }
 
 void TelemetryChart::clearChart() {
-  _seriesPosition->clear();
-  _seriesSensor->clear();
-  _sampleIndex = 0;
-  _axisX->setRange(0, kWindow - 1);
+  _position.clear();
+  _sensor.clear();
+  _dirty = false;
+  _axisX->setRange(0, _window - 1);
+}
+
+void TelemetryChart::setWindow(int points) {
+  _window = std::clamp(points, kMinWindow, std::max(kMinWindow, history()));
+  _dirty = true;
+  if (_position.count() == 0) _axisX->setRange(0, _window - 1);
+}
+
+void TelemetryChart::setHistory(int samples) {
+  const auto n = static_cast<std::size_t>(std::max(samples, kMinWindow));
+  _position.setHistory(n);
+  _sensor.setHistory(n);
+  setWindow(_window);
+  clearChart();
+}
+
+void TelemetryChart::setDecimation(Decimation mode) {
+  _decimation = mode;
+  _dirty = true;
+}
+
+void TelemetryChart::setFrameInterval(int ms) {
+  if (ms > 0) {
+    _frameTimer->start(ms);
+  } else {
+    _frameTimer->stop();
+  }
+}
+
+bool TelemetryChart::eventFilter(QObject* watched, QEvent* event) {
+  if (watched == _chartView->viewport() && event->type() == QEvent::Wheel) {
+    const int notches = static_cast<QWheelEvent*>(event)->angleDelta().y() / 120;
+    if (notches != 0) {
+      // 向上滚放大（窗口变小），向下滚缩小到更长的历史。
+      setWindow(static_cast<int>(std::lround(_window * std::pow(1.25, -notches))));
+      flushFrame();
+    }
+    return true;
+  }
+  return QWidget::eventFilter(watched, event);
 }
 
 } // namespace ui
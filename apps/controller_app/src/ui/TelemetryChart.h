@@ -1,25 +1,55 @@
 #pragma once
 
+#include "DecimatedSeries.h"
+
 #include <QChartView>
+#include <QList>
+#include <QPointF>
 #include <QWidget>
 
 class QChart;
 class QLineSeries;
+class QTimer;
 class QValueAxis;
 
 namespace ui {
 
-/** 遥测图表层：Position + Sensor 曲线，深色主题。 */
+/**
+ * 遥测图表层：Position + Sensor 曲线，深色主题。
+ * 采样先进入 DecimatedSeries（min/max 金字塔），每帧（帧定时器或 flushFrame()）按绘图区像素宽度抽样，
+ * 对每条曲线做一次 replace()，坐标轴也每帧只更新一次。滚轮缩放显示窗口，最大可看完整历史。
+ */
 class TelemetryChart : public QWidget {
   Q_OBJECT
 public:
+  /** 最小显示窗口（采样点数），setWindow() 会把更小的值提高到这里。 */
+  static constexpr int kMinWindow = 64;
+
   explicit TelemetryChart(QWidget* parent = nullptr);
 
-  /** 追加一帧数据并刷新曲线。 */
+  /** 追加一个采样，下一帧显示。 */
   void appendSample(double position, double sensorValue);
   /** 清空曲线（停止时）。 */
   void clearChart();
 
+  /** 显示的采样点数（窗口），不超过历史长度。 */
+  void setWindow(int points);
+  int window() const { return _window; }
+  /** 保留的历史采样数（缩放上限），会清空曲线。 */
+  void setHistory(int samples);
+  int history() const { return static_cast<int>(_position.history()); }
+  void setDecimation(Decimation mode);
+  /** 帧定时器间隔（ms）；0 表示不自动刷新，由调用方每帧调用 flushFrame()。 */
+  void setFrameInterval(int ms);
+
+public slots:
+  /** 有新采样时把环形缓冲写入曲线并调整坐标轴。 */
+  void flushFrame();
+
+protected:
+  /** 绘图区上的滚轮：每格把窗口缩放 1.25 倍。 */
+  bool eventFilter(QObject* watched, QEvent* event) override;
+
 private:
   QChart* _chart{nullptr};
   QChartView* _chartView{nullptr};
@@ -27,8 +57,14 @@ class TelemetryChart : public QWidget {
   QLineSeries* _seriesSensor{nullptr};
   QValueAxis* _axisX{nullptr};
   QValueAxis* _axisY{nullptr};
-  int _sampleIndex{0};
-  static constexpr int kWindow = 300;
+  QTimer* _frameTimer{nullptr};
+  DecimatedSeries _position;
+  DecimatedSeries _sensor;
+  Decimation _decimation{Decimation::MinMax};
+  int _window{kDefaultWindow};
+  bool _dirty{false};
+  static constexpr int kDefaultWindow = 300;
+  static constexpr int kDefaultHistory = 1 << 18;
 };
 
 } // namespace ui
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "AllocCounter.h"
+#include "Percentile.h"
+#include "common/config/Config.h"
+#include "common/rt/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stress {
+
+// Shared with Config::getIntList and ui_bench.
+using common::config::ParseIntList;
+using common::config::ParseList;
+
+/** "12.3": nanoseconds as microseconds, one decimal. */
+inline std::string Us(std::uint64_t ns) {
+  return common::rt::FormatUs(ns);
+}
+
+/** "12.3": one decimal, rounded half up (non-negative values). */
+inline std::string Fixed1(double v) {
+  const auto tenths = static_cast<long long>(v * 10.0 + 0.5);
+  return std::to_string(tenths / 10) + "." + std::to_string(tenths % 10);
+}
+
+// Shared with ui_bench (bench_support).
+using bench::Percentile;
+using bench::ThreadAllocations;
+
+} // namespace stress
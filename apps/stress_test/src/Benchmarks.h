@@ -0,0 +1,48 @@
+#pragma once
+
+namespace common::config {
+class Config;
+}
+
+namespace stress {
+
+/** Snapshot channel variants (mutex / seqlock / triple buffer): read throughput and writer latency vs reader count. */
+int RunChannelBench(const common::config::Config& cfg);
+
+/** Multi-channel SensorFrameRing: simulator, publish and zero-copy read cost vs channel count. */
+int RunSensorChannelsBench(const common::config::Config& cfg);
+
+/** SensorHistory: correctness check, push cost and concurrent sinceSeq()/stats() query cost. */
+int RunHistoryBench(const common::config::Config& cfg);
+
+/** FilterChain: vectorized stage vs scalar reference, ns per sample and share of a 1/10 kHz period. */
+int RunFilterBench(const common::config::Config& cfg);
+
+/** SensorSimulator: legacy per-sample path vs lane-parallel generate()/generateBatch(), determinism and signal check. */
+int RunSimulatorBench(const common::config::Config& cfg);
+
+/** PeriodicTimer modes (sleep / hybrid / spin): wake-up jitter histogram and CPU cost per loop rate ([rt.timer] applies). */
+int RunTimerBench(const common::config::Config& cfg);
+
+/** SeqNotifier vs 1 ms sequence polling: publish-to-consumer latency and wakeups per sample. */
+int RunWakeupBench(const common::config::Config& cfg);
+
+/** StatusStore: per-field metrics vs whole-snapshot read-modify-write, update cost and lost updates under a second writer. */
+int RunStatusBench(const common::config::Config& cfg);
+
+/** Span tracing: per-span cost compiled in but disabled vs enabled, against an empty loop body. */
+int RunSpanBench(const common::config::Config& cfg);
+
+/** Logging: per-call cost on the caller thread, synchronous vs async (drop / block on overflow), drain time and drops. */
+int RunLogBench(const common::config::Config& cfg);
+
+/** Level-checked MRCD_LOG_* macros vs eager string building: cost and heap allocations per call, disabled and enabled. */
+int RunLogLevelBench(const common::config::Config& cfg);
+
+/** Binary log: records/s and bytes per thread count under a bandwidth cap, then a full decode check. */
+int RunBinaryLogBench(const common::config::Config& cfg);
+
+/** File log rotation: per-call latency percentiles and worst case, plain file vs rotating segments with gzip and retention. */
+int RunLogRotateBench(const common::config::Config& cfg);
+
+} // namespace stress
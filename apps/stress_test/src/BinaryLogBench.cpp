@@ -0,0 +1,104 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/BinaryLog.h"
+#include "common/log/BinaryLogReader.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+void ClearSegments(const std::string& dir) {
+  try {
+    Poco::File d(dir);
+    if (!d.exists()) return;
+    std::vector<std::string> names;
+    d.list(names);
+    for (const auto& n : names) Poco::File(Poco::Path(dir).append(n).toString()).remove();
+  } catch (const Poco::Exception& e) {
+    common::log::Warn("main", "binlog bench: cannot clear " + dir + ": " + e.displayText());
+  }
+}
+
+} // namespace
+
+int RunBinaryLogBench(const common::config::Config& cfg) {
+  const int threads = std::max(1, cfg.getInt("stress_test.binlog_threads", 4));
+  const int records = std::max(1000, cfg.getInt("stress_test.binlog_records", 1000000));
+  const auto capsMBps = ParseIntList(cfg.getString("stress_test.binlog_mb_per_s", "4096,16"));
+
+  auto params = common::log::binary::LoadBinaryLogParams(cfg);
+  params.enabled = true;
+  params.dir = cfg.getString("stress_test.binlog_dir", "stress_binlog");
+  // Keep every segment so the decode check sees all records.
+  params.maxSegments = 1u << 20;
+
+  common::log::Info("main", "binlog bench: threads=" + std::to_string(threads) + " records_per_thread=" +
+                                std::to_string(records) + " segment_kb=" + std::to_string(params.segmentBytes / 1024) +
+                                " dir=" + params.dir);
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const int cap : capsMBps) {
+    params.maxMBps = std::max(1, cap);
+    ClearSegments(params.dir);
+    common::log::binary::StartBinaryLog(params, "stress_test");
+
+    const auto t0 = common::time::NowMonotonicNs();
+    // Longest gap between two records of one thread: the worst stall a call (a segment roll included) caused.
+    std::vector<std::uint64_t> maxGapNs(static_cast<std::size_t>(threads), 0);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+      pool.emplace_back([&, t] {
+        common::log::SetThreadName("blog_" + std::to_string(t));
+        std::uint64_t prev = common::time::NowMonotonicNs();
+        std::uint64_t maxGap = 0;
+        for (int i = 0; i < records; ++i) {
+          const auto now = common::time::NowMonotonicNs();
+          MRCD_BLOG("bench", "seq={} since_prev_ns={} ok={}", static_cast<std::uint64_t>(i), now - prev, (i & 7) != 0);
+          maxGap = std::max(maxGap, now - prev);
+          prev = now;
+        }
+        maxGapNs[static_cast<std::size_t>(t)] = maxGap;
+        // binlog_io trims and unmaps the thread's last segment once it exits.
+      });
+    }
+    for (auto& th : pool) th.join();
+    const auto elapsedNs = common::time::NowMonotonicNs() - t0;
+    common::log::binary::StopBinaryLog();
+    const auto stats = common::log::binary::GetBinaryLogStats();
+
+    common::log::binary::BinaryLogReader reader;
+    std::size_t decoded = 0;
+    if (reader.add(params.dir)) {
+      decoded = reader.records().size();
+    } else {
+      common::log::Warn("main", "binlog bench: decode failed: " + reader.error());
+    }
+    if (decoded != stats.records || reader.unknownFormats() != 0) ++failures;
+
+    const double seconds = static_cast<double>(elapsedNs) / 1e9;
+    const double attempted = static_cast<double>(threads) * records;
+    const double mb = static_cast<double>(stats.bytes) / (1024.0 * 1024.0);
+    results.push_back(std::to_string(cap) + " " + Fixed1(attempted / seconds / 1e6) + " " + std::to_string(stats.records) +
+                      " " + std::to_string(stats.dropped) + " " + Fixed1(mb) + " " + Fixed1(mb / seconds) + " " +
+                      Us(*std::max_element(maxGapNs.begin(), maxGapNs.end())) + " " + std::to_string(decoded));
+  }
+
+  common::log::Info("main", "cap_mb_per_s mrecords_per_s written dropped mb mb_per_s max_gap_us decoded");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace stress
@@ -0,0 +1,172 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/SnapshotChannel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+/** Roughly SensorSnapshot-sized; every field carries seq so torn reads are detectable. */
+struct Payload {
+  std::uint64_t seq{0};
+  double value{0.0};
+  std::uint64_t check[6]{};
+};
+
+struct CaseResult {
+  std::uint64_t produced{0};
+  std::uint64_t publishCount{0};
+  std::uint64_t reads{0};
+  std::uint64_t monotonicViolations{0};
+  std::uint64_t tornReads{0};
+  std::uint64_t writerP50Ns{0};
+  std::uint64_t writerP99Ns{0};
+  std::uint64_t writerMaxNs{0};
+};
+
+template <common::rt::ChannelKind Kind>
+CaseResult RunCase(int readers, std::chrono::milliseconds duration, std::chrono::microseconds publishInterval) {
+  common::rt::SnapshotChannel<Payload, Kind> ch;
+
+  std::atomic<bool> running{true};
+  std::atomic<std::uint64_t> produced{0};
+  std::atomic<std::uint64_t> reads{0};
+  std::atomic<std::uint64_t> violations{0};
+  std::atomic<std::uint64_t> torn{0};
+
+  constexpr std::size_t kMaxLatencySamples = 1u << 20;
+  std::vector<std::uint64_t> writerNs;
+  writerNs.reserve(kMaxLatencySamples);
+
+  std::thread producer([&]() {
+    common::log::SetThreadName("producer");
+    std::uint64_t seq = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      const auto t0 = std::chrono::steady_clock::now();
+      auto& back = ch.back();
+      back.seq = ++seq;
+      back.value = static_cast<double>(seq);
+      for (auto& c : back.check) c = seq;
+      ch.publishSwap();
+      const auto t1 = std::chrono::steady_clock::now();
+      if (writerNs.size() < kMaxLatencySamples) {
+        writerNs.push_back(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+      }
+      produced.store(seq, std::memory_order_relaxed);
+      if (publishInterval.count() > 0) std::this_thread::sleep_for(publishInterval);
+    }
+  });
+
+  std::vector<std::thread> consumers;
+  consumers.reserve(static_cast<std::size_t>(readers));
+  for (int i = 0; i < readers; ++i) {
+    consumers.emplace_back([&, i]() {
+      common::log::SetThreadName("consumer" + std::to_string(i + 1));
+      std::uint64_t last = 0;
+      std::uint64_t localReads = 0;
+      std::uint64_t localViolations = 0;
+      std::uint64_t localTorn = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        const auto snap = ch.readSnapshot();
+        if (snap.seq > 0 && snap.seq < last) ++localViolations; // Ignore first read
+        for (const auto c : snap.check) {
+          if (c != snap.seq) {
+            ++localTorn;
+            break;
+          }
+        }
+        last = snap.seq;
+        ++localReads;
+      }
+      reads.fetch_add(localReads);
+      violations.fetch_add(localViolations);
+      torn.fetch_add(localTorn);
+    });
+  }
+
+  std::this_thread::sleep_for(duration);
+  running.store(false);
+  producer.join();
+  for (auto& c : consumers) c.join();
+
+  CaseResult r;
+  r.produced = produced.load();
+  r.publishCount = ch.publishCount();
+  r.reads = reads.load();
+  r.monotonicViolations = violations.load();
+  r.tornReads = torn.load();
+  r.writerP50Ns = Percentile(writerNs, 0.50);
+  r.writerP99Ns = Percentile(writerNs, 0.99);
+  r.writerMaxNs = writerNs.empty() ? 0 : writerNs.back();
+  return r;
+}
+
+CaseResult RunCase(common::rt::ChannelKind kind, int readers, std::chrono::milliseconds duration,
+                   std::chrono::microseconds publishInterval) {
+  switch (kind) {
+    case common::rt::ChannelKind::Mutex:
+      return RunCase<common::rt::ChannelKind::Mutex>(readers, duration, publishInterval);
+    case common::rt::ChannelKind::Seqlock:
+      return RunCase<common::rt::ChannelKind::Seqlock>(readers, duration, publishInterval);
+    case common::rt::ChannelKind::TripleBuffer:
+      return RunCase<common::rt::ChannelKind::TripleBuffer>(readers, duration, publishInterval);
+  }
+  return {};
+}
+
+bool ParseKind(const std::string& name, common::rt::ChannelKind& out) {
+  for (auto k : {common::rt::ChannelKind::Mutex, common::rt::ChannelKind::Seqlock, common::rt::ChannelKind::TripleBuffer}) {
+    if (name == common::rt::ToString(k)) {
+      out = k;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+int RunChannelBench(const common::config::Config& cfg) {
+  const auto variants = ParseList(cfg.getString("stress_test.variants", "mutex,seqlock,triple"));
+  const auto readerCounts = ParseIntList(cfg.getString("stress_test.readers", "1,2,4,8,16"));
+  const std::chrono::milliseconds duration(cfg.getInt("stress_test.case_duration_ms", 2000));
+  const std::chrono::microseconds publishInterval(cfg.getInt("stress_test.publish_interval_us", 1000));
+
+  common::log::Info("main", "channel bench: case=" + std::to_string(duration.count()) + "ms publish_interval=" +
+                                std::to_string(publishInterval.count()) + "us");
+  common::log::Info("main", "variant readers reads/s produced violations torn writer_p50_ns writer_p99_ns writer_max_ns");
+
+  int failures = 0;
+  for (const auto& name : variants) {
+    common::rt::ChannelKind kind;
+    if (!ParseKind(name, kind)) {
+      common::log::Warn("main", "unknown channel variant: " + name);
+      continue;
+    }
+    for (const int readers : readerCounts) {
+      if (readers <= 0) continue;
+      const auto r = RunCase(kind, readers, duration, publishInterval);
+      const double seconds = static_cast<double>(duration.count()) / 1000.0;
+      const auto readsPerSec = static_cast<std::uint64_t>(static_cast<double>(r.reads) / seconds);
+      common::log::Info("main", std::string(common::rt::ToString(kind)) + " " + std::to_string(readers) + " " +
+                                    std::to_string(readsPerSec) + " " + std::to_string(r.produced) + " " +
+                                    std::to_string(r.monotonicViolations) + " " + std::to_string(r.tornReads) + " " +
+                                    std::to_string(r.writerP50Ns) + " " + std::to_string(r.writerP99Ns) + " " +
+                                    std::to_string(r.writerMaxNs));
+      if (r.monotonicViolations > 0 || r.tornReads > 0 || r.publishCount != r.produced) ++failures;
+    }
+  }
+  return failures;
+}
+
+} // namespace stress
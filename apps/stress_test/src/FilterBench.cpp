@@ -0,0 +1,150 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/AlignedBuffer.h"
+#include "common/sensor/FilterChain.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::size_t PaddedStride(std::size_t channels) { return (channels + 7) / 8 * 8; }
+
+double Input(std::size_t ch, std::uint64_t n) {
+  return std::sin(0.01 * static_cast<double>(n) + 0.3 * static_cast<double>(ch)) + 0.1 * static_cast<double>((n * 7 + ch) % 5);
+}
+
+/** Straightforward scalar implementation of one channel's chain, used as the reference. */
+class ScalarChain {
+public:
+  explicit ScalarChain(common::sensor::FilterChainSpec spec) : _spec(std::move(spec)), _state(_spec.size()) {}
+
+  double process(double x) {
+    for (std::size_t i = 0; i < _spec.size(); ++i) {
+      const auto& s = _spec[i];
+      auto& st = _state[i];
+      switch (s.kind) {
+        case common::sensor::FilterSpec::Kind::MovingAverage: {
+          st.hist.push_back(x);
+          if (st.hist.size() > s.window) st.hist.pop_front();
+          double sum = 0.0;
+          for (const double v : st.hist) sum += v;
+          x = sum / static_cast<double>(st.hist.size());
+          break;
+        }
+        case common::sensor::FilterSpec::Kind::Biquad: {
+          const double y = s.biquad[0] * x + st.z1;
+          st.z1 = s.biquad[1] * x - s.biquad[3] * y + st.z2;
+          st.z2 = s.biquad[2] * x - s.biquad[4] * y;
+          x = y;
+          break;
+        }
+        case common::sensor::FilterSpec::Kind::Fir: {
+          st.hist.push_front(x);
+          if (st.hist.size() > s.taps.size()) st.hist.pop_back();
+          double acc = 0.0;
+          for (std::size_t k = 0; k < st.hist.size(); ++k) acc += s.taps[k] * st.hist[k];
+          x = acc;
+          break;
+        }
+      }
+    }
+    return x;
+  }
+
+private:
+  struct State {
+    std::deque<double> hist;
+    double z1{0.0};
+    double z2{0.0};
+  };
+  common::sensor::FilterChainSpec _spec;
+  std::vector<State> _state;
+};
+
+int VerifyAgainstScalar(const std::vector<common::sensor::FilterChainSpec>& chains, std::size_t channels) {
+  const std::size_t stride = PaddedStride(channels);
+  common::sensor::FilterChain chain(channels, stride, chains);
+  std::vector<ScalarChain> ref;
+  for (std::size_t ch = 0; ch < channels; ++ch) ref.emplace_back(chains[ch]);
+
+  common::rt::AlignedBuffer<double> frame(stride);
+  double maxErr = 0.0;
+  for (std::uint64_t n = 0; n < 5000; ++n) {
+    for (std::size_t ch = 0; ch < channels; ++ch) frame[ch] = Input(ch, n);
+    chain.process(frame.data());
+    for (std::size_t ch = 0; ch < channels; ++ch) {
+      maxErr = std::max(maxErr, std::abs(frame[ch] - ref[ch].process(Input(ch, n))));
+    }
+  }
+  common::log::Info("main", "filter verify: " + chain.describe() + " max_abs_err=" + std::to_string(maxErr));
+  return maxErr < 1e-9 ? 0 : 1;
+}
+
+} // namespace
+
+int RunFilterBench(const common::config::Config& cfg) {
+  const auto channelCounts = ParseIntList(cfg.getString("stress_test.channels", "3,16,64,256,1024,4096"));
+  const int iterations = std::max(1, cfg.getInt("stress_test.iterations", 20000));
+  const double designRateHz = 1000.0;
+  const std::string chainText = cfg.getString("stress_test.filter_chain", "ma:8|biquad_lp:50:0.707|fir:0.1,0.2,0.4,0.2,0.1");
+
+  common::sensor::FilterChainSpec spec;
+  std::string error;
+  if (!common::sensor::ParseFilterChain(chainText, designRateHz, spec, error)) {
+    common::log::Error("main", "bad stress_test.filter_chain: " + error);
+    return 1;
+  }
+
+  // Mixed per-channel chains exercise identity lanes; the uniform chain is what gets timed.
+  int failures = 0;
+  {
+    const std::size_t channels = 13;
+    std::vector<common::sensor::FilterChainSpec> mixed(channels, spec);
+    std::string err;
+    common::sensor::ParseFilterChain("fir:0.5,0.5", designRateHz, mixed[1], err);
+    common::sensor::ParseFilterChain("ma:3|biquad_hp:5:0.9", designRateHz, mixed[4], err);
+    mixed[7].clear();
+    failures += VerifyAgainstScalar(mixed, channels);
+  }
+
+  common::log::Info("main", "filters bench: chain=" + chainText + " iterations=" + std::to_string(iterations));
+  common::log::Info("main", "channels ns_per_sample pct_period_1kHz pct_period_10kHz");
+
+  volatile double sink = 0.0;
+  for (const int n : channelCounts) {
+    if (n <= 0) continue;
+    const auto channels = static_cast<std::size_t>(n);
+    const std::size_t stride = PaddedStride(channels);
+    common::sensor::FilterChain chain(channels, stride, std::vector<common::sensor::FilterChainSpec>(channels, spec));
+    common::rt::AlignedBuffer<double> frame(stride);
+    for (std::size_t ch = 0; ch < channels; ++ch) frame[ch] = Input(ch, 0);
+
+    const auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      frame[0] = static_cast<double>(i & 7);
+      chain.process(frame.data());
+    }
+    const auto t1 = Clock::now();
+    sink = sink + frame[channels - 1];
+
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+                      static_cast<double>(iterations);
+    common::log::Info("main", std::to_string(channels) + " " + std::to_string(static_cast<std::uint64_t>(ns)) + " " +
+                                  std::to_string(ns / 1e6 * 100.0) + " " + std::to_string(ns / 1e5 * 100.0));
+  }
+  return failures;
+}
+
+} // namespace stress
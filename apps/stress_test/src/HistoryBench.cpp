@@ -0,0 +1,159 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/sensor/SensorHistory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+common::sensor::SensorSample MakeSample(std::uint64_t seq) {
+  common::sensor::SensorSample s;
+  s.seq = seq;
+  s.monotonicNs = seq * 1000;
+  const double t = static_cast<double>(seq);
+  s.valueA = std::sin(t * 0.01);
+  s.valueB = std::cos(t * 0.003);
+  s.valueC = static_cast<double>(seq % 97) / 97.0;
+  return s;
+}
+
+/** Single-threaded check of window stats and span queries against brute force. */
+int VerifyHistory(std::size_t capacity, const std::vector<std::size_t>& windows, std::uint64_t pushes) {
+  common::sensor::SensorHistory h(capacity, windows);
+  for (std::uint64_t seq = 1; seq <= pushes; ++seq) h.push(MakeSample(seq));
+
+  int errors = 0;
+  const auto st = h.stats();
+  for (std::uint32_t i = 0; i < st.windowCount; ++i) {
+    const auto& w = st.windows[i];
+    double mn = 1e300, mx = -1e300, sum = 0.0;
+    for (std::uint64_t seq = pushes - w.filled + 1; seq <= pushes; ++seq) {
+      const double v = MakeSample(seq).valueA;
+      mn = std::min(mn, v);
+      mx = std::max(mx, v);
+      sum += v;
+    }
+    if (w.a.min != mn || w.a.max != mx || std::abs(w.a.mean - sum / w.filled) > 1e-6) ++errors;
+  }
+
+  const std::uint64_t from = pushes - h.capacity() / 2;
+  const auto span = h.sinceSeq(from);
+  std::uint64_t expect = from;
+  span.forEach([&](const common::sensor::SensorSample& s) {
+    if (s.seq != expect++) ++errors;
+  });
+  if (expect != pushes + 1 || span.truncated || !span.valid()) ++errors;
+
+  if (pushes > h.capacity() && !h.sinceSeq(1).truncated) ++errors;
+
+  const auto timed = h.between(MakeSample(from).monotonicNs, MakeSample(from + 9).monotonicNs);
+  if (timed.size() != 10 || timed[0].seq != from) ++errors;
+
+  double a = 0.0, b = 0.0, c = 0.0;
+  if (!h.rangeMean(from, from + 99, a, b, c)) ++errors;
+  double sum = 0.0;
+  for (std::uint64_t seq = from; seq < from + 100; ++seq) sum += MakeSample(seq).valueA;
+  if (std::abs(a - sum / 100.0) > 1e-6) ++errors;
+  return errors;
+}
+
+} // namespace
+
+int RunHistoryBench(const common::config::Config& cfg) {
+  const auto capacity = static_cast<std::size_t>(std::max(2, cfg.getInt("stress_test.history_capacity", 4096)));
+  std::vector<std::size_t> windows;
+  for (const int w : ParseIntList(cfg.getString("stress_test.stat_windows", "20,200,2000"))) {
+    if (w > 0) windows.push_back(static_cast<std::size_t>(w));
+  }
+  const std::chrono::milliseconds duration(cfg.getInt("stress_test.case_duration_ms", 2000));
+  const std::chrono::microseconds publishInterval(cfg.getInt("stress_test.publish_interval_us", 100));
+
+  int failures = VerifyHistory(capacity, windows, capacity * 3 + 7);
+  common::log::Info("main", "history verify errors: " + std::to_string(failures));
+
+  common::sensor::SensorHistory history(capacity, windows);
+  std::atomic<bool> running{true};
+  std::vector<std::uint64_t> pushNs;
+  pushNs.reserve(1u << 20);
+
+  std::thread writer([&]() {
+    common::log::SetThreadName("producer");
+    std::uint64_t seq = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      const auto s = MakeSample(++seq);
+      const auto t0 = Clock::now();
+      history.push(s);
+      const auto t1 = Clock::now();
+      if (pushNs.size() < pushNs.capacity()) {
+        pushNs.push_back(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+      }
+      if (publishInterval.count() > 0) std::this_thread::sleep_for(publishInterval);
+    }
+  });
+
+  std::uint64_t queries = 0, samplesSeen = 0, gaps = 0, truncated = 0, invalid = 0, statsReads = 0;
+  std::vector<std::uint64_t> queryNs;
+  queryNs.reserve(1u << 20);
+  std::thread reader([&]() {
+    common::log::SetThreadName("consumer1");
+    std::uint64_t next = 1;
+    while (running.load(std::memory_order_relaxed)) {
+      const auto t0 = Clock::now();
+      const auto span = history.sinceSeq(next);
+      std::uint64_t expect = span.empty() ? next : span[0].seq;
+      bool ordered = true;
+      span.forEach([&](const common::sensor::SensorSample& s) {
+        if (s.seq != expect++) ordered = false;
+      });
+      const bool ok = span.valid();
+      const auto t1 = Clock::now();
+      (void)history.stats();
+      ++statsReads;
+      if (queryNs.size() < queryNs.capacity()) {
+        queryNs.push_back(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+      }
+      ++queries;
+      if (!ok) {
+        ++invalid;
+        continue;
+      }
+      if (span.truncated) ++truncated;
+      if (!ordered) ++gaps;
+      samplesSeen += span.size();
+      if (!span.empty()) next = span[span.size() - 1].seq + 1;
+    }
+  });
+
+  std::this_thread::sleep_for(duration);
+  running.store(false);
+  writer.join();
+  reader.join();
+
+  common::log::Info("main", "history bench: capacity=" + std::to_string(history.capacity()) +
+                                " windows=" + std::to_string(windows.size()) + " pushed=" + std::to_string(history.count()));
+  common::log::Info("main", "push_p50_ns=" + std::to_string(Percentile(pushNs, 0.5)) +
+                                " push_p99_ns=" + std::to_string(Percentile(pushNs, 0.99)) +
+                                " query_p50_ns=" + std::to_string(Percentile(queryNs, 0.5)) +
+                                " query_p99_ns=" + std::to_string(Percentile(queryNs, 0.99)));
+  common::log::Info("main", "queries=" + std::to_string(queries) + " samples_seen=" + std::to_string(samplesSeen) +
+                                " truncated=" + std::to_string(truncated) + " invalid=" + std::to_string(invalid) +
+                                " out_of_order=" + std::to_string(gaps) + " stats_reads=" + std::to_string(statsReads));
+  if (gaps > 0) ++failures;
+  return failures;
+}
+
+} // namespace stress
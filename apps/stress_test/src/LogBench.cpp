@@ -0,0 +1,98 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/LatencyHistogram.h"
+#include "common/time/MonotonicClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+int RunLogBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("stress_test.log_modes", "sync,async_drop,async_block"));
+  const int threads = std::max(1, cfg.getInt("stress_test.log_threads", 4));
+  const int calls = std::max(100, cfg.getInt("stress_test.log_calls", 20000));
+  const auto queueRecords = static_cast<std::size_t>(std::max(64, cfg.getInt("stress_test.log_queue_records", 8192)));
+
+  const common::log::Output restore = common::log::LoadOutput(cfg);
+  const common::log::AsyncParams restoreAsync = common::log::LoadAsyncParams(cfg);
+
+  common::log::Output benchOut = restore;
+  benchOut.channel = cfg.getString("stress_test.log_channel", "file");
+  benchOut.file = cfg.getString("stress_test.log_file", "stress_log.txt");
+
+  common::log::Info("main", "log bench: threads=" + std::to_string(threads) + " calls_per_thread=" + std::to_string(calls) +
+                                " queue_records=" + std::to_string(queueRecords) + " output=" + benchOut.channel +
+                                (benchOut.channel == "file" ? ":" + benchOut.file : ""));
+
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const auto& mode : modes) {
+    common::log::AsyncParams async;
+    async.capacity = queueRecords;
+    if (mode == "async_drop") {
+      async.enabled = true;
+    } else if (mode == "async_block") {
+      async.enabled = true;
+      async.overflow = common::log::OverflowPolicy::Block;
+    } else if (mode != "sync") {
+      results.push_back("unknown mode " + mode);
+      ++failures;
+      continue;
+    }
+
+    common::log::StopAsync();
+    common::log::SetOutput(benchOut);
+    common::log::StartAsync(async);
+
+    // One histogram per thread: LatencyHistogram has a single writer.
+    std::vector<common::rt::LatencyHistogram> cost(static_cast<std::size_t>(threads));
+    std::atomic<std::uint64_t> totalNs{0};
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+      pool.emplace_back([&, t] {
+        common::log::SetThreadName("bench_" + std::to_string(t));
+        std::uint64_t sum = 0;
+        for (int i = 0; i < calls; ++i) {
+          // Built outside the timed region: this measures the log call itself.
+          const std::string msg = "cycle=" + std::to_string(i) + " value=" + std::to_string(i * 0.001) + " state=ok";
+          const auto a = common::time::NowMonotonicNs();
+          common::log::Info("bench", msg);
+          const auto d = common::time::NowMonotonicNs() - a;
+          cost[static_cast<std::size_t>(t)].record(d);
+          sum += d;
+        }
+        totalNs.fetch_add(sum);
+      });
+    }
+    for (auto& th : pool) th.join();
+
+    const auto f0 = common::time::NowMonotonicNs();
+    common::log::Flush();
+    const auto drainNs = common::time::NowMonotonicNs() - f0;
+    const auto stats = common::log::GetAsyncStats();
+    common::log::StopAsync();
+
+    common::rt::LatencySnapshot s;
+    for (const auto& c : cost) s.merge(c.snapshot());
+    const double nsPerCall = static_cast<double>(totalNs.load()) / (static_cast<double>(threads) * calls);
+    results.push_back(mode + " " + Fixed1(nsPerCall) + " " + Us(s.percentileNs(0.99)) + " " + Us(s.maxNs) + " " +
+                      Fixed1(static_cast<double>(drainNs) / 1e6) + " " + std::to_string(stats.dropped) + " " +
+                      std::to_string(stats.spilled));
+    if (async.enabled && async.overflow == common::log::OverflowPolicy::Block && stats.dropped != 0) ++failures;
+  }
+
+  common::log::SetOutput(restore);
+  common::log::StartAsync(restoreAsync);
+  common::log::Info("main", "mode ns_per_call p99_us max_us drain_ms dropped spilled");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace stress
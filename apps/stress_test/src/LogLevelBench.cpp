@@ -0,0 +1,121 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/log/LogMacros.h"
+#include "common/time/MonotonicClock.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+std::string Fixed2(double v) {
+  const auto hundredths = static_cast<long long>(v * 100.0 + 0.5);
+  const auto frac = hundredths % 100;
+  return std::to_string(hundredths / 100) + (frac < 10 ? ".0" : ".") + std::to_string(frac);
+}
+
+struct CaseResult {
+  double nsPerCall{0.0};
+  double allocsPerCall{0.0};
+};
+
+/** Runs body(i) calls times on this thread; the state mimics ControllerRuntime's per-tick Debug line. */
+template <typename Body>
+CaseResult Measure(int calls, Body&& body) {
+  const auto a0 = ThreadAllocations();
+  const auto t0 = common::time::NowMonotonicNs();
+  for (int i = 0; i < calls; ++i) body(i);
+  const auto t1 = common::time::NowMonotonicNs();
+  const auto a1 = ThreadAllocations();
+  return CaseResult{static_cast<double>(t1 - t0) / calls, static_cast<double>(a1 - a0) / calls};
+}
+
+void EagerLine(int i) {
+  const bool hbOk = (i & 1) != 0;
+  const bool inGrace = false;
+  const bool hasBeenHealthy = true;
+  const std::uint32_t consecutiveUnhealthy = static_cast<std::uint32_t>(i & 3);
+  common::log::Debug("controller", "hbOk=" + std::string(hbOk ? "true" : "false") +
+                                       " inGrace=" + std::string(inGrace ? "true" : "false") +
+                                       " hasBeenHealthy=" + std::string(hasBeenHealthy ? "true" : "false") +
+                                       " consecutiveUnhealthy=" + std::to_string(consecutiveUnhealthy));
+}
+
+void LazyLine(int i) {
+  const bool hbOk = (i & 1) != 0;
+  const bool inGrace = false;
+  const bool hasBeenHealthy = true;
+  const std::uint32_t consecutiveUnhealthy = static_cast<std::uint32_t>(i & 3);
+  MRCD_LOG_DEBUG("controller", "hbOk=", hbOk, " inGrace=", inGrace, " hasBeenHealthy=", hasBeenHealthy,
+                 " consecutiveUnhealthy=", consecutiveUnhealthy);
+}
+
+} // namespace
+
+int RunLogLevelBench(const common::config::Config& cfg) {
+  const int calls = std::max(1000, cfg.getInt("stress_test.log_calls", 20000));
+  const int lineHz = std::max(1, cfg.getInt("stress_test.log_line_hz", 10));
+
+  common::log::Output restore;
+  restore.pattern = cfg.getString("logging.pattern", restore.pattern);
+  restore.channel = cfg.getString("logging.channel", restore.channel);
+  restore.file = cfg.getString("logging.file", restore.file);
+  const common::log::AsyncParams restoreAsync = common::log::LoadAsyncParams(cfg);
+  const auto restoreLevel = common::log::LevelFromString(cfg.getString("logging.level", "information"));
+
+#if defined(MRCD_LOG_STRIP_DEBUG)
+  common::log::Info("main", "log level bench: built with MRCD_LOG_STRIP_DEBUG, MRCD_LOG_DEBUG compiles to nothing");
+#endif
+  common::log::Info("main", "log level bench: calls=" + std::to_string(calls) +
+                                " (the ControllerRuntime per-tick Debug line, eager string vs MRCD_LOG_DEBUG)");
+  const std::string mainThreadName = common::log::CurrentThreadName();
+  common::log::SetThreadName("bench");
+
+  // Enabled cases write to a null channel through the async queue, so only the caller-side cost is measured.
+  common::log::Output nullOut = restore;
+  nullOut.channel = "null";
+  common::log::AsyncParams async;
+  async.enabled = true;
+  async.overflow = common::log::OverflowPolicy::Block;
+
+  std::vector<std::pair<std::string, CaseResult>> results;
+  common::log::SetLevel(common::log::Level::Info);
+  results.emplace_back("eager_disabled", Measure(calls, EagerLine));
+  results.emplace_back("lazy_disabled", Measure(calls, LazyLine));
+
+  common::log::SetOutput(nullOut);
+  common::log::StartAsync(async);
+  common::log::SetLevel(common::log::Level::Debug);
+  results.emplace_back("eager_enabled", Measure(calls, EagerLine));
+  results.emplace_back("lazy_enabled", Measure(calls, LazyLine));
+  common::log::Flush();
+
+  common::log::SetLevel(restoreLevel);
+  common::log::StopAsync();
+  common::log::SetOutput(restore);
+  common::log::StartAsync(restoreAsync);
+  common::log::SetThreadName(mainThreadName);
+
+  common::log::Info("main", "mode ns_per_call allocs_per_call");
+  for (const auto& [mode, r] : results) common::log::Info("main", mode + " " + Fixed1(r.nsPerCall) + " " + Fixed2(r.allocsPerCall));
+
+  const double avoided = results[0].second.allocsPerCall - results[1].second.allocsPerCall;
+  common::log::Info("main", "disabled Debug line: " + Fixed2(avoided) + " allocations avoided per call, " +
+                                Fixed1(avoided * lineHz * 3600.0) + " per hour at " + std::to_string(lineHz) + " Hz");
+
+  // Neither a disabled nor an enabled (async) lazy line may touch the heap on the calling thread.
+  int failures = 0;
+  if (results[1].second.allocsPerCall != 0.0) ++failures;
+#if !defined(MRCD_LOG_STRIP_DEBUG)
+  if (results[3].second.allocsPerCall != 0.0) ++failures;
+#endif
+  return failures;
+}
+
+} // namespace stress
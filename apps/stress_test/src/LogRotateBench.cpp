@@ -0,0 +1,121 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/LatencyHistogram.h"
+#include "common/text/TextUtil.h"
+#include "common/time/MonotonicClock.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+using common::text::EndsWith;
+
+std::vector<std::string> ListDir(const std::string& dir) {
+  std::vector<std::string> names;
+  try {
+    Poco::File d(dir);
+    if (d.exists()) d.list(names);
+  } catch (const Poco::Exception& e) {
+    common::log::Warn("main", "log rotate bench: cannot list " + dir + ": " + e.displayText());
+  }
+  return names;
+}
+
+/** Empty (or create) dir so each mode counts only its own files. */
+void ResetDir(const std::string& dir) {
+  try {
+    for (const auto& n : ListDir(dir)) Poco::File(Poco::Path(dir).append(n).toString()).remove();
+    Poco::File(dir).createDirectories();
+  } catch (const Poco::Exception& e) {
+    common::log::Warn("main", "log rotate bench: cannot reset " + dir + ": " + e.displayText());
+  }
+}
+
+} // namespace
+
+int RunLogRotateBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("stress_test.log_rotate_modes", "off,rotate"));
+  const int threads = std::max(1, cfg.getInt("stress_test.log_threads", 4));
+  const int calls = std::max(100, cfg.getInt("stress_test.log_calls", 20000));
+  const auto segmentKb = static_cast<std::size_t>(std::max(16, cfg.getInt("stress_test.log_rotate_kb", 256)));
+  const std::string dir = cfg.getString("stress_test.log_rotate_dir", "stress_logs");
+
+  const common::log::Output restore = common::log::LoadOutput(cfg);
+  const common::log::AsyncParams restoreAsync = common::log::LoadAsyncParams(cfg);
+
+  common::log::Info("main", "log rotate bench: threads=" + std::to_string(threads) + " calls_per_thread=" +
+                                std::to_string(calls) + " segment_kb=" + std::to_string(segmentKb) + " dir=" + dir +
+                                " (synchronous writes: the calling thread does the file I/O)");
+
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const auto& mode : modes) {
+    common::log::Output out = restore;
+    out.channel = "file";
+    out.file = Poco::Path(dir).append("bench.log").toString();
+    out.rotation = common::log::FileRotation{};
+    if (mode == "rotate") {
+      out.rotation.maxBytes = segmentKb * 1024;
+      out.rotation.keepFiles = 8;
+    } else if (mode != "off") {
+      results.push_back("unknown mode " + mode);
+      ++failures;
+      continue;
+    }
+
+    ResetDir(dir);
+    common::log::StopAsync();
+    common::log::SetOutput(out);
+
+    std::vector<common::rt::LatencyHistogram> cost(static_cast<std::size_t>(threads));
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+      pool.emplace_back([&, t] {
+        common::log::SetThreadName("bench_" + std::to_string(t));
+        for (int i = 0; i < calls; ++i) {
+          const std::string msg = "cycle=" + std::to_string(i) + " value=" + std::to_string(i * 0.001) + " state=ok";
+          const auto a = common::time::NowMonotonicNs();
+          common::log::Info("bench", msg);
+          cost[static_cast<std::size_t>(t)].record(common::time::NowMonotonicNs() - a);
+        }
+      });
+    }
+    for (auto& th : pool) th.join();
+
+    // Closes the bench channel; the rotating one archives its full segments first.
+    common::log::SetOutput(restore);
+
+    int plain = 0;
+    int compressed = 0;
+    for (const auto& n : ListDir(dir)) {
+      if (EndsWith(n, ".gz")) ++compressed;
+      else if (EndsWith(n, ".log")) ++plain;
+    }
+    common::rt::LatencySnapshot s;
+    for (const auto& c : cost) s.merge(c.snapshot());
+    results.push_back(mode + " " + Us(s.percentileNs(0.5)) + " " + Us(s.percentileNs(0.99)) + " " +
+                      Us(s.percentileNs(0.999)) + " " + Us(s.maxNs) + " " + std::to_string(plain) + " " +
+                      std::to_string(compressed));
+    // Expect more than one segment, and no more than keepFiles closed ones plus the current one.
+    if (mode == "rotate" && (plain + compressed < 2 || plain + compressed > out.rotation.keepFiles + 1)) ++failures;
+  }
+
+  common::log::StartAsync(restoreAsync);
+  common::log::Info("main", "mode p50_us p99_us p999_us max_us log_files gz_files");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace stress
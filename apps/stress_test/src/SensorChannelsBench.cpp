@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/DoubleBufferChannel.h"
+#include "common/sensor/SensorFrameRing.h"
+#include "common/sensor/SensorSimulator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double NsPerOp(Clock::time_point t0, Clock::time_point t1, int iterations) {
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+         static_cast<double>(iterations);
+}
+
+} // namespace
+
+int RunSensorChannelsBench(const common::config::Config& cfg) {
+  const auto channelCounts = ParseIntList(cfg.getString("stress_test.channels", "3,16,64,256,1024,4096"));
+  const int iterations = std::max(1, cfg.getInt("stress_test.iterations", 20000));
+  const auto depth = static_cast<std::size_t>(std::max(2, cfg.getInt("stress_test.frame_depth", 8)));
+
+  common::log::Info("main", "sensor_channels bench: iterations=" + std::to_string(iterations) +
+                                " frame_depth=" + std::to_string(depth));
+  common::log::Info("main", "channels generate_ns publish_ns read_view_ns read_copy_ns");
+
+  int failures = 0;
+  volatile double sink = 0.0;
+
+  for (const int n : channelCounts) {
+    if (n <= 0) continue;
+    const auto channels = static_cast<std::size_t>(n);
+
+    common::sensor::SensorFrameRing ring(channels, depth);
+    common::sensor::SensorSimulator sim(common::sensor::SensorSimulator::Params{1000, channels});
+
+    // Simulator cost (sin + noise per channel), written straight into ring slots.
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      const auto s = sim.generate(ring.beginWrite());
+      ring.publish(s.seq, s.monotonicNs);
+    }
+    auto t1 = Clock::now();
+    const double generateNs = NsPerOp(t0, t1, iterations);
+
+    // Publish cost alone: fill N values in place and flip the slot.
+    t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      double* v = ring.beginWrite();
+      const double base = static_cast<double>(i);
+      for (std::size_t c = 0; c < channels; ++c) v[c] = base;
+      ring.publish(static_cast<std::uint64_t>(i) + 1, static_cast<std::uint64_t>(i));
+    }
+    t1 = Clock::now();
+    const double publishNs = NsPerOp(t0, t1, iterations);
+
+    // Zero-copy read: view + per-channel reduction + validation.
+    t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      const auto view = ring.latest();
+      double sum = 0.0;
+      for (std::size_t c = 0; c < view.channels; ++c) sum += view.values[c];
+      if (!view.valid()) ++failures;
+      sink = sink + sum;
+    }
+    t1 = Clock::now();
+    const double readViewNs = NsPerOp(t0, t1, iterations);
+
+    // Baseline: whole-block copy per read through the mutex channel.
+    common::rt::DoubleBufferChannel<std::vector<double>> copyChannel;
+    copyChannel.back().assign(channels, 1.0);
+    copyChannel.publishSwap();
+    t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      const auto block = copyChannel.readSnapshot();
+      double sum = 0.0;
+      for (const double v : block) sum += v;
+      sink = sink + sum;
+    }
+    t1 = Clock::now();
+    const double readCopyNs = NsPerOp(t0, t1, iterations);
+
+    common::log::Info("main", std::to_string(channels) + " " + Fixed1(generateNs) + " " + Fixed1(publishNs) + " " +
+                                  Fixed1(readViewNs) + " " + Fixed1(readCopyNs));
+  }
+  return failures;
+}
+
+} // namespace stress
@@ -0,0 +1,132 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/sensor/SensorSimulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using common::sensor::SensorSimulator;
+
+constexpr double kTwoPi = 2.0 * 3.1415926535;
+constexpr int kRateHz = 1000;
+
+double NsPerSample(Clock::time_point t0, Clock::time_point t1, std::size_t samples) {
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+         static_cast<double>(samples);
+}
+
+std::string Fixed2(double v) {
+  const auto hundredths = static_cast<long long>(std::llround(v * 100.0));
+  const auto frac = std::llabs(hundredths % 100);
+  return std::string(v < 0 && hundredths > -100 ? "-" : "") + std::to_string(hundredths / 100) + "." +
+         (frac < 10 ? "0" : "") + std::to_string(frac);
+}
+
+/** Previous per-sample path: std::sin per channel plus mt19937 / normal_distribution noise. */
+class LegacySimulator {
+public:
+  explicit LegacySimulator(std::size_t channels) : _channels(channels), _rng(1) {}
+
+  void generate(double* out) {
+    const double t = static_cast<double>(_seq++) / kRateHz;
+    for (std::size_t ch = 0; ch < _channels; ++ch) {
+      const double freq = 0.05 + 0.1 * static_cast<double>(ch % 16);
+      out[ch] = std::sin(kTwoPi * freq * t + 0.37 * static_cast<double>(ch)) + _noise(_rng);
+    }
+  }
+
+private:
+  std::size_t _channels;
+  std::uint64_t _seq{0};
+  std::mt19937 _rng;
+  std::normal_distribution<double> _noise{0.0, 0.02};
+};
+
+/** Residual of channel 0 (1.0 * sin(2*pi*0.8*t)) against the closed form: mean ~0, std ~ noise sigma. */
+void Residual(const std::vector<double>& block, std::size_t stride, std::size_t samples, double& mean, double& stddev) {
+  double sum = 0.0;
+  double sumSq = 0.0;
+  for (std::size_t i = 0; i < samples; ++i) {
+    const double t = static_cast<double>(i) / kRateHz;
+    const double r = block[i * stride] - std::sin(kTwoPi * 0.8 * t);
+    sum += r;
+    sumSq += r * r;
+  }
+  mean = sum / static_cast<double>(samples);
+  stddev = std::sqrt(std::max(0.0, sumSq / static_cast<double>(samples) - mean * mean));
+}
+
+} // namespace
+
+int RunSimulatorBench(const common::config::Config& cfg) {
+  const auto channelCounts = ParseIntList(cfg.getString("stress_test.channels", "3,16,64,256,1024,4096"));
+  const auto iterations = static_cast<std::size_t>(std::max(1, cfg.getInt("stress_test.iterations", 20000)));
+  const auto batch = static_cast<std::size_t>(std::max(1, cfg.getInt("stress_test.batch", 64)));
+  const auto seed = static_cast<std::uint64_t>(std::max(1, cfg.getInt("stress_test.seed", 12345)));
+
+  common::log::Info("main", "simulator bench: iterations=" + std::to_string(iterations) +
+                                " batch=" + std::to_string(batch) + " seed=" + std::to_string(seed));
+  common::log::Info("main", "channels legacy_ns generate_ns batch_ns speedup deterministic resid_mean resid_std");
+
+  int failures = 0;
+
+  for (const int n : channelCounts) {
+    if (n <= 0) continue;
+    const auto channels = static_cast<std::size_t>(n);
+    const std::size_t stride = channels;
+    // Keep the working set bounded for large channel counts.
+    const std::size_t samples = std::max<std::size_t>(batch, std::min(iterations, (std::size_t{1} << 24) / channels));
+    std::vector<double> a(samples * stride);
+    std::vector<double> b(samples * stride);
+
+    LegacySimulator legacy(channels);
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < samples; ++i) legacy.generate(a.data() + i * stride);
+    auto t1 = Clock::now();
+    const double legacyNs = NsPerSample(t0, t1, samples);
+
+    SensorSimulator perSample(SensorSimulator::Params{kRateHz, channels, seed});
+    t0 = Clock::now();
+    for (std::size_t i = 0; i < samples; ++i) perSample.generate(a.data() + i * stride);
+    t1 = Clock::now();
+    const double generateNs = NsPerSample(t0, t1, samples);
+
+    SensorSimulator batched(SensorSimulator::Params{kRateHz, channels, seed});
+    t0 = Clock::now();
+    for (std::size_t i = 0; i < samples; i += batch) {
+      batched.generateBatch(std::min(batch, samples - i), b.data() + i * stride, stride);
+    }
+    t1 = Clock::now();
+    const double batchNs = NsPerSample(t0, t1, samples);
+
+    // Same seed: the per-sample and batch paths must agree bit for bit.
+    const bool deterministic = a == b;
+    if (!deterministic) ++failures;
+
+    double residMean = 0.0;
+    double residStd = 0.0;
+    Residual(b, stride, samples, residMean, residStd);
+    if (std::abs(residMean) > 0.005 || std::abs(residStd - 0.02) > 0.005) ++failures;
+
+    common::log::Info("main", std::to_string(channels) + " " + Fixed2(legacyNs) + " " + Fixed2(generateNs) + " " +
+                                  Fixed2(batchNs) + " " + Fixed2(legacyNs / std::max(batchNs, 1e-9)) + " " +
+                                  (deterministic ? "yes" : "NO") + " " + Fixed2(residMean * 1000.0) + "e-3 " +
+                                  Fixed2(residStd * 1000.0) + "e-3");
+  }
+  return failures;
+}
+
+} // namespace stress
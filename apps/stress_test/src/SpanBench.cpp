@@ -0,0 +1,83 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+#include "common/trace/Spans.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+/** ns per iteration of a loop body holding one span (or none), over threads running concurrently. */
+double MeasureNsPerSpan(int threads, int iterations, bool withSpan) {
+  std::atomic<std::uint64_t> sink{0};
+  std::atomic<std::uint64_t> totalNs{0};
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      common::log::SetThreadName("span_bench_" + std::to_string(t));
+      std::uint64_t local = 0;
+      const auto t0 = common::time::NowMonotonicNs();
+      for (int i = 0; i < iterations; ++i) {
+        if (withSpan) {
+          MRCD_TRACE_SPAN_SEQ("bench.span", static_cast<std::uint64_t>(i));
+          local += static_cast<std::uint64_t>(i);
+        } else {
+          local += static_cast<std::uint64_t>(i);
+        }
+        // Keep the loop from being folded away.
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+      }
+      totalNs.fetch_add(common::time::NowMonotonicNs() - t0);
+      sink.fetch_add(local);
+    });
+  }
+  for (auto& th : pool) th.join();
+  return static_cast<double>(totalNs.load()) / (static_cast<double>(threads) * iterations);
+}
+
+} // namespace
+
+int RunSpanBench(const common::config::Config& cfg) {
+  const int iterations = std::max(1000, cfg.getInt("stress_test.iterations", 20000) * 50);
+  const int threads = std::max(1, cfg.getInt("stress_test.span_threads", 4));
+  auto params = common::trace::LoadSpanParams(cfg);
+  params.path = cfg.getString("stress_test.span_file", "stress_spans.json");
+  params.truncate = true;
+
+#if !defined(MRCD_TRACE_SPANS)
+  common::log::Warn("main", "span bench: built with MRCD_TRACE_SPANS=OFF, spans compile to nothing");
+#endif
+  common::log::Info("main", "span bench: threads=" + std::to_string(threads) + " iterations=" + std::to_string(iterations) +
+                                " ring_events=" + std::to_string(params.ringEvents));
+  common::log::Info("main", "mode ns_per_iteration overhead_ns");
+
+  const double baseline = MeasureNsPerSpan(threads, iterations, false);
+  common::log::Info("main", "no_span " + Fixed1(baseline) + " 0.0");
+
+  const double disabled = MeasureNsPerSpan(threads, iterations, true);
+  common::log::Info("main", "disabled " + Fixed1(disabled) + " " + Fixed1(std::max(0.0, disabled - baseline)));
+
+  // Enabled: one ring's worth per thread so every span is written, none dropped.
+  const int enabledIterations = std::min<int>(iterations, static_cast<int>(params.ringEvents));
+  const double enabledBaseline = MeasureNsPerSpan(threads, enabledIterations, false);
+  params.enabled = true;
+  common::trace::StartSpans(params, "stress_test");
+  const double enabled = MeasureNsPerSpan(threads, enabledIterations, true);
+  common::trace::StopSpans();
+  common::log::Info("main", "enabled " + Fixed1(enabled) + " " + Fixed1(std::max(0.0, enabled - enabledBaseline)));
+
+  // A disabled span must stay in the noise of an empty loop body.
+  return disabled - baseline > 2.0 ? 1 : 0;
+}
+
+} // namespace stress
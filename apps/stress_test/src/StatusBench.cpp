@@ -0,0 +1,143 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/LatencyHistogram.h"
+#include "common/status/StatusSnapshot.h"
+#include "common/time/MonotonicClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+namespace {
+
+/** The previous StatusStore: whole-snapshot copy under one mutex. */
+class SnapshotStatusStore {
+public:
+  void update(const common::status::StatusSnapshot& s) {
+    std::lock_guard<std::mutex> lk(_mu);
+    _snapshot = s;
+  }
+  common::status::StatusSnapshot read() const {
+    std::lock_guard<std::mutex> lk(_mu);
+    return _snapshot;
+  }
+
+private:
+  mutable std::mutex _mu;
+  common::status::StatusSnapshot _snapshot;
+};
+
+} // namespace
+
+int RunStatusBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("stress_test.status_modes", "snapshot,fields"));
+  const int updates = std::max(1000, cfg.getInt("stress_test.status_updates", 200000));
+  const int readers = std::max(0, cfg.getInt("stress_test.status_readers", 1));
+
+  common::log::Info("main", "status bench: updates=" + std::to_string(updates) + " readers=" + std::to_string(readers) +
+                                " (control writer + 1 kHz supervisor writer)");
+  common::log::Info("main", "mode ns_per_update p99_us max_us reads lost_command_updates");
+
+  int failures = 0;
+  for (const auto& mode : modes) {
+    const bool fields = mode == "fields";
+    if (!fields && mode != "snapshot") {
+      common::log::Warn("main", "unknown status mode: " + mode);
+      ++failures;
+      continue;
+    }
+
+    SnapshotStatusStore legacy;
+    common::status::StatusStore store;
+    std::atomic<bool> running{true};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<std::uint64_t> lost{0};
+
+    // Supervisor: ControllerRuntime's heartbeat/state updates. In "snapshot" mode it writes back its own
+    // copy, as before, and clobbers the control fields.
+    std::thread supervisor([&] {
+      common::status::StatusSnapshot snap;
+      std::uint64_t tick = 0;
+      while (running.load()) {
+        ++tick;
+        if (fields) {
+          store.setSystemState(common::status::SystemState::Running);
+          store.setAlgoHealth(common::status::AlgoHealthState::Healthy);
+          store.health().heartbeatRttMs.set(static_cast<double>(tick % 10));
+          store.health().heartbeatTimeouts.set(tick);
+        } else {
+          snap.systemState = common::status::SystemState::Running;
+          snap.algoHealth = common::status::AlgoHealthState::Healthy;
+          snap.heartbeatRttMs = static_cast<double>(tick % 10);
+          snap.heartbeatTimeouts = tick;
+          legacy.update(snap);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+
+    // Readers: UI-style polling. lastCommand only ever increases, so a decrease means a lost update.
+    std::vector<std::thread> readerThreads;
+    for (int r = 0; r < readers; ++r) {
+      readerThreads.emplace_back([&] {
+        double seenMax = 0.0;
+        std::uint64_t n = 0;
+        std::uint64_t regressions = 0;
+        while (running.load()) {
+          const auto st = fields ? store.read() : legacy.read();
+          if (st.lastCommand < seenMax) ++regressions;
+          seenMax = std::max(seenMax, st.lastCommand);
+          ++n;
+        }
+        reads.fetch_add(n);
+        lost.fetch_add(regressions);
+      });
+    }
+
+    common::rt::LatencyHistogram cost;
+    auto& metrics = store.control();
+    const auto t0 = common::time::NowMonotonicNs();
+    for (int i = 1; i <= updates; ++i) {
+      const auto a = common::time::NowMonotonicNs();
+      const double v = static_cast<double>(i);
+      if (fields) {
+        metrics.algoLatencyMs.set(0.5);
+        metrics.lastCommand.set(v);
+        metrics.actuatorPosition.set(v * 0.5);
+        metrics.actuatorVelocity.set(0.5);
+      } else {
+        auto st = legacy.read();
+        st.controlLoopHz = 200.0;
+        st.algoLatencyMs = 0.5;
+        st.lastCommand = v;
+        st.actuatorPosition = v * 0.5;
+        st.actuatorVelocity = 0.5;
+        legacy.update(st);
+      }
+      cost.record(common::time::NowMonotonicNs() - a);
+    }
+    const auto elapsed = common::time::NowMonotonicNs() - t0;
+
+    running.store(false);
+    supervisor.join();
+    for (auto& t : readerThreads) t.join();
+
+    const auto s = cost.snapshot();
+    if (fields && lost.load() != 0) ++failures;
+    common::log::Info("main", mode + " " + Fixed1(static_cast<double>(elapsed) / updates) + " " +
+                                  Us(s.percentileNs(0.99)) + " " + Us(s.maxNs) + " " + std::to_string(reads.load()) +
+                                  " " + std::to_string(lost.load()));
+  }
+  return failures;
+}
+
+} // namespace stress
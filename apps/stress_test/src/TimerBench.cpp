@@ -0,0 +1,75 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/PeriodicTimer.h"
+#include "common/rt/ThreadPolicy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <thread>
+
+namespace stress {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+int RunTimerBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("stress_test.timer_modes", "sleep,hybrid,spin"));
+  const auto rates = ParseIntList(cfg.getString("stress_test.timer_rates", "1000,4000"));
+  const auto duration = std::chrono::milliseconds(std::max(100, cfg.getInt("stress_test.case_duration_ms", 2000)));
+  const auto spinMargin = std::chrono::microseconds(std::max(0, cfg.getInt("stress_test.spin_margin_us", 200)));
+  const auto timerSlack = std::chrono::microseconds(std::max(0, cfg.getInt("stress_test.timer_slack_us", 0)));
+
+  common::log::Info("main", "timer bench: duration_ms=" + std::to_string(duration.count()) +
+                                " spin_margin_us=" + std::to_string(spinMargin.count()) +
+                                " timer_slack_us=" + std::to_string(timerSlack.count()));
+  common::log::Info("main", "mode rate_hz cycles overruns jitter_mean_us p50_us p99_us max_us cpu_pct");
+
+  int failures = 0;
+  for (const auto& modeName : modes) {
+    const auto mode = common::rt::ParseTimerMode(modeName, common::rt::TimerMode::Sleep);
+    for (const int rate : rates) {
+      if (rate <= 0) continue;
+      common::rt::PeriodicTimer::Params p;
+      p.period = common::rt::PeriodicTimer::PeriodForRate(rate);
+      p.mode = mode;
+      p.spinMargin = spinMargin;
+      p.timerSlack = timerSlack;
+      common::rt::PeriodicTimer timer(p);
+
+      // The loop runs on a "timer" thread so [rt.timer] can pin/prioritize it; main only joins, so process
+      // CPU time is the loop thread's cost.
+      const std::clock_t cpu0 = std::clock();
+      const auto t0 = Clock::now();
+      std::thread loop([&] {
+        common::log::SetThreadName("timer");
+        common::rt::ConfigureCurrentThread("timer");
+        timer.start();
+        while (Clock::now() - t0 < duration) timer.wait();
+      });
+      loop.join();
+      const double wallS = std::chrono::duration<double>(Clock::now() - t0).count();
+      const double cpuS = static_cast<double>(std::clock() - cpu0) / CLOCKS_PER_SEC;
+
+      const auto s = timer.stats();
+      if (s.cycles == 0) ++failures;
+      common::log::Info("main", std::string(common::rt::ToString(mode)) + " " + std::to_string(rate) + " " +
+                                    std::to_string(s.cycles) + " " + std::to_string(s.overruns) + " " +
+                                    Us(static_cast<std::uint64_t>(s.jitter.meanNs())) + " " +
+                                    Us(s.jitter.percentileNs(0.5)) + " " + Us(s.jitter.percentileNs(0.99)) + " " +
+                                    Us(s.jitter.maxNs) + " " +
+                                    std::to_string(static_cast<int>(100.0 * cpuS / std::max(wallS, 1e-9) + 0.5)));
+      common::log::Info("main", "  histogram: " + s.jitter.describe());
+    }
+  }
+  return failures;
+}
+
+} // namespace stress
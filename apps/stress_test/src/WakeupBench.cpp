@@ -0,0 +1,93 @@
+#include "Benchmarks.h"
+#include "BenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/LatencyHistogram.h"
+#include "common/rt/PeriodicTimer.h"
+#include "common/rt/SeqNotifier.h"
+#include "common/time/MonotonicClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace stress {
+
+int RunWakeupBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("stress_test.wakeup_modes", "poll,notify"));
+  const int rateHz = std::max(1, cfg.getInt("stress_test.wakeup_rate_hz", 200));
+  const auto duration = std::chrono::milliseconds(std::max(100, cfg.getInt("stress_test.case_duration_ms", 2000)));
+
+  common::log::Info("main", "wakeup bench: publisher rate_hz=" + std::to_string(rateHz) +
+                                " duration_ms=" + std::to_string(duration.count()));
+  common::log::Info("main", "mode published seen missed wakeups_per_sample mean_us p50_us p99_us max_us");
+
+  int failures = 0;
+  for (const auto& mode : modes) {
+    const bool notify = mode == "notify";
+    if (!notify && mode != "poll") {
+      common::log::Warn("main", "unknown wakeup mode: " + mode);
+      ++failures;
+      continue;
+    }
+
+    common::rt::SeqNotifier notifier;
+    common::rt::LatencyHistogram latency;
+    std::atomic<bool> running{true};
+    std::uint64_t seen = 0;
+    std::uint64_t wakeups = 0;
+
+    // Consumer: "poll" is the previous ControlLoop (check seq, sleep 1 ms if unchanged); "notify" blocks on
+    // the notifier. Latency is publish() to consumer start.
+    std::thread consumer([&] {
+      std::uint64_t last = 0;
+      while (running.load()) {
+        ++wakeups;
+        std::uint64_t seq;
+        if (notify) {
+          seq = notifier.waitNewer(last, std::chrono::steady_clock::now() + std::chrono::milliseconds(100));
+        } else {
+          seq = notifier.current();
+          if (seq == last) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+          }
+        }
+        if (seq == last) continue;
+        if (!running.load()) break;  // Shutdown publish, not a sample.
+        const auto now = common::time::NowMonotonicNs();
+        const auto pub = notifier.lastPublishNs();
+        if (now > pub) latency.record(now - pub);
+        last = seq;
+        ++seen;
+      }
+    });
+
+    common::rt::PeriodicTimer timer(common::rt::PeriodicTimer::Params{common::rt::PeriodicTimer::PeriodForRate(rateHz)});
+    const auto t0 = std::chrono::steady_clock::now();
+    std::uint64_t published = 0;
+    timer.start();
+    while (std::chrono::steady_clock::now() - t0 < duration) {
+      notifier.publish(++published);
+      timer.wait();
+    }
+    running.store(false);
+    notifier.publish(published + 1);
+    consumer.join();
+
+    const auto s = latency.snapshot();
+    const std::uint64_t missed = published > seen ? published - seen : 0;
+    if (seen == 0) ++failures;
+    common::log::Info("main", mode + " " + std::to_string(published) + " " + std::to_string(seen) + " " +
+                                  std::to_string(missed) + " " +
+                                  Fixed1(static_cast<double>(wakeups) / static_cast<double>(std::max<std::uint64_t>(1, seen))) +
+                                  " " + Us(static_cast<std::uint64_t>(s.meanNs())) + " " + Us(s.percentileNs(0.5)) +
+                                  " " + Us(s.percentileNs(0.99)) + " " + Us(s.maxNs));
+  }
+  return failures;
+}
+
+} // namespace stress
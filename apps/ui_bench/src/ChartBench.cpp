@@ -0,0 +1,164 @@
+#include "UiBenchmarks.h"
+#include "UiBenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+#include "ui/RasterPlot.h"
+#include "ui/TelemetryChart.h"
+
+#include <QChart>
+#include <QChartView>
+#include <QLineSeries>
+#include <QValueAxis>
+
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uibench {
+
+namespace {
+
+/** The original TelemetryChart: removePoints/append and an axis update for every sample. */
+class PerSampleChart : public QChartView {
+public:
+  explicit PerSampleChart(int window) : _window(window) {
+    auto* chart = new QChart();
+    _seriesPosition = new QLineSeries();
+    _seriesSensor = new QLineSeries();
+    chart->addSeries(_seriesPosition);
+    chart->addSeries(_seriesSensor);
+    chart->setAnimationOptions(QChart::NoAnimation);
+    _axisX = new QValueAxis();
+    _axisX->setRange(0, window - 1);
+    _axisY = new QValueAxis();
+    _axisY->setRange(-1.5, 1.5);
+    chart->addAxis(_axisX, Qt::AlignBottom);
+    chart->addAxis(_axisY, Qt::AlignLeft);
+    for (auto* s : {_seriesPosition, _seriesSensor}) {
+      s->attachAxis(_axisX);
+      s->attachAxis(_axisY);
+    }
+    setChart(chart);
+    setRenderHint(QPainter::Antialiasing);
+  }
+
+  void appendSample(double position, double sensorValue) {
+    const int idx = _sampleIndex++;
+    if (_seriesPosition->count() >= _window) {
+      _seriesPosition->removePoints(0, _seriesPosition->count() - (_window - 1));
+      _seriesSensor->removePoints(0, _seriesSensor->count() - (_window - 1));
+    }
+    _seriesPosition->append(idx, position);
+    _seriesSensor->append(idx, sensorValue);
+    const int minX = qMax(0, _sampleIndex - _window);
+    _axisX->setRange(minX, minX + _window - 1);
+    const double y = qMax(qAbs(position), qAbs(sensorValue));
+    if (y > 0 && (y < _axisY->min() || y > _axisY->max())) _axisY->setRange(-y - 0.2, y + 0.2);
+  }
+
+private:
+  const int _window;
+  QLineSeries* _seriesPosition{nullptr};
+  QLineSeries* _seriesSensor{nullptr};
+  QValueAxis* _axisX{nullptr};
+  QValueAxis* _axisY{nullptr};
+  int _sampleIndex{0};
+};
+
+} // namespace
+
+int RunChartBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("ui_bench.chart_modes", "per_sample,decimated,raster"));
+  const auto rates = ParseIntList(cfg.getString("ui_bench.chart_rates", "1000,10000"));
+  const int window = std::max(16, cfg.getInt("ui_bench.chart_window", 10000));
+  const int fps = std::max(1, cfg.getInt("ui_bench.fps", 60));
+  const int frames = std::max(10, cfg.getInt("ui_bench.frames", 300));
+  const int width = cfg.getInt("ui_bench.width", 900);
+  const int height = cfg.getInt("ui_bench.height", 320);
+
+  common::log::Info("main", "chart bench: window=" + std::to_string(window) + " fps=" + std::to_string(fps) +
+                                " frames=" + std::to_string(frames) + " size=" + std::to_string(width) + "x" +
+                                std::to_string(height));
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const auto& mode : modes) {
+    for (const int rate : rates) {
+      if (rate <= 0) continue;
+      std::unique_ptr<QWidget> widget;
+      std::function<void(double, double)> append;
+      std::function<void()> flush = [] {};
+      if (mode == "decimated") {
+        auto* chart = new ui::TelemetryChart();
+        chart->setWindow(window);
+        chart->setFrameInterval(0);  // frames are driven below
+        append = [chart](double p, double s) { chart->appendSample(p, s); };
+        flush = [chart] { chart->flushFrame(); };
+        widget.reset(chart);
+      } else if (mode == "raster") {
+        auto* plot = new ui::RasterPlot();
+        plot->addSeries("Position", QColor(0x00, 0xd4, 0xaa), 2);
+        plot->addSeries("Sensor", QColor(0x7e, 0xe8, 0xc9), 1);
+        plot->setWindow(window);
+        plot->setFrameInterval(0);
+        append = [plot](double p, double s) { plot->appendSample({p, s}); };
+        flush = [plot] { plot->flushFrame(); };
+        widget.reset(plot);
+      } else if (mode == "per_sample") {
+        auto* chart = new PerSampleChart(window);
+        append = [chart](double p, double s) { chart->appendSample(p, s); };
+        widget.reset(chart);
+      } else {
+        results.push_back("unknown mode " + mode);
+        ++failures;
+        break;
+      }
+      widget->resize(width, height);
+      widget->show();
+
+      // Fill the window first so every measured frame draws a full window.
+      Signal signal(rate);
+      double position = 0.0;
+      double sensor = 0.0;
+      for (int i = 0; i < window; ++i) {
+        signal.next(position, sensor);
+        append(position, sensor);
+      }
+      flush();
+      RenderFrame(*widget);
+
+      FrameTimes times;
+      const std::clock_t cpu0 = std::clock();
+      const double perFrame = static_cast<double>(rate) / fps;
+      double due = 0.0;
+      for (int f = 0; f < frames; ++f) {
+        due += perFrame;
+        const int n = static_cast<int>(due);
+        due -= n;
+        const auto t0 = common::time::NowMonotonicNs();
+        for (int i = 0; i < n; ++i) {
+          signal.next(position, sensor);
+          append(position, sensor);
+        }
+        flush();
+        RenderFrame(*widget);
+        times.add(common::time::NowMonotonicNs() - t0);
+      }
+      // Process CPU time, so work the offscreen backend does outside the measured thread counts too.
+      const double cpuNsPerFrame = static_cast<double>(std::clock() - cpu0) * 1e9 / CLOCKS_PER_SEC / frames;
+      const double budgetNs = 1e9 / fps;
+      results.push_back(mode + " " + std::to_string(rate) + " " + times.describe() + " " + Ms(cpuNsPerFrame) + " " +
+                        std::to_string(static_cast<int>(100.0 * times.meanNs() / budgetNs)));
+    }
+  }
+
+  common::log::Info("main", "mode rate_hz p50_ms p99_ms max_ms mean_ms cpu_ms pct_of_frame_budget");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace uibench
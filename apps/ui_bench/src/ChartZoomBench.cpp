@@ -0,0 +1,163 @@
+#include "UiBenchmarks.h"
+#include "UiBenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+#include "ui/TelemetryChart.h"
+
+#include <QChart>
+#include <QChartView>
+#include <QLineSeries>
+#include <QList>
+#include <QPointF>
+#include <QValueAxis>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uibench {
+
+namespace {
+
+/** Undecimated baseline: every sample of the span goes into the series with one replace() per frame. */
+class RawChart : public QChartView {
+public:
+  explicit RawChart(int span) : _span(span) {
+    auto* chart = new QChart();
+    _seriesPosition = new QLineSeries();
+    _seriesSensor = new QLineSeries();
+    chart->addSeries(_seriesPosition);
+    chart->addSeries(_seriesSensor);
+    chart->setAnimationOptions(QChart::NoAnimation);
+    _axisX = new QValueAxis();
+    _axisX->setRange(0, span - 1);
+    auto* axisY = new QValueAxis();
+    axisY->setRange(-1.5, 1.5);
+    chart->addAxis(_axisX, Qt::AlignBottom);
+    chart->addAxis(axisY, Qt::AlignLeft);
+    for (auto* s : {_seriesPosition, _seriesSensor}) {
+      s->attachAxis(_axisX);
+      s->attachAxis(axisY);
+    }
+    setChart(chart);
+    setRenderHint(QPainter::Antialiasing);
+  }
+
+  void appendSample(double position, double sensorValue) {
+    _position.push_back(position);
+    _sensor.push_back(sensorValue);
+  }
+
+  void flushFrame() {
+    const auto n = static_cast<int>(_position.size());
+    const int first = std::max(0, n - _span);
+    _pointsPosition.resize(n - first);
+    _pointsSensor.resize(n - first);
+    for (int i = first; i < n; ++i) {
+      _pointsPosition[i - first] = QPointF(i, _position[static_cast<std::size_t>(i)]);
+      _pointsSensor[i - first] = QPointF(i, _sensor[static_cast<std::size_t>(i)]);
+    }
+    _seriesPosition->replace(_pointsPosition);
+    _seriesSensor->replace(_pointsSensor);
+    _axisX->setRange(first, first + _span - 1);
+  }
+
+private:
+  const int _span;
+  QLineSeries* _seriesPosition{nullptr};
+  QLineSeries* _seriesSensor{nullptr};
+  QValueAxis* _axisX{nullptr};
+  std::vector<double> _position;
+  std::vector<double> _sensor;
+  QList<QPointF> _pointsPosition;
+  QList<QPointF> _pointsSensor;
+};
+
+} // namespace
+
+int RunChartZoomBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("ui_bench.zoom_modes", "raw,minmax,lttb"));
+  const auto spans = ParseIntList(cfg.getString("ui_bench.zoom_spans", "10000,60000,300000"));
+  const int rate = std::max(1, cfg.getInt("ui_bench.zoom_rate", 1000));
+  const int fps = std::max(1, cfg.getInt("ui_bench.fps", 60));
+  const int frames = std::max(10, cfg.getInt("ui_bench.frames", 300));
+  const int width = cfg.getInt("ui_bench.width", 900);
+  const int height = cfg.getInt("ui_bench.height", 320);
+
+  common::log::Info("main", "chart zoom bench: rate_hz=" + std::to_string(rate) + " fps=" + std::to_string(fps) +
+                                " frames=" + std::to_string(frames) + " size=" + std::to_string(width) + "x" +
+                                std::to_string(height));
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const auto& mode : modes) {
+    for (const int span : spans) {
+      if (span <= 0) continue;
+      std::unique_ptr<QWidget> widget;
+      std::function<void(double, double)> append;
+      std::function<void()> flush;
+      if (mode == "minmax" || mode == "lttb") {
+        auto* chart = new ui::TelemetryChart();
+        chart->setHistory(span);
+        chart->setWindow(span);
+        chart->setDecimation(mode == "lttb" ? ui::Decimation::Lttb : ui::Decimation::MinMax);
+        chart->setFrameInterval(0);  // frames are driven below
+        append = [chart](double p, double s) { chart->appendSample(p, s); };
+        flush = [chart] { chart->flushFrame(); };
+        widget.reset(chart);
+      } else if (mode == "raw") {
+        auto* chart = new RawChart(span);
+        append = [chart](double p, double s) { chart->appendSample(p, s); };
+        flush = [chart] { chart->flushFrame(); };
+        widget.reset(chart);
+      } else {
+        results.push_back("unknown mode " + mode);
+        ++failures;
+        break;
+      }
+      widget->resize(width, height);
+      widget->show();
+
+      // Fill the span first: every measured frame shows span / rate seconds of history.
+      Signal signal(rate);
+      double position = 0.0;
+      double sensor = 0.0;
+      for (int i = 0; i < span; ++i) {
+        signal.next(position, sensor);
+        append(position, sensor);
+      }
+      flush();
+      RenderFrame(*widget);
+
+      FrameTimes times;
+      const double perFrame = static_cast<double>(rate) / fps;
+      double due = 0.0;
+      for (int f = 0; f < frames; ++f) {
+        due += perFrame;
+        const int n = static_cast<int>(due);
+        due -= n;
+        const auto t0 = common::time::NowMonotonicNs();
+        for (int i = 0; i < n; ++i) {
+          signal.next(position, sensor);
+          append(position, sensor);
+        }
+        flush();
+        RenderFrame(*widget);
+        times.add(common::time::NowMonotonicNs() - t0);
+      }
+      const double budgetNs = 1e9 / fps;
+      results.push_back(mode + " " + std::to_string(span) + " " + std::to_string(span / rate) + " " +
+                        times.describe() + " " + std::to_string(static_cast<int>(100.0 * times.meanNs() / budgetNs)));
+    }
+  }
+
+  common::log::Info("main", "mode span_samples span_s p50_ms p99_ms max_ms mean_ms pct_of_frame_budget");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace uibench
@@ -0,0 +1,131 @@
+#include "UiBenchmarks.h"
+#include "UiBenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+#include "MainWindow.h"
+#include "ui/RasterPlot.h"
+#include "ui/TelemetryChart.h"
+
+#include <QString>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace uibench {
+
+namespace {
+
+/** Samples (or lines) due this frame at rate per second; fractional remainders carry over. */
+int Due(double& carry, int rate, int fps) {
+  carry += static_cast<double>(rate) / fps;
+  const int n = static_cast<int>(carry);
+  carry -= n;
+  return n;
+}
+
+} // namespace
+
+int RunConsoleBench(const common::config::Config& cfg) {
+  const auto renderers = ParseList(cfg.getString("ui_bench.console_renderers", "charts,raster"));
+  const auto sampleRates = ParseIntList(cfg.getString("ui_bench.console_sample_rates", "200,2000"));
+  const auto logRates = ParseIntList(cfg.getString("ui_bench.console_log_rates", "10,1000"));
+  const int chartWindow = std::max(2, cfg.getInt("ui_bench.console_window", 300));
+  const int width = cfg.getInt("ui_bench.console_width", 1280);
+  const int height = cfg.getInt("ui_bench.console_height", 900);
+  const int fps = std::max(1, cfg.getInt("ui_bench.fps", 60));
+  const int frames = std::max(10, cfg.getInt("ui_bench.frames", 300));
+
+  common::log::Info("main", "console bench: window=" + std::to_string(chartWindow) + " fps=" + std::to_string(fps) +
+                                " frames=" + std::to_string(frames) + " size=" + std::to_string(width) + "x" +
+                                std::to_string(height));
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const auto& renderer : renderers) {
+    if (renderer != "charts" && renderer != "raster") {
+      results.push_back("unknown renderer " + renderer);
+      ++failures;
+      continue;
+    }
+    for (const int sampleRate : sampleRates) {
+      for (const int logRate : logRates) {
+        if (sampleRate <= 0 || logRate < 0) continue;
+        MainWindow console;
+        console.setFrameInterval(0);  // frames are driven below
+        if (renderer == "raster") {
+          console.useRasterTelemetry(chartWindow);
+        } else {
+          console.telemetryChart()->setWindow(chartWindow);
+        }
+        console.resize(width, height);
+        console.show();
+        // Polish, layout and the first full paint are one-off costs, not per-frame ones.
+        RenderFrame(console);
+
+        Signal signal(sampleRate);
+        FrameTimes update;
+        FrameTimes paint;
+        std::vector<std::uint64_t> allocs;
+        allocs.reserve(static_cast<std::size_t>(frames));
+        double sampleCarry = 0.0;
+        double logCarry = 0.0;
+        double position = 0.0;
+        double sensor = 0.0;
+        double velocity = 0.0;
+        std::uint64_t seq = 0;
+        std::uint64_t logSeq = 0;
+        for (int f = 0; f < frames; ++f) {
+          const int samples = Due(sampleCarry, sampleRate, fps);
+          const int lines = Due(logCarry, logRate, fps);
+          const auto a0 = ThreadAllocations();
+          const auto t0 = common::time::NowMonotonicNs();
+          // Every sample goes to the chart; the readouts and status show the last one, as once per frame in the app.
+          for (int i = 0; i < samples; ++i, ++seq) {
+            const double previous = position;
+            signal.next(position, sensor);
+            velocity = (position - previous) * sampleRate;
+            if (i + 1 < samples) {
+              if (auto* chart = console.telemetryChart()) chart->appendSample(position, sensor);
+              if (auto* raster = console.rasterPlot()) raster->appendSample({position, sensor});
+            }
+          }
+          if (samples > 0) console.updateState(position, velocity, sensor);
+          console.setStatusText(QStringLiteral("RUNNING  seq=%1").arg(seq));
+          for (int i = 0; i < lines; ++i, ++logSeq) {
+            console.appendLog(QStringLiteral("[information][control] step seq=%1 cmd=%2 pos=%3")
+                                  .arg(logSeq)
+                                  .arg(sensor, 0, 'f', 4)
+                                  .arg(position, 0, 'f', 4));
+          }
+          console.flushFrame();
+          const auto t1 = common::time::NowMonotonicNs();
+          RenderFrame(console);
+          const auto t2 = common::time::NowMonotonicNs();
+          allocs.push_back(ThreadAllocations() - a0);
+          update.add(t1 - t0);
+          paint.add(t2 - t1);
+        }
+
+        const double budgetNs = 1e9 / fps;
+        const double meanNs = update.meanNs() + paint.meanNs();
+        results.push_back(renderer + " " + std::to_string(sampleRate) + " " + std::to_string(logRate) + " " +
+                          Ms(static_cast<double>(update.percentileNs(0.5))) + " " +
+                          Ms(static_cast<double>(update.percentileNs(0.99))) + " " +
+                          Ms(static_cast<double>(paint.percentileNs(0.5))) + " " +
+                          Ms(static_cast<double>(paint.percentileNs(0.99))) + " " +
+                          std::to_string(Percentile(allocs, 0.5)) + " " + std::to_string(Percentile(allocs, 0.99)) + " " +
+                          std::to_string(static_cast<int>(100.0 * meanNs / budgetNs)));
+      }
+    }
+  }
+
+  common::log::Info("main",
+                    "renderer samples_per_s lines_per_s update_p50_ms update_p99_ms paint_p50_ms paint_p99_ms "
+                    "allocs_p50 allocs_p99 pct_of_frame_budget");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace uibench
@@ -0,0 +1,112 @@
+#include "UiBenchmarks.h"
+#include "UiBenchUtil.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+#include "ui/LogPanel.h"
+
+#include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QString>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uibench {
+
+namespace {
+
+/** LogPanel before batching: appendPlainText and a scroll for every line, no block limit. */
+class PerLineLog : public QPlainTextEdit {
+public:
+  PerLineLog() { setReadOnly(true); }
+
+  void appendLog(const QString& text) {
+    appendPlainText(text);
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+  }
+};
+
+} // namespace
+
+int RunLogPanelBench(const common::config::Config& cfg) {
+  const auto modes = ParseList(cfg.getString("ui_bench.log_modes", "per_line,text,list"));
+  const auto rates = ParseIntList(cfg.getString("ui_bench.log_rates", "1000,10000"));
+  const int maxLines = std::max(1, cfg.getInt("ui_bench.log_max_lines", 5000));
+  const int fps = std::max(1, cfg.getInt("ui_bench.fps", 60));
+  const int frames = std::max(10, cfg.getInt("ui_bench.frames", 300));
+  const int width = cfg.getInt("ui_bench.width", 900);
+  const int height = cfg.getInt("ui_bench.height", 320);
+
+  common::log::Info("main", "log panel bench: max_lines=" + std::to_string(maxLines) + " fps=" + std::to_string(fps) +
+                                " frames=" + std::to_string(frames) + " size=" + std::to_string(width) + "x" +
+                                std::to_string(height));
+  std::vector<std::string> results;
+  int failures = 0;
+  for (const auto& mode : modes) {
+    for (const int rate : rates) {
+      if (rate <= 0) continue;
+      std::unique_ptr<QWidget> widget;
+      std::function<void(const QString&)> append;
+      std::function<void()> flush = [] {};
+      std::function<int()> lines;
+      if (mode == "text" || mode == "list") {
+        auto* panel = new ui::LogPanel();
+        panel->setView(mode == "list" ? ui::LogPanel::View::List : ui::LogPanel::View::Text);
+        panel->setMaxLines(maxLines);
+        panel->setFrameInterval(0);  // frames are driven below
+        append = [panel](const QString& t) { panel->appendLog(t); };
+        flush = [panel] { panel->flushFrame(); };
+        lines = [panel] { return panel->lineCount(); };
+        widget.reset(panel);
+      } else if (mode == "per_line") {
+        auto* edit = new PerLineLog();
+        append = [edit](const QString& t) { edit->appendLog(t); };
+        lines = [edit] { return edit->blockCount(); };
+        widget.reset(edit);
+      } else {
+        results.push_back("unknown mode " + mode);
+        ++failures;
+        break;
+      }
+      widget->resize(width, height);
+      widget->show();
+      RenderFrame(*widget);
+
+      FrameTimes times;
+      const double perFrame = static_cast<double>(rate) / fps;
+      double due = 0.0;
+      std::uint64_t seq = 0;
+      for (int f = 0; f < frames; ++f) {
+        due += perFrame;
+        const int n = static_cast<int>(due);
+        due -= n;
+        const auto t0 = common::time::NowMonotonicNs();
+        for (int i = 0; i < n; ++i, ++seq) {
+          // Shaped like a heartbeat miss storm: "[level][module] message" as the controller formats it.
+          append(QStringLiteral("[warning][heartbeat] missed heartbeat seq=%1 rtt_ms=%2 consecutive=%3")
+                     .arg(seq)
+                     .arg(0.5 + static_cast<double>(seq % 97) * 0.01, 0, 'f', 2)
+                     .arg(seq % 13));
+        }
+        flush();
+        RenderFrame(*widget);
+        times.add(common::time::NowMonotonicNs() - t0);
+      }
+      const double budgetNs = 1e9 / fps;
+      results.push_back(mode + " " + std::to_string(rate) + " " + times.describe() + " " +
+                        std::to_string(static_cast<int>(100.0 * times.meanNs() / budgetNs)) + " " +
+                        std::to_string(lines()));
+    }
+  }
+
+  common::log::Info("main", "mode lines_per_s p50_ms p99_ms max_ms mean_ms pct_of_frame_budget lines_shown");
+  for (const auto& r : results) common::log::Info("main", r);
+  return failures;
+}
+
+} // namespace uibench
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "AllocCounter.h"
+#include "Percentile.h"
+#include "common/config/Config.h"
+
+#include <QApplication>
+#include <QWidget>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uibench {
+
+// Shared with stress_test (bench_support). ThreadAllocations counts the calling thread only, i.e. the UI thread here.
+using bench::Percentile;
+using bench::ThreadAllocations;
+
+using common::config::ParseIntList;
+using common::config::ParseList;
+
+/** "12.34" milliseconds. */
+inline std::string Ms(double ns) {
+  const auto hundredths = static_cast<long long>(ns / 1e4 + 0.5);
+  const auto frac = hundredths % 100;
+  return std::to_string(hundredths / 100) + (frac < 10 ? ".0" : ".") + std::to_string(frac);
+}
+
+/** Per-frame durations with exact percentiles (a run is a few thousand frames at most). */
+class FrameTimes {
+public:
+  void add(std::uint64_t ns) { _ns.push_back(ns); }
+
+  std::uint64_t percentileNs(double p) const {
+    std::vector<std::uint64_t> sorted = _ns;
+    return Percentile(sorted, p);
+  }
+  std::uint64_t maxNs() const { return _ns.empty() ? 0 : *std::max_element(_ns.begin(), _ns.end()); }
+  double meanNs() const {
+    if (_ns.empty()) return 0.0;
+    double sum = 0.0;
+    for (const auto v : _ns) sum += static_cast<double>(v);
+    return sum / static_cast<double>(_ns.size());
+  }
+
+  /** "p50 p99 max mean" in ms. */
+  std::string describe() const {
+    return Ms(static_cast<double>(percentileNs(0.5))) + " " + Ms(static_cast<double>(percentileNs(0.99))) + " " +
+           Ms(static_cast<double>(maxNs())) + " " + Ms(meanNs());
+  }
+
+private:
+  std::vector<std::uint64_t> _ns;
+};
+
+/** Deterministic 0.5 Hz sine with a little LCG noise on the sensor channel. */
+class Signal {
+public:
+  explicit Signal(int rateHz) : _dt(1.0 / rateHz) {}
+  void next(double& position, double& sensor) {
+    position = std::sin(2.0 * 3.14159265358979 * 0.5 * _t);
+    _rng = _rng * 1664525u + 1013904223u;
+    sensor = position + (static_cast<double>(_rng >> 8) / 16777216.0 - 0.5) * 0.1;
+    _t += _dt;
+  }
+
+private:
+  double _dt;
+  double _t{0.0};
+  std::uint32_t _rng{1};
+};
+
+/** Runs pending layout/update events, then paints the widget synchronously: the work of one displayed frame. */
+inline void RenderFrame(QWidget& w) {
+  QApplication::processEvents();
+  w.repaint();
+}
+
+} // namespace uibench
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace common::config {
+class Config;
+}
+
+/**
+ * ui_bench scenarios. Each renders console widgets under the offscreen QPA platform, logs a results table and
+ * returns the number of failed cases.
+ */
+namespace uibench {
+
+/**
+ * Telemetry panel frame time and CPU (samples + series update + paint) per sample rate: per-sample QtCharts updates
+ * vs TelemetryChart (one replace() per frame) vs RasterPlot (cached static layers, blit scroll).
+ */
+int RunChartBench(const common::config::Config& cfg);
+
+/** TelemetryChart frame time zoomed out to seconds..minutes of history: raw replace() vs min/max vs LTTB decimation. */
+int RunChartZoomBench(const common::config::Config& cfg);
+
+/** LogPanel frame time during a log burst: per-line append + scroll vs one batched edit per frame (text / list view). */
+int RunLogPanelBench(const common::config::Config& cfg);
+
+/**
+ * Whole console (MainWindow: StatusStrip, TelemetryChart or RasterPlot, ReadoutStrip, LogPanel) per telemetry and log
+ * rate: update and paint time per frame and heap allocations per frame.
+ */
+int RunConsoleBench(const common::config::Config& cfg);
+
+} // namespace uibench
@@ -0,0 +1,62 @@
+#include <Poco/Util/Application.h>
+
+#include "UiBenchmarks.h"
+
+#include "common/config/ConfigPoco.h"
+#include "common/log/Log.h"
+
+#include <QApplication>
+
+#include <string>
+
+using Poco::Util::Application;
+
+/** Renders console widgets offscreen (QT_QPA_PLATFORM=offscreen unless already set) and times each frame. */
+class UiBenchApp : public Application {
+public:
+  UiBenchApp() = default;
+
+protected:
+  void initialize(Application& self) override {
+    loadConfiguration();
+    Application::initialize(self);
+    common::log::InitFromConfig(common::config::WrapPocoConfig(config()), this->commandName());
+  }
+
+  int main(const std::vector<std::string>& args) override {
+    (void)args;
+    common::log::SetThreadName("ui");
+    common::log::Info("main", "ui_bench starting");
+
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    std::string arg0 = commandName();
+    char* qtArgv[] = {arg0.data(), nullptr};
+    int qtArgc = 1;
+    QApplication qtApp(qtArgc, qtArgv);
+
+    const auto cfg = common::config::WrapPocoConfig(config());
+    const std::string scenario = config().getString("ui_bench.scenario", "chart");
+
+    int failures = 0;
+    if (scenario == "chart") {
+      failures = uibench::RunChartBench(cfg);
+    } else if (scenario == "chart_zoom") {
+      failures = uibench::RunChartZoomBench(cfg);
+    } else if (scenario == "log") {
+      failures = uibench::RunLogPanelBench(cfg);
+    } else if (scenario == "console") {
+      failures = uibench::RunConsoleBench(cfg);
+    } else {
+      common::log::Error("main", "unknown ui_bench.scenario: " + scenario);
+      return Application::EXIT_USAGE;
+    }
+
+    common::log::Info("main", "--- Results ---");
+    common::log::Info("main", "Failed cases: " + std::to_string(failures));
+    common::log::Info("main", "ui_bench exiting");
+    common::log::StopAsync();
+    return failures == 0 ? Application::EXIT_OK : Application::EXIT_SOFTWARE;
+  }
+};
+
+POCO_APP_MAIN(UiBenchApp)
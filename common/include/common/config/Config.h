@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace common::config {
 
@@ -17,6 +18,10 @@ class Config {
   int getInt(const std::string& key, int defaultValue) const;
   double getDouble(const std::string& key, double defaultValue) const;
   bool getBool(const std::string& key, bool defaultValue) const;
+  /** Comma-separated integers (e.g. "20,200,2000"); malformed entries are skipped. */
+  std::vector<int> getIntList(const std::string& key, const std::vector<int>& defaultValue) const;
+  /** Immediate subkeys of prefix (e.g. keys("rt") lists "lock_memory", "sensor", ... for [rt] and [rt.sensor]). */
+  std::vector<std::string> keys(const std::string& prefix) const;
 
   /** Wrap an opaque Poco config pointer. Prefer ConfigPoco.h WrapPocoConfig(AbstractConfiguration&) for type safety. */
   static Config WrapPocoConfig(void* pocoAbstractConfiguration);
@@ -28,4 +33,9 @@ class Config {
   explicit Config(std::unique_ptr<ConfigImpl> impl);
 };
 
+/** Parse "1,2,4,8" into integers; malformed entries are skipped. */
+std::vector<int> ParseIntList(const std::string& text);
+/** Parse "a,b,c" into tokens trimmed of spaces and tabs; empty entries are skipped. */
+std::vector<std::string> ParseList(const std::string& text);
+
 } // namespace common::config
@@ -4,6 +4,8 @@
 #include "common/control/ControlModels.h"
 #include "common/ipc/IpcClient.h"
 #include "common/ipc/Protocol.h"
+#include "common/rt/LatencyHistogram.h"
+#include "common/rt/PeriodicTimer.h"
 #include "common/sensor/SensorPipeline.h"
 #include "common/status/StatusSnapshot.h"
 
@@ -16,9 +18,19 @@ namespace common::control {
 
 class ControlLoop {
 public:
+  enum class Trigger {
+    /** Run right after each sensor publish (SensorPipeline::notifier()); rateHz only sets the actuator dt. */
+    Sensor,
+    /** Run on the PeriodicTimer grid at rateHz; ticks without a new sample are skipped. */
+    Timer,
+  };
+
   struct Params {
     int rateHz{200};
     std::chrono::milliseconds algoReadTimeout{1};
+    /** Loop pacing for Trigger::Timer (period is set from rateHz). A late tick is skipped rather than acting twice on one sample. */
+    common::rt::PeriodicTimer::Params timing{};
+    Trigger trigger{Trigger::Sensor};
   };
 
   ControlLoop(const common::sensor::SensorPipeline& sensor,
@@ -32,6 +44,10 @@ class ControlLoop {
   void stop();
 
   ControlCommand lastCommand() const;
+  /** Control thread wake-up jitter and overrun counters (Trigger::Timer). */
+  common::rt::PeriodicStats timing() const { return _timer.stats(); }
+  /** Sensor publish to control cycle start, per processed sample. */
+  common::rt::LatencySnapshot pickupLatency() const { return _pickup.snapshot(); }
 
 private:
   void run();
@@ -42,6 +58,8 @@ class ControlLoop {
   ActuatorSimulator& _actuator;
   common::status::StatusStore& _status;
   Params _params;
+  common::rt::PeriodicTimer _timer;
+  common::rt::LatencyHistogram _pickup;
 
   std::atomic<bool> _running{false};
   std::thread _thread;
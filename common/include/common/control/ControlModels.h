@@ -14,4 +14,12 @@ struct ActuatorState {
   double velocity{0.0};
 };
 
+/** One control step as the UI plots it: the sensor sample, the command applied for it and the resulting position. */
+struct TelemetrySample {
+  std::uint64_t seq{0};
+  double sensor{0.0};
+  double command{0.0};
+  double position{0.0};
+};
+
 } // namespace common::control
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace common::config {
+class Config;
+}
+
+namespace common::log::binary {
+
+/**
+ * Binary event log for kHz-rate numeric diagnostics: MRCD_BLOG("dds_status", "apply seq={} e2e_ns={}", seq, ns).
+ *
+ * Each call site registers its format string once and gets a 16-bit id. A record holds only the id, a monotonic
+ * timestamp and the raw 8-byte arguments. No text formatting happens in the process. Every thread appends to its own
+ * memory-mapped segment file without locks. The file system work happens on a "binlog_io" thread: it keeps one
+ * spare segment per thread created, mapped and pre-faulted, and trims full segments and deletes old ones. A roll
+ * swaps in the spare (one atomic exchange with binlog_io) and wakes that thread. Only the first record of each
+ * thread takes a lock and maps its first segment itself. The formats go to a small text table next to the
+ * segments. The log_decode tool turns segments back into text or CSV.
+ *
+ * Disk use is bounded twice over:
+ * - max_mb_per_s caps the process-wide rate at which new segments are mapped. A thread that fills its segment
+ *   while binlog_io holds back its spare drops (and counts) records until the spare is ready.
+ * - max_segments caps the files kept per thread; the oldest is deleted.
+ */
+struct BinaryLogParams {
+  bool enabled{false};
+  std::string dir{"binlog"};
+  std::size_t segmentBytes{4u << 20};
+  std::uint32_t maxSegments{16};
+  double maxMBps{32.0};
+};
+
+/** Reads [binlog] enabled, dir, segment_kb, max_segments, max_mb_per_s. */
+BinaryLogParams LoadBinaryLogParams(const common::config::Config& cfg);
+
+/** Creates params.dir, writes the format table and enables MRCD_BLOG. processName prefixes every file. */
+void StartBinaryLog(const BinaryLogParams& params, const std::string& processName);
+/**
+ * Disables MRCD_BLOG, closes the calling thread's segment and waits until binlog_io has trimmed it. Other threads
+ * close theirs when they exit or on their next record after a restart; their data is already in the mapped file.
+ */
+void StopBinaryLog();
+
+struct BinaryLogStats {
+  std::uint64_t records{0};
+  /** Records refused because no spare was ready (bandwidth cap, binlog_io behind) or a segment could not be mapped. */
+  std::uint64_t dropped{0};
+  std::uint64_t bytes{0};
+  std::uint64_t segments{0};
+};
+/** Totals since StartBinaryLog, over live and exited threads. */
+BinaryLogStats GetBinaryLogStats();
+
+/** On-disk layout, shared with BinaryLogReader. All integers are little-endian (the writer's native order). */
+namespace format {
+constexpr char kMagic[8] = {'M', 'R', 'C', 'D', 'B', 'L', 'G', '1'};
+constexpr std::uint32_t kVersion = 1;
+
+struct SegmentHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t headerBytes;
+  /** Wall clock (µs since epoch) and monotonic clock (ns) read together when the segment was opened. */
+  std::int64_t wallUs;
+  std::uint64_t monotonicNs;
+  std::uint32_t pid;
+  std::uint32_t threadIndex;
+  char threadName[24];
+};
+static_assert(sizeof(SegmentHeader) == 64, "segment header is 64 bytes");
+
+/** Followed by argc 8-byte arguments. id 0 marks the unused tail of a segment. */
+struct RecordHeader {
+  std::uint64_t monotonicNs;
+  std::uint16_t id;
+  std::uint16_t argc;
+  std::uint32_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 16, "record header is 16 bytes");
+
+/** Argument type codes stored in the format table. */
+constexpr char kUnsigned = 'u';
+constexpr char kSigned = 'i';
+constexpr char kFloat = 'f';
+constexpr char kBool = 'b';
+} // namespace format
+
+namespace detail {
+
+extern std::atomic<bool> gEnabled;
+
+inline bool Enabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+/** One per MRCD_BLOG call site (function-local static); id is assigned on first use. */
+struct Site {
+  const char* module;
+  const char* format;
+  std::atomic<std::uint16_t> id{0};
+};
+
+/** Assigns site.id (thread-safe, idempotent) and records the format with its argument types. */
+std::uint16_t Register(Site& site, const char* types);
+
+void Append(std::uint16_t id, const std::uint64_t* args, std::uint16_t argc);
+
+template <typename T>
+constexpr char TypeCode() {
+  using U = std::decay_t<T>;
+  static_assert(std::is_arithmetic_v<U> || std::is_enum_v<U>, "MRCD_BLOG arguments must be numbers, bools or enums");
+  if constexpr (std::is_same_v<U, bool>) return format::kBool;
+  else if constexpr (std::is_floating_point_v<U>) return format::kFloat;
+  else if constexpr (std::is_enum_v<U>) return std::is_signed_v<std::underlying_type_t<U>> ? format::kSigned : format::kUnsigned;
+  else return std::is_signed_v<U> ? format::kSigned : format::kUnsigned;
+}
+
+template <typename T>
+std::uint64_t Bits(T v) {
+  using U = std::decay_t<T>;
+  if constexpr (std::is_floating_point_v<U>) {
+    const double d = static_cast<double>(v);
+    std::uint64_t out;
+    std::memcpy(&out, &d, sizeof out);
+    return out;
+  } else if constexpr (std::is_enum_v<U>) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::underlying_type_t<U>>(v)));
+  } else if constexpr (std::is_signed_v<U>) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(v));
+  } else {
+    return static_cast<std::uint64_t>(v);
+  }
+}
+
+template <typename... Args>
+void Write(Site& site, const Args&... args) {
+  static constexpr char kTypes[] = {TypeCode<Args>()..., '\0'};
+  std::uint16_t id = site.id.load(std::memory_order_acquire);
+  if (id == 0) id = Register(site, kTypes);
+  const std::uint64_t raw[] = {Bits(args)...};
+  Append(id, raw, static_cast<std::uint16_t>(sizeof...(Args)));
+}
+
+} // namespace detail
+
+} // namespace common::log::binary
+
+/**
+ * Appends one binary record. format uses "{}" for each argument; module and format must be string literals.
+ * At least one argument is required. Disabled ([binlog] enabled=false), the cost is one relaxed load.
+ */
+#define MRCD_BLOG(module, format, ...)                                                                  \
+  do {                                                                                                  \
+    if (::common::log::binary::detail::Enabled()) {                                                     \
+      static ::common::log::binary::detail::Site mrcdBlogSite{module, format};                          \
+      ::common::log::binary::detail::Write(mrcdBlogSite, __VA_ARGS__);                                  \
+    }                                                                                                   \
+  } while (0)
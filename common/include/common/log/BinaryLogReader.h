@@ -0,0 +1,66 @@
+#pragma once
+
+#include "common/log/BinaryLog.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace common::log::binary {
+
+/** One registered call site, as written to <process>-<pid>.fmt. */
+struct FormatInfo {
+  std::uint16_t id{0};
+  std::string module;
+  /** One type code per argument (format::kUnsigned, kSigned, kFloat, kBool). */
+  std::string types;
+  std::string format;
+};
+
+struct DecodedRecord {
+  std::uint64_t monotonicNs{0};
+  /** Wall clock in ns since epoch, derived from the segment's clock pair. */
+  std::int64_t wallNs{0};
+  std::uint32_t pid{0};
+  std::string process;
+  std::string thread;
+  const FormatInfo* info{nullptr};
+  std::uint16_t id{0};
+  std::vector<std::uint64_t> args;
+};
+
+/**
+ * Offline reader for binary log segments. Add whole directories or single .seg files. Each segment's format
+ * table is found next to it by name. records() returns everything merged by monotonic timestamp.
+ */
+class BinaryLogReader {
+public:
+  /** Returns false (and sets error()) when the path is neither a directory nor a readable segment. */
+  bool add(const std::string& path);
+
+  const std::vector<DecodedRecord>& records();
+  const std::string& error() const { return _error; }
+  /** Records whose format id is missing from the table (e.g. the .fmt file was deleted). */
+  std::uint64_t unknownFormats() const { return _unknown; }
+
+private:
+  bool addSegment(const std::string& path);
+  const std::map<std::uint16_t, FormatInfo>* formatsFor(const std::string& tablePath);
+
+  std::map<std::string, std::map<std::uint16_t, FormatInfo>> _tables;
+  std::vector<DecodedRecord> _records;
+  bool _sorted{true};
+  std::uint64_t _unknown{0};
+  std::string _error;
+};
+
+/** "{}" placeholders replaced by the arguments; arguments without a placeholder are appended. */
+std::string FormatMessage(const DecodedRecord& r);
+/** "2026-01-31 12:00:00.123456 [process:pid][thread][module] message" in local time. */
+std::string ToTextLine(const DecodedRecord& r);
+
+std::string CsvHeader(std::size_t maxArgs);
+std::string ToCsvRow(const DecodedRecord& r, std::size_t maxArgs);
+
+} // namespace common::log::binary
@@ -1,12 +1,24 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace common::config {
 class Config;
 }
 
+namespace common::rt {
+template <typename T>
+class MpscQueue;
+}
+
 namespace common::log {
 
 enum class Level {
@@ -24,18 +36,167 @@ struct Context {
   std::string thread;
 };
 
+/** What to do when the async queue is full. */
+enum class OverflowPolicy {
+  /** Discard the record and count it (the caller never waits). */
+  Drop,
+  /** Wait (yielding) until the log thread frees a slot. */
+  Block
+};
+
+/**
+ * Segmented log files for channel=file; off while maxBytes and intervalMinutes are both 0. Output::file names the
+ * directory and the pattern: logs/app.log writes logs/app-<start>-<pid>-<n>.log. The writing thread only swaps in
+ * a file the "log_archive" thread opened in advance. Closing, gzip and deleting old segments all happen on that
+ * thread, so a rotation costs a log call no more than an ordinary line. If no spare file is ready yet, the current
+ * segment keeps growing until one is.
+ */
+struct FileRotation {
+  /** New segment past this size; 0 = no size limit. */
+  std::size_t maxBytes{0};
+  /** New segment after this long; 0 = no time limit. */
+  int intervalMinutes{0};
+  /** gzip each closed segment to <segment>.gz. */
+  bool compress{true};
+  /**
+   * Closed segments kept (oldest deleted first), counted over all runs that share Output::file, so give each
+   * process its own file. 0 = no limit.
+   */
+  int keepFiles{10};
+  /** Closed segments older than this are deleted; 0 = no age limit. */
+  int keepDays{0};
+
+  bool enabled() const { return maxBytes > 0 || intervalMinutes > 0; }
+};
+
+/** Where formatted lines go. channel: console | file | null. */
+struct Output {
+  std::string pattern{"%Y-%m-%d %H:%M:%S.%i [%p][%s] %t"};
+  std::string channel{"console"};
+  std::string file{"logs/app.log"};
+  FileRotation rotation;
+};
+
+/**
+ * Reads logging.pattern, logging.channel, logging.file and the rotation keys logging.rotate_mb,
+ * logging.rotate_minutes, logging.compress, logging.keep_files, logging.keep_days.
+ */
+Output LoadOutput(const common::config::Config& cfg);
+
+/**
+ * Asynchronous delivery: Write() copies the line into a fixed-size record in a lock-free MPSC queue and
+ * returns; the "log" thread formats records in batches and passes them to the Poco channel and the sink.
+ * Messages longer than the inline buffer carry one heap copy. Fatal waits until its record is written.
+ */
+struct AsyncParams {
+  bool enabled{false};
+  /** Queue capacity in records (rounded up to a power of two). */
+  std::size_t capacity{8192};
+  OverflowPolicy overflow{OverflowPolicy::Drop};
+};
+
+/** Reads logging.async, logging.queue_records (at least 64) and logging.overflow (drop | block). */
+AsyncParams LoadAsyncParams(const common::config::Config& cfg);
+
+struct AsyncStats {
+  std::uint64_t written{0};
+  std::uint64_t dropped{0};
+  /** Records that needed a heap copy (message longer than the inline buffer). */
+  std::uint64_t spilled{0};
+};
+
 void Init(const std::string& processName);
 
-/** Initialize logging from configuration. Reads logging.pattern, logging.level, logging.channel, logging.file. */
+/** Initialize logging from configuration: the LoadOutput() keys, logging.level and the LoadAsyncParams() keys. */
 void InitFromConfig(const common::config::Config& cfg, const std::string& loggerName);
 
+/**
+ * Replace the output channel. Pending async records are written to the old channel first and the log thread
+ * restarts with the same parameters (its stats reset). Not synchronized with concurrent synchronous writers:
+ * call at startup or while other threads are quiet.
+ */
+void SetOutput(const Output& output);
+
+/** Start (or restart with new parameters) the log thread; params.enabled=false is the same as StopAsync(). */
+void StartAsync(const AsyncParams& params);
+/** Write everything queued, stop the log thread and return to synchronous writes. Call before exit. */
+void StopAsync();
+/** Block until every record queued before the call has been written. No-op in synchronous mode. */
+void Flush();
+AsyncStats GetAsyncStats();
+
 void SetThreadName(const std::string& name);
+/** Name given to SetThreadName() on the calling thread (empty if never set). */
+const std::string& CurrentThreadName();
+
+namespace detail {
+/** Lowest level (as int) that reaches the logger or any sink; kept current by InitFromConfig, SetLevel and the sink registry. */
+extern std::atomic<int> gMinLevel;
+void WriteView(Level level, std::string_view module, std::string_view message);
+} // namespace detail
+
+/** True when a line at this level would reach the logger or a sink (one relaxed load). See LogMacros.h. */
+inline bool IsEnabled(Level level) {
+  return static_cast<int>(level) >= detail::gMinLevel.load(std::memory_order_relaxed);
+}
 
+/** Change the logger threshold at runtime (same effect as logging.level). */
+void SetLevel(Level level);
+
+/** Returns at once when !IsEnabled(level); the message has already been built by then, see LogMacros.h. */
 void Write(Level level, const std::string& module, const std::string& message);
 
-/** Optional sink: called from Write() on every log line (may be from any thread). Use for UI forwarding with QueuedConnection. */
-using Sink = std::function<void(Level level, const std::string& module, const std::string& message)>;
-void SetSink(Sink sink);
+/**
+ * Sink: called for every log line at or above its minLevel, whatever the logger threshold is. It runs on the log
+ * thread in async mode, otherwise on the writing thread, and must not add or remove sinks itself. module and
+ * message are only valid during the call.
+ */
+using Sink = std::function<void(Level level, std::string_view module, std::string_view message)>;
+using SinkId = std::uint64_t;
+
+/**
+ * Sink registry. The list is immutable and replaced as a whole (RCU style) on AddSink/RemoveSink, so delivering
+ * a line takes no lock and copies no std::function; a replaced list is freed by whichever registry update or
+ * departing writer first sees no writer inside it.
+ */
+SinkId AddSink(Sink sink, Level minLevel = Level::Trace);
+void RemoveSink(SinkId id);
+/** Replaces the sink installed by the previous SetSink() call (an empty sink removes it). */
+void SetSink(Sink sink, Level minLevel = Level::Trace);
+
+/** One buffered line, already formatted as "[LEVEL][module] message". */
+struct LogLine {
+  Level level{Level::Info};
+  std::string text;
+};
+
+/**
+ * Collects lines for a consumer that takes them in batches, e.g. a UI that drains once per frame instead of
+ * receiving one queued event per line. Register with AddSink(buffer->sink(), level). Writers format each line
+ * into a fixed-size slot of a bounded lock-free MPSC ring (no lock, no allocation); when capacity lines are
+ * waiting, new lines are dropped and counted. Lines longer than kLineBytes are cut short.
+ */
+class BufferedSink : public std::enable_shared_from_this<BufferedSink> {
+public:
+  static constexpr std::size_t kLineBytes = 240;
+
+  explicit BufferedSink(std::size_t capacity = 4096);
+  ~BufferedSink();
+
+  /** A Sink that appends to this buffer (and keeps it alive). */
+  Sink sink();
+  /** Appends every waiting line to out; returns how many. One consumer thread. */
+  std::size_t drain(std::vector<LogLine>& out);
+  std::uint64_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+  struct Record;
+
+  void push(Level level, std::string_view module, std::string_view message);
+
+  std::unique_ptr<common::rt::MpscQueue<Record>> _queue;
+  std::atomic<std::uint64_t> _dropped{0};
+};
 
 void Trace(const std::string& module, const std::string& message);
 void Debug(const std::string& module, const std::string& message);
@@ -45,5 +206,7 @@ void Error(const std::string& module, const std::string& message);
 void Fatal(const std::string& module, const std::string& message);
 
 std::string LevelToString(Level level);
+/** Parses a logging.level value (trace, debug, information, warning, error, fatal; case-insensitive, also INFO/WARN). */
+Level LevelFromString(const std::string& name, Level fallback = Level::Info);
 
 } // namespace common::log
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "common/log/Log.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace common::log {
+
+/**
+ * Fixed-capacity line builder on the caller's stack; append() never allocates. Lines longer than kCapacity are
+ * cut and end with "...". Accepts strings, string_views, C strings, chars, bools ("true"/"false"), integers
+ * and floating point (printf %g).
+ */
+class LineBuffer {
+public:
+  static constexpr std::size_t kCapacity = 256;
+
+  void append(std::string_view s) {
+    const std::size_t room = kCapacity - _len;
+    const std::size_t n = s.size() < room ? s.size() : room;
+    std::memcpy(_buf + _len, s.data(), n);
+    _len += n;
+    if (n < s.size()) truncate();
+  }
+  void append(const char* s) { append(std::string_view(s)); }
+  void append(const std::string& s) { append(std::string_view(s)); }
+  void append(char c) { append(std::string_view(&c, 1)); }
+  void append(bool b) { append(b ? std::string_view("true") : std::string_view("false")); }
+
+  template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, int> = 0>
+  void append(T v) {
+    char tmp[24];
+    const auto r = std::to_chars(tmp, tmp + sizeof tmp, v);
+    append(std::string_view(tmp, static_cast<std::size_t>(r.ptr - tmp)));
+  }
+
+  template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+  void append(T v) {
+    char tmp[32];
+    const int n = std::snprintf(tmp, sizeof tmp, "%g", static_cast<double>(v));
+    if (n > 0) append(std::string_view(tmp, static_cast<std::size_t>(n) < sizeof tmp ? static_cast<std::size_t>(n) : sizeof tmp - 1));
+  }
+
+  std::string_view view() const { return std::string_view(_buf, _len); }
+  bool truncated() const { return _truncated; }
+
+private:
+  void truncate() {
+    std::memcpy(_buf + kCapacity - 3, "...", 3);
+    _len = kCapacity;
+    _truncated = true;
+  }
+
+  char _buf[kCapacity];
+  std::size_t _len{0};
+  bool _truncated{false};
+};
+
+namespace detail {
+
+template <typename... Args>
+void WriteLazy(Level level, std::string_view module, const Args&... args) {
+  LineBuffer line;
+  (line.append(args), ...);
+  WriteView(level, module, line.view());
+}
+
+} // namespace detail
+
+} // namespace common::log
+
+/**
+ * Level-checked logging: MRCD_LOG_DEBUG("heartbeat", "pong OK seq=", seq, " misses=", misses).
+ *
+ * The arguments are neither evaluated nor formatted unless IsEnabled(level); an enabled line is concatenated
+ * into a LineBuffer on the stack and queued (async) without touching the heap. Synchronous writes hand sinks a
+ * view of that buffer; only a line the Poco logger itself accepts is copied, into a Poco::Message (heap).
+ * With MRCD_LOG_STRIP_DEBUG defined (CMake MRCD_LOG_STRIP_DEBUG, Release/MinSizeRel) the Trace and Debug
+ * macros compile to nothing, but their arguments are still type-checked.
+ */
+#define MRCD_LOG(level, module, ...)                                                                             \
+  do {                                                                                                           \
+    if (::common::log::IsEnabled(level)) ::common::log::detail::WriteLazy(level, module, __VA_ARGS__);          \
+  } while (0)
+
+#define MRCD_LOG_DISCARD(level, module, ...) \
+  ((void)sizeof((::common::log::detail::WriteLazy(level, module, __VA_ARGS__), 0)))
+
+#if defined(MRCD_LOG_STRIP_DEBUG)
+#define MRCD_LOG_TRACE(module, ...) MRCD_LOG_DISCARD(::common::log::Level::Trace, module, __VA_ARGS__)
+#define MRCD_LOG_DEBUG(module, ...) MRCD_LOG_DISCARD(::common::log::Level::Debug, module, __VA_ARGS__)
+#else
+#define MRCD_LOG_TRACE(module, ...) MRCD_LOG(::common::log::Level::Trace, module, __VA_ARGS__)
+#define MRCD_LOG_DEBUG(module, ...) MRCD_LOG(::common::log::Level::Debug, module, __VA_ARGS__)
+#endif
+#define MRCD_LOG_INFO(module, ...) MRCD_LOG(::common::log::Level::Info, module, __VA_ARGS__)
+#define MRCD_LOG_WARN(module, ...) MRCD_LOG(::common::log::Level::Warn, module, __VA_ARGS__)
+#define MRCD_LOG_ERROR(module, ...) MRCD_LOG(::common::log::Level::Error, module, __VA_ARGS__)
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "common/log/Log.h"
+
+#include <Poco/Channel.h>
+#include <Poco/Message.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common::log {
+
+/**
+ * Poco channel behind channel=file with rotation enabled (see FileRotation). log() appends the line to the
+ * current segment. At a size or time boundary it swaps in the spare segment and hands the full one to the
+ * "log_archive" thread. That thread closes and compresses full segments, opens the next spare and applies
+ * keepFiles/keepDays. The current segment is left uncompressed when the channel closes.
+ */
+class RotatingFileChannel : public Poco::Channel {
+public:
+  RotatingFileChannel(const std::string& path, const FileRotation& rotation);
+
+  /** Opens the first segment and starts the archive thread; log() calls it when needed. */
+  void open() override;
+  /** Archives every full segment, closes the current one and stops the archive thread. */
+  void close() override;
+  void log(const Poco::Message& msg) override;
+
+protected:
+  ~RotatingFileChannel() override;
+
+private:
+  struct Segment {
+    std::FILE* file{nullptr};
+    std::string path;
+  };
+
+  /** Caller holds _mu. */
+  std::string nextSegmentPath();
+  /** Caller holds _mu. */
+  void rotateLocked(std::int64_t nowUs);
+  void archive(Segment& seg);
+  /** Applies keepFiles/keepDays to closed segments; current and spare are never deleted. */
+  void purge(const std::string& current, const std::string& spare);
+  void run();
+
+  const std::string _dir;
+  const std::string _stem;
+  const std::string _ext;
+  const FileRotation _rotation;
+
+  std::mutex _mu;
+  std::condition_variable _cv;
+  Segment _current;
+  std::uint64_t _bytes{0};
+  std::int64_t _rotateAtUs{0};
+  Segment _spare;
+  std::vector<Segment> _full;
+  std::string _runTag;  // <start>-<pid>, fixed per open()
+  std::uint32_t _nextSegment{0};
+  bool _running{false};
+  std::thread _thread;
+};
+
+} // namespace common::log
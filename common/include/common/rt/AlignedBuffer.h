@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace common::rt {
+
+/** Owning, value-initialized array of trivially copyable T aligned to Align bytes (default: one cache line). */
+template <typename T, std::size_t Align = 64>
+class AlignedBuffer {
+  static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                "AlignedBuffer holds trivially copyable, trivially destructible element types only");
+
+public:
+  AlignedBuffer() = default;
+
+  explicit AlignedBuffer(std::size_t count)
+      : _data(count ? static_cast<T*>(::operator new[](count * sizeof(T), std::align_val_t{Align})) : nullptr),
+        _count(count) {
+    if (_data) std::uninitialized_value_construct_n(_data.get(), count);
+  }
+
+  T* data() { return _data.get(); }
+  const T* data() const { return _data.get(); }
+  std::size_t size() const { return _count; }
+
+  T& operator[](std::size_t i) { return _data.get()[i]; }
+  const T& operator[](std::size_t i) const { return _data.get()[i]; }
+
+private:
+  struct Deleter {
+    void operator()(T* p) const { ::operator delete[](p, std::align_val_t{Align}); }
+  };
+
+  std::unique_ptr<T, Deleter> _data;
+  std::size_t _count{0};
+};
+
+} // namespace common::rt
@@ -1,17 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <mutex>
 #include <utility>
 
 namespace common::rt {
 
+/**
+ * Mutex-guarded latest-value channel. One writer fills back() and calls publishSwap(); back() is only ever touched
+ * by that writer, and readers see the published buffer only through readSnapshot(), which copies under the lock.
+ * (There is no unlocked front() accessor: a reference to the front buffer would race with the next swap.)
+ */
 template <typename T>
 class DoubleBufferChannel {
 public:
   DoubleBufferChannel() = default;
 
+  /** Writer-only. */
   T& back() { return _back; }
-  const T& front() const { return _front; }
 
   void publishSwap() {
     std::lock_guard<std::mutex> lk(_mu);
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace common::rt {
+
+/**
+ * kLanes independent xoshiro256+ generators with state in structure-of-arrays form, so one step
+ * of all lanes is a straight-line loop the compiler vectorizes. Lanes are seeded from one 64-bit
+ * seed through splitmix64; the output sequence is fully determined by the seed.
+ */
+class LaneXoshiro {
+public:
+  static constexpr std::size_t kLanes = 8;
+
+  explicit LaneXoshiro(std::uint64_t seed) {
+    std::uint64_t x = seed;
+    for (std::size_t w = 0; w < 4; ++w) {
+      for (std::size_t l = 0; l < kLanes; ++l) _s[w][l] = SplitMix64(x);
+    }
+  }
+
+  /** One 64-bit output per lane. */
+  void next(std::uint64_t (&out)[kLanes]) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      out[l] = _s[0][l] + _s[3][l];
+      const std::uint64_t t = _s[1][l] << 17;
+      _s[2][l] ^= _s[0][l];
+      _s[3][l] ^= _s[1][l];
+      _s[1][l] ^= _s[2][l];
+      _s[0][l] ^= _s[3][l];
+      _s[2][l] ^= t;
+      _s[3][l] = (_s[3][l] << 45) | (_s[3][l] >> 19);
+    }
+  }
+
+  static std::uint64_t SplitMix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+private:
+  alignas(64) std::uint64_t _s[4][kLanes];
+};
+
+inline double BitsToDouble(std::uint64_t bits) {
+  double d;
+  std::memcpy(&d, &bits, sizeof d);
+  return d;
+}
+
+inline std::uint64_t DoubleToBits(double d) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &d, sizeof bits);
+  return bits;
+}
+
+/**
+ * Branch-free Box-Muller over one lane block: z0/z1 receive two independent standard normals per lane.
+ * ln and sin/cos use short polynomials after range reduction (abs error < 1e-10), which keeps the
+ * loop free of libm calls so it vectorizes.
+ */
+inline void GaussianPairs(LaneXoshiro& rng, double (&z0)[LaneXoshiro::kLanes], double (&z1)[LaneXoshiro::kLanes]) {
+  constexpr std::size_t L = LaneXoshiro::kLanes;
+  constexpr std::uint64_t kOneBits = 0x3FF0000000000000ull;   // 1.0
+  constexpr std::uint64_t kMagicBits = 0x4330000000000000ull; // 2^52
+  constexpr double kMagic = 4503599627370496.0;
+  constexpr double kLn2 = 0.69314718055994530942;
+  constexpr double kHalfPi = 1.57079632679489661923;
+  constexpr double kInvSqrt2 = 0.70710678118654752440;
+
+  std::uint64_t a[L];
+  std::uint64_t b[L];
+  rng.next(a);
+  rng.next(b);
+
+  for (std::size_t l = 0; l < L; ++l) {
+    // Integer-to-double conversions go through exponent bits only (no cvtsi2sd), which keeps the loop
+    // in vector registers. u in (0, 1]; split into m in [sqrt(1/2), sqrt(2)) and exponent e.
+    const double u = 2.0 - BitsToDouble((a[l] >> 12) | kOneBits);
+    const std::uint64_t ubits = DoubleToBits(u);
+    const double e0 = BitsToDouble((ubits >> 52) | kMagicBits) - kMagic - 1023.0;
+    const std::uint64_t mant = ubits & 0x000FFFFFFFFFFFFFull;
+    double m = BitsToDouble(mant | kOneBits);
+    // big = (m > sqrt(2)) as 0.0/1.0, from the mantissa bits without a compare-and-branch.
+    const double big = BitsToDouble((0 - ((0x0006A09E667F3BCCull - mant) >> 63)) & kOneBits);
+    m *= 1.0 - 0.5 * big;
+    const double e = e0 + big;
+    // ln m = 2 atanh(z), |z| < 0.172
+    const double z = (m - 1.0) / (m + 1.0);
+    const double z2 = z * z;
+    const double lnm =
+        2.0 * z * (1.0 + z2 * (1.0 / 3 + z2 * (1.0 / 5 + z2 * (1.0 / 7 + z2 * (1.0 / 9 + z2 * (1.0 / 11 + z2 * (1.0 / 13)))))));
+    const double lnu = e * kLn2 + lnm;
+    // r = sqrt(x) as x * rsqrt(x): bit-level estimate plus four Newton steps (libm sqrt carries an errno branch).
+    const double x = -2.0 * lnu;
+    double y = BitsToDouble(0x5FE6EB50C7B537A9ull - (DoubleToBits(x) >> 1));
+    y *= 1.5 - 0.5 * x * y * y;
+    y *= 1.5 - 0.5 * x * y * y;
+    y *= 1.5 - 0.5 * x * y * y;
+    y *= 1.5 - 0.5 * x * y * y;
+    const double r = x * y;
+
+    // Angle = quadrant * pi/2 + pi/4 + t, t in [-pi/4, pi/4): 2 bits pick the quadrant, 51 the offset.
+    const double q0 = BitsToDouble((0 - (b[l] & 1u)) & kOneBits);
+    const double q1 = BitsToDouble((0 - ((b[l] >> 1) & 1u)) & kOneBits);
+    const double t = (BitsToDouble((b[l] >> 12) | kOneBits) - 1.5) * kHalfPi;
+    const double t2 = t * t;
+    const double st = t * (1.0 - t2 / 6 * (1.0 - t2 / 20 * (1.0 - t2 / 42 * (1.0 - t2 / 72 * (1.0 - t2 / 110)))));
+    const double ct = 1.0 - t2 / 2 * (1.0 - t2 / 12 * (1.0 - t2 / 30 * (1.0 - t2 / 56 * (1.0 - t2 / 90 * (1.0 - t2 / 132)))));
+    // Rotate by pi/4, then by q0 * pi/2 and q1 * pi.
+    const double c45 = (ct - st) * kInvSqrt2;
+    const double s45 = (st + ct) * kInvSqrt2;
+    const double sign = 1.0 - 2.0 * q1;
+    const double c = sign * ((1.0 - q0) * c45 - q0 * s45);
+    const double s = sign * ((1.0 - q0) * s45 + q0 * c45);
+
+    z0[l] = r * c;
+    z1[l] = r * s;
+  }
+}
+
+} // namespace common::rt
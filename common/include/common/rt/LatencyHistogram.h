@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace common::rt {
+
+/** "12.3": nanoseconds as microseconds with one decimal, for latency log lines. */
+inline std::string FormatUs(std::uint64_t ns) {
+  const auto tenths = (ns + 50) / 100;
+  return std::to_string(tenths / 10) + "." + std::to_string(tenths % 10);
+}
+
+/** Point-in-time copy of a LatencyHistogram. */
+struct LatencySnapshot {
+  /** Bucket 0: < 1 us; bucket i: [2^(i-1), 2^i) us; the last bucket is open-ended (>= ~16 ms). */
+  static constexpr std::size_t kBuckets = 16;
+
+  std::uint64_t count{0};
+  std::uint64_t sumNs{0};
+  std::uint64_t maxNs{0};
+  std::array<std::uint64_t, kBuckets> buckets{};
+
+  static std::size_t BucketFor(std::uint64_t ns) {
+    std::size_t b = 0;
+    for (std::uint64_t us = ns / 1000; us > 0 && b + 1 < kBuckets; us >>= 1) ++b;
+    return b;
+  }
+  static std::uint64_t BucketUpperNs(std::size_t b) { return (std::uint64_t{1} << b) * 1000; }
+
+  double meanNs() const { return count ? static_cast<double>(sumNs) / static_cast<double>(count) : 0.0; }
+
+  /** Adds another histogram's samples, e.g. to combine per-thread histograms (each has a single writer). */
+  void merge(const LatencySnapshot& o) {
+    count += o.count;
+    sumNs += o.sumNs;
+    if (o.maxNs > maxNs) maxNs = o.maxNs;
+    for (std::size_t b = 0; b < kBuckets; ++b) buckets[b] += o.buckets[b];
+  }
+
+  /** Upper bound of the bucket holding the p-quantile (p in [0,1]), capped at maxNs. */
+  std::uint64_t percentileNs(double p) const {
+    if (count == 0) return 0;
+    const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b + 1 < kBuckets; ++b) {
+      seen += buckets[b];
+      if (seen >= rank) return BucketUpperNs(b) < maxNs ? BucketUpperNs(b) : maxNs;
+    }
+    return maxNs;
+  }
+
+  /** "<1us:n <2us:n ... >=16384us:n" over non-empty buckets. */
+  std::string describe() const {
+    std::string out;
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+      if (buckets[b] == 0) continue;
+      if (!out.empty()) out += ' ';
+      out += b + 1 < kBuckets ? "<" + std::to_string(BucketUpperNs(b) / 1000)
+                              : ">=" + std::to_string(BucketUpperNs(b - 1) / 1000);
+      out += "us:" + std::to_string(buckets[b]);
+    }
+    return out;
+  }
+};
+
+/**
+ * Log2-bucketed latency histogram with count/sum/max. One writer thread records; snapshot() may run on
+ * any thread (fields are read individually, so a snapshot can straddle a record()).
+ */
+class LatencyHistogram {
+public:
+  void record(std::uint64_t ns) {
+    Bump(_count, 1);
+    Bump(_sumNs, ns);
+    if (ns > _maxNs.load(std::memory_order_relaxed)) _maxNs.store(ns, std::memory_order_relaxed);
+    Bump(_buckets[LatencySnapshot::BucketFor(ns)], 1);
+  }
+
+  LatencySnapshot snapshot() const {
+    LatencySnapshot s;
+    s.count = _count.load(std::memory_order_relaxed);
+    s.sumNs = _sumNs.load(std::memory_order_relaxed);
+    s.maxNs = _maxNs.load(std::memory_order_relaxed);
+    for (std::size_t b = 0; b < LatencySnapshot::kBuckets; ++b) s.buckets[b] = _buckets[b].load(std::memory_order_relaxed);
+    return s;
+  }
+
+private:
+  // Single writer: load + store instead of a locked read-modify-write.
+  static void Bump(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+    a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+  }
+
+  std::atomic<std::uint64_t> _count{0};
+  std::atomic<std::uint64_t> _sumNs{0};
+  std::atomic<std::uint64_t> _maxNs{0};
+  std::array<std::atomic<std::uint64_t>, LatencySnapshot::kBuckets> _buckets{};
+};
+
+} // namespace common::rt
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace common::rt {
+
+/**
+ * Sliding-window extremum over the last `window` indices (monotonic deque on a fixed ring).
+ * Compare = std::less<double> tracks the minimum, std::greater<double> the maximum.
+ * push() is amortized O(1) and never allocates; value() is O(1).
+ */
+template <typename Compare>
+class MonotonicWindow {
+public:
+  explicit MonotonicWindow(std::size_t window) : _window(window ? window : 1), _buf(_window + 1) {}
+
+  void push(std::uint64_t index, double value) {
+    while (_size > 0 && !Compare{}(at(_size - 1).value, value)) --_size;
+    at(_size++) = Entry{index, value};
+    while (at(0).index + _window <= index) {
+      _head = (_head + 1) % _buf.size();
+      --_size;
+    }
+  }
+
+  bool empty() const { return _size == 0; }
+  double value() const { return _size ? at(0).value : 0.0; }
+  std::size_t window() const { return _window; }
+
+  void clear() {
+    _head = 0;
+    _size = 0;
+  }
+
+private:
+  struct Entry {
+    std::uint64_t index{0};
+    double value{0.0};
+  };
+
+  Entry& at(std::size_t i) { return _buf[(_head + i) % _buf.size()]; }
+  const Entry& at(std::size_t i) const { return _buf[(_head + i) % _buf.size()]; }
+
+  std::size_t _window;
+  std::vector<Entry> _buf;
+  std::size_t _head{0};
+  std::size_t _size{0};
+};
+
+using MinWindow = MonotonicWindow<std::less<double>>;
+using MaxWindow = MonotonicWindow<std::greater<double>>;
+
+} // namespace common::rt
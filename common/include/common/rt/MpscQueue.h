@@ -0,0 +1,84 @@
+#pragma once
+
+#include "common/rt/PowerOfTwo.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace common::rt {
+
+/**
+ * Bounded lock-free multi-producer / single-consumer queue (Vyukov's per-cell sequence scheme).
+ *
+ * Elements are built and consumed in place: tryEmplace(fill) hands the producer a free cell, and
+ * tryConsume(consume) hands the consumer the oldest full cell. Neither side allocates or copies the
+ * element. A producer claims a cell with one CAS on the shared enqueue position; a full queue returns
+ * false at once. Capacity is rounded up to a power of two. T must be default-constructible; cells are
+ * reused, so fill() must set every field it relies on.
+ */
+template <typename T>
+class MpscQueue {
+public:
+  explicit MpscQueue(std::size_t capacity) : _mask(RoundUpPow2(capacity) - 1), _cells(new Cell[_mask + 1]) {
+    for (std::size_t i = 0; i <= _mask; ++i) _cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  std::size_t capacity() const { return _mask + 1; }
+
+  /** Producer side (any thread). Returns false without calling fill when the queue is full. */
+  template <typename Fill>
+  bool tryEmplace(Fill&& fill) {
+    std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = _cells[pos & _mask];
+      const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          fill(cell.value);
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /** Consumer side (one thread). Returns false when the oldest cell is empty or still being filled. */
+  template <typename Consume>
+  bool tryConsume(Consume&& consume) {
+    const std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+    Cell& cell = _cells[pos & _mask];
+    if (cell.seq.load(std::memory_order_acquire) != pos + 1) return false;
+    consume(cell.value);
+    cell.seq.store(pos + _mask + 1, std::memory_order_release);
+    _dequeuePos.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Elements claimed by producers so far (monotonic). */
+  std::size_t enqueued() const { return _enqueuePos.load(std::memory_order_acquire); }
+  /** Elements consumed so far (monotonic); enqueued() - consumed() is the current depth. */
+  std::size_t consumed() const { return _dequeuePos.load(std::memory_order_acquire); }
+
+private:
+  struct alignas(64) Cell {
+    std::atomic<std::size_t> seq{0};
+    T value{};
+  };
+
+  const std::size_t _mask;
+  std::unique_ptr<Cell[]> _cells;
+  alignas(64) std::atomic<std::size_t> _enqueuePos{0};
+  alignas(64) std::atomic<std::size_t> _dequeuePos{0};
+};
+
+} // namespace common::rt
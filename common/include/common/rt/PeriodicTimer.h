@@ -0,0 +1,122 @@
+#pragma once
+
+#include "common/rt/LatencyHistogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace common::config {
+class Config;
+}
+
+namespace common::rt {
+
+/** What wait() does when the previous cycle ran past the next deadline. */
+enum class OverrunPolicy {
+  /** Drop the missed activations and wait for the next deadline on the original grid. */
+  Skip,
+  /** Start late cycles immediately, keeping the grid, until caught up (re-phases past maxCatchUp periods). */
+  CatchUp,
+  /** Start immediately and move the grid so the next deadline is one period from now. */
+  Rephase,
+};
+
+/** How wait() reaches the deadline: trade CPU for wake-up determinism per thread. */
+enum class TimerMode {
+  /** Absolute sleep to the deadline; jitter is bounded by kernel timer slack and scheduling (~50-100 us). */
+  Sleep,
+  /** Sleep until spinMargin before the deadline, then spin on the monotonic clock. */
+  Hybrid,
+  /** Spin for the whole period (one core per loop). */
+  Spin,
+};
+
+const char* ToString(OverrunPolicy policy);
+/** "skip" / "catchup" / "rephase" (case-sensitive); anything else yields fallback. */
+OverrunPolicy ParseOverrunPolicy(const std::string& text, OverrunPolicy fallback);
+
+const char* ToString(TimerMode mode);
+/** "sleep" / "hybrid" / "spin" (case-sensitive); anything else yields fallback. */
+TimerMode ParseTimerMode(const std::string& text, TimerMode fallback);
+
+struct PeriodicStats {
+  std::uint64_t cycles{0};
+  std::uint64_t overruns{0};
+  std::uint64_t skippedCycles{0};
+  /** Wake-up latency after a slept-to deadline (cycles that started late on overrun are not included). */
+  LatencySnapshot jitter;
+  std::uint64_t jitterLastNs{0};
+  /** Worst lateness seen at an overrun. */
+  std::uint64_t overrunMaxNs{0};
+  /** Time spent spinning toward deadlines (Hybrid/Spin), i.e. CPU burnt for determinism. */
+  std::uint64_t spinNs{0};
+};
+
+std::string Describe(const PeriodicStats& stats);
+
+/**
+ * Fixed-rate loop pacing on absolute deadlines: deadline k is start + k * period, independent of how long
+ * each cycle took, so oversleep does not accumulate. Sleeps with clock_nanosleep(TIMER_ABSTIME) on Linux,
+ * std::this_thread::sleep_until elsewhere; TimerMode::Hybrid/Spin finish the wait by spinning.
+ *
+ * wait() and start() belong to the loop thread; stats() may be called from any thread.
+ */
+class PeriodicTimer {
+public:
+  struct Params {
+    std::chrono::nanoseconds period{std::chrono::milliseconds(5)};
+    OverrunPolicy overrun{OverrunPolicy::Skip};
+    /** CatchUp only: lag, in periods, beyond which the grid is re-phased instead of bursting. */
+    std::uint32_t maxCatchUp{8};
+    TimerMode mode{TimerMode::Sleep};
+    /** Hybrid only: how early to wake before the deadline and start spinning. */
+    std::chrono::nanoseconds spinMargin{std::chrono::microseconds(200)};
+    /** Linux: PR_SET_TIMERSLACK for the loop thread, applied in start(); 0 keeps the default (50 us). */
+    std::chrono::nanoseconds timerSlack{0};
+  };
+
+  explicit PeriodicTimer(Params params);
+
+  static std::chrono::nanoseconds PeriodForRate(int rateHz);
+  /** params with period set to 1 / rateHz. */
+  static Params WithRate(Params params, int rateHz);
+
+  /** Anchor the grid at now (and apply timerSlack to the calling thread); the first wait() returns one period later. */
+  void start();
+
+  /** Block until the start of the next cycle. Returns the number of skipped activations (Skip policy). */
+  std::uint64_t wait();
+
+  std::chrono::nanoseconds period() const { return _params.period; }
+  TimerMode mode() const { return _params.mode; }
+  /** Nominal start of the current cycle, steady_clock ns. */
+  std::int64_t deadlineNs() const { return _deadlineNs; }
+
+  PeriodicStats stats() const;
+
+private:
+  void sleepToDeadline();
+  void recordWake(std::uint64_t jitterNs);
+
+  Params _params;
+  std::int64_t _deadlineNs{0};
+
+  std::atomic<std::uint64_t> _cycles{0};
+  std::atomic<std::uint64_t> _overruns{0};
+  std::atomic<std::uint64_t> _skipped{0};
+  LatencyHistogram _jitter;
+  std::atomic<std::uint64_t> _jitterLastNs{0};
+  std::atomic<std::uint64_t> _overrunMaxNs{0};
+  std::atomic<std::uint64_t> _spinNs{0};
+};
+
+/**
+ * Timer settings for the loop configured under prefix: prefix.overrun, prefix.timer_mode,
+ * prefix.spin_margin_us, prefix.timer_slack_us. The period is left for the caller to set from its rate.
+ */
+PeriodicTimer::Params LoadTimerParams(const common::config::Config& cfg, const std::string& prefix,
+                                      OverrunPolicy defaultOverrun);
+
+} // namespace common::rt
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace common::rt {
+
+/** Smallest power of two >= n, and at least 2: ring capacity, so an index maps to a slot with a mask. */
+inline std::size_t RoundUpPow2(std::size_t n) {
+  std::size_t p = 2;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+} // namespace common::rt
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if !defined(__linux__)
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace common::rt {
+
+/**
+ * Single-publisher sequence counter that consumers can block on. On Linux publish() costs one atomic increment
+ * plus a load when nobody waits, and one futex wake with waiters; elsewhere it also takes an uncontended mutex to
+ * check for waiters and notifies a condition variable.
+ * Any number of consumers may wait concurrently, each with its own deadline.
+ */
+class SeqNotifier {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /** Publisher side: make seq visible and wake all waiters. */
+  void publish(std::uint64_t seq);
+
+  std::uint64_t current() const { return _seq.load(std::memory_order_acquire); }
+  /** steady_clock ns of the latest publish() (for publish-to-wakeup latency). */
+  std::uint64_t lastPublishNs() const { return _publishNs.load(std::memory_order_acquire); }
+
+  /** Block until current() != lastSeen or deadline passes; returns current() either way. */
+  std::uint64_t waitNewer(std::uint64_t lastSeen, Clock::time_point deadline) const;
+
+private:
+  std::atomic<std::uint64_t> _seq{0};
+  std::atomic<std::uint64_t> _publishNs{0};
+  /** Futex word: bumped on every publish so a waiter that raced a publish returns immediately. */
+  mutable std::atomic<std::uint32_t> _epoch{0};
+  mutable std::atomic<std::uint32_t> _waiters{0};
+#if !defined(__linux__)
+  mutable std::mutex _mu;
+  mutable std::condition_variable _cv;
+#endif
+};
+
+} // namespace common::rt
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common/rt/CpuRelax.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace common::rt {
+
+/**
+ * Single-writer / multi-reader snapshot channel guarded by a sequence lock.
+ *
+ * Same usage as DoubleBufferChannel: the writer fills back() and calls publishSwap(); readers call
+ * readSnapshot(). The writer never waits (publish is one memcpy between two counter stores); readers
+ * retry only when they overlap a publish. There is no front() accessor because the published slot
+ * can change under a reference. back() keeps whatever the writer last wrote; writers are expected
+ * to overwrite every field before publishing.
+ */
+template <typename T>
+class SeqlockChannel {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqlockChannel requires a trivially copyable T");
+
+public:
+  SeqlockChannel() = default;
+
+  T& back() { return _back; }
+
+  void publishSwap() {
+    const std::uint64_t s = _seq.load(std::memory_order_relaxed);
+    _seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&_front), static_cast<const void*>(&_back), sizeof(T));
+    _seq.store(s + 2, std::memory_order_release);
+  }
+
+  T readSnapshot() const {
+    T out;
+    for (;;) {
+      const std::uint64_t s0 = _seq.load(std::memory_order_acquire);
+      if ((s0 & 1u) == 0) {
+        std::memcpy(static_cast<void*>(&out), static_cast<const void*>(&_front), sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) == s0) return out;
+      }
+      CpuRelax();
+    }
+  }
+
+  std::uint64_t publishCount() const { return _seq.load(std::memory_order_acquire) / 2; }
+
+private:
+  alignas(64) std::atomic<std::uint64_t> _seq{0};
+  T _front{};
+  // Writer-private staging buffer on its own cache line so filling it does not disturb readers.
+  alignas(64) T _back{};
+};
+
+} // namespace common::rt
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common/rt/DoubleBufferChannel.h"
+#include "common/rt/SeqlockChannel.h"
+#include "common/rt/TripleBufferChannel.h"
+
+namespace common::rt {
+
+/** Latest-value channel implementations sharing the back()/publishSwap()/readSnapshot()/publishCount() API. */
+enum class ChannelKind {
+  Mutex,
+  Seqlock,
+  TripleBuffer
+};
+
+inline const char* ToString(ChannelKind k) {
+  switch (k) {
+    case ChannelKind::Mutex:
+      return "mutex";
+    case ChannelKind::Seqlock:
+      return "seqlock";
+    case ChannelKind::TripleBuffer:
+      return "triple";
+  }
+  return "unknown";
+}
+
+namespace detail {
+template <typename T, ChannelKind Kind>
+struct ChannelFor;
+
+template <typename T>
+struct ChannelFor<T, ChannelKind::Mutex> {
+  using type = DoubleBufferChannel<T>;
+};
+
+template <typename T>
+struct ChannelFor<T, ChannelKind::Seqlock> {
+  using type = SeqlockChannel<T>;
+};
+
+template <typename T>
+struct ChannelFor<T, ChannelKind::TripleBuffer> {
+  using type = TripleBufferChannel<T>;
+};
+} // namespace detail
+
+template <typename T, ChannelKind Kind = ChannelKind::TripleBuffer>
+using SnapshotChannel = typename detail::ChannelFor<T, Kind>::type;
+
+} // namespace common::rt
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "common/rt/PowerOfTwo.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace common::rt {
+
+/**
+ * Bounded lock-free single-producer / single-consumer ring for streams where every element matters.
+ *
+ * The producer never waits: when the consumer has fallen a full ring behind, tryPush() drops the new
+ * element and counts it in dropped(), so a stalled reader costs samples, never producer latency. The
+ * consumer takes everything published so far in one drain() call (one acquire load and one release
+ * store per batch). The producer caches the consumer's index and reloads it only when the ring looks full;
+ * the consumer reloads the producer's index unless its cached copy already covers the batch it was asked
+ * for. Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class SpscRing {
+public:
+  explicit SpscRing(std::size_t capacity) : _mask(RoundUpPow2(capacity) - 1), _slots(new T[_mask + 1]) {}
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  std::size_t capacity() const { return _mask + 1; }
+
+  /** Producer: append v, or count it as dropped and return false when the ring is full. */
+  bool tryPush(const T& v) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tailCache > _mask) {
+      _tailCache = _tail.load(std::memory_order_acquire);
+      if (head - _tailCache > _mask) {
+        _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    _slots[head & _mask] = v;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Consumer: append up to max published elements to out, oldest first; returns how many. */
+  std::size_t drain(std::vector<T>& out, std::size_t max = static_cast<std::size_t>(-1)) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    // The cached head may be stale; reload it unless it already covers everything the caller asked for.
+    if (_headCache - tail < max) {
+      _headCache = _head.load(std::memory_order_acquire);
+      if (_headCache == tail) return 0;
+    }
+    const std::size_t n = std::min(_headCache - tail, max);
+    out.reserve(out.size() + n);
+    for (std::size_t i = 0; i < n; ++i) out.push_back(_slots[(tail + i) & _mask]);
+    _tail.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  /** Elements rejected by tryPush() because the ring was full (monotonic, any thread). */
+  std::uint64_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+  /** Elements published so far (monotonic, any thread). */
+  std::size_t pushed() const { return _head.load(std::memory_order_acquire); }
+
+private:
+  const std::size_t _mask;
+  std::unique_ptr<T[]> _slots;
+  alignas(64) std::atomic<std::size_t> _head{0};
+  std::size_t _tailCache{0};  // producer's view of _tail
+  std::atomic<std::uint64_t> _dropped{0};
+  alignas(64) std::atomic<std::size_t> _tail{0};
+  std::size_t _headCache{0};  // consumer's view of _head
+};
+
+} // namespace common::rt
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace common::config {
+class Config;
+}
+
+namespace common::rt {
+
+enum class SchedPolicy {
+  Other,
+  Fifo,
+  RoundRobin,
+};
+
+const char* ToString(SchedPolicy policy);
+/** "other" / "fifo" / "rr"; anything else yields fallback. */
+SchedPolicy ParseSchedPolicy(const std::string& text, SchedPolicy fallback);
+
+/** Scheduling for one named thread (the name passed to common::log::SetThreadName). */
+struct ThreadRtSpec {
+  SchedPolicy policy{SchedPolicy::Other};
+  /** 1..99 for Fifo/RoundRobin; ignored for Other. */
+  int priority{0};
+  /** CPUs the thread may run on; empty leaves the inherited affinity. */
+  std::vector<int> cpus;
+};
+
+struct ProcessRtParams {
+  /** mlockall(MCL_CURRENT | MCL_FUTURE): no page faults on the real-time path after startup. */
+  bool lockMemory{false};
+  /** Heap touched and returned to malloc (not to the OS) at startup so later allocations do not fault. */
+  std::size_t prefaultHeapBytes{0};
+  /** Stack pre-touched by ConfigureCurrentThread() on every configured thread, at most the stack it has left. */
+  std::size_t stackPrefaultBytes{0};
+};
+
+/**
+ * Read [rt] (lock_memory, prefault_heap_mb, stack_prefault_kb) and one [rt.<thread>] section per thread
+ * (policy = other|fifo|rr, priority, cpus = comma-separated list), then apply the process-wide part.
+ * Call once at startup, before the configured threads start. Missing privileges are logged as warnings
+ * and the process continues with default scheduling.
+ */
+void InitFromConfig(const common::config::Config& cfg);
+
+/** Apply the [rt.<name>] policy, affinity and stack pre-touch to the calling thread; no-op if unconfigured. */
+void ConfigureCurrentThread(const std::string& name);
+
+} // namespace common::rt
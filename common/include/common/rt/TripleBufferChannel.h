@@ -0,0 +1,81 @@
+#pragma once
+
+#include "common/rt/CpuRelax.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace common::rt {
+
+/**
+ * Single-writer / multi-reader snapshot channel over three slots.
+ *
+ * The writer fills back() in place and publishSwap() only flips the published index, so publishing
+ * costs no copy and the writer never waits. The slot being written is always distinct from the two
+ * most recently published ones; each slot carries its own sequence counter so a reader that stalls
+ * for more than one full publish period detects the reuse and retries. back() contents after
+ * publishSwap() are unspecified; writers are expected to overwrite every field before publishing.
+ */
+template <typename T>
+class TripleBufferChannel {
+  static_assert(std::is_trivially_copyable<T>::value, "TripleBufferChannel requires a trivially copyable T");
+
+public:
+  TripleBufferChannel() { beginWrite(_writing); }
+
+  T& back() { return _slots[_writing].value; }
+
+  void publishSwap() {
+    Slot& slot = _slots[_writing];
+    slot.seq.store(slot.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    const std::uint32_t justPublished = _writing;
+    _published.store(justPublished, std::memory_order_release);
+    _publishCount.store(_publishCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    // Slot indices sum to 3: the next writable slot is the one published least recently.
+    _writing = 3u - justPublished - _lastPublished;
+    _lastPublished = justPublished;
+    beginWrite(_writing);
+  }
+
+  T readSnapshot() const {
+    T out;
+    for (;;) {
+      const Slot& slot = _slots[_published.load(std::memory_order_acquire)];
+      const std::uint64_t s0 = slot.seq.load(std::memory_order_acquire);
+      if ((s0 & 1u) == 0) {
+        std::memcpy(static_cast<void*>(&out), static_cast<const void*>(&slot.value), sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == s0) return out;
+      }
+      CpuRelax();
+    }
+  }
+
+  std::uint64_t publishCount() const { return _publishCount.load(std::memory_order_acquire); }
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> seq{0};
+    T value{};
+  };
+
+  void beginWrite(std::uint32_t index) {
+    Slot& slot = _slots[index];
+    slot.seq.store(slot.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  Slot _slots[3];
+  alignas(64) std::atomic<std::uint32_t> _published{0};
+  std::atomic<std::uint64_t> _publishCount{0};
+
+  // Writer-owned state.
+  alignas(64) std::uint32_t _writing{1};
+  std::uint32_t _lastPublished{0};
+};
+
+} // namespace common::rt
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace common::config {
+class Config;
+}
+
+namespace common::sensor {
+
+/** One stage of a channel's filter chain. */
+struct FilterSpec {
+  enum class Kind {
+    MovingAverage,
+    Biquad,
+    Fir
+  };
+
+  Kind kind{Kind::MovingAverage};
+  /** MovingAverage: window length in samples. */
+  std::size_t window{1};
+  /** Biquad: normalized b0, b1, b2, a1, a2 (a0 = 1). */
+  double biquad[5]{1.0, 0.0, 0.0, 0.0, 0.0};
+  /** Fir: taps, newest sample first. */
+  std::vector<double> taps;
+};
+
+using FilterChainSpec = std::vector<FilterSpec>;
+
+/**
+ * Parse a chain such as "ma:8|biquad_lp:20:0.707|fir:0.25,0.5,0.25".
+ * Stages: ma:N, biquad_lp:cutoffHz:Q, biquad_hp:cutoffHz:Q, biquad:b0,b1,b2,a1,a2, fir:t0,t1,...
+ * sampleRateHz is used to design the lp/hp biquads. Returns false and sets error on a malformed stage.
+ */
+bool ParseFilterChain(const std::string& text, double sampleRateHz, FilterChainSpec& out, std::string& error);
+
+/**
+ * Read per-channel chains from [sensor.filters]: enable, default (applies to every channel) and
+ * chN overrides. Returns an empty vector when filtering is disabled or no chain is configured.
+ * Malformed chains are logged and ignored.
+ */
+std::vector<FilterChainSpec> LoadFilterChains(const common::config::Config& cfg, std::size_t channels, double sampleRateHz);
+
+/**
+ * Streaming filter stage over the channel dimension.
+ *
+ * Per-channel chains are merged into stages by (position, kind): within a stage every channel carries
+ * its own coefficients in structure-of-arrays form, and channels that do not use the stage get
+ * identity coefficients. Each stage is then one pass over a cache-line-padded frame in fixed 8-lane
+ * blocks, which compilers turn into SIMD code without target-specific intrinsics.
+ */
+class FilterChain {
+public:
+  class Stage;
+
+  FilterChain();
+  /** stride must be >= channels and a multiple of 8 (SensorFrameRing::stride()). */
+  FilterChain(std::size_t channels, std::size_t stride, const std::vector<FilterChainSpec>& perChannel);
+  ~FilterChain();
+
+  FilterChain(FilterChain&&) noexcept;
+  FilterChain& operator=(FilterChain&&) noexcept;
+
+  bool empty() const { return _stages.empty(); }
+  std::size_t stageCount() const { return _stages.size(); }
+
+  /** Filter one frame in place; values must have stride() elements. */
+  void process(double* values);
+  void reset();
+
+  /** e.g. "ma(8) -> biquad -> fir(3)". */
+  std::string describe() const;
+
+private:
+  std::size_t _channels{0};
+  std::size_t _stride{0};
+  std::vector<std::unique_ptr<Stage>> _stages;
+};
+
+} // namespace common::sensor
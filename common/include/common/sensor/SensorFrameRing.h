@@ -0,0 +1,84 @@
+#pragma once
+
+#include "common/rt/AlignedBuffer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace common::sensor {
+
+/**
+ * Zero-copy view of one published multi-channel frame.
+ *
+ * values points into the ring; it stays readable until the writer wraps around to the same slot
+ * (depth - 1 publishes later). Consumers read the values first and then call valid(); a false
+ * result means the slot was reused and whatever was read must be discarded.
+ */
+class SensorFrameView {
+public:
+  SensorFrameView() = default;
+
+  std::uint64_t seq{0};
+  std::uint64_t monotonicNs{0};
+  const double* values{nullptr};
+  std::size_t channels{0};
+
+  bool empty() const { return values == nullptr; }
+  bool valid() const {
+    if (!_version) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return _version->load(std::memory_order_relaxed) == _expected;
+  }
+
+private:
+  friend class SensorFrameRing;
+  const std::atomic<std::uint64_t>* _version{nullptr};
+  std::uint64_t _expected{0};
+};
+
+/**
+ * Single-writer ring of N-channel frames in structure-of-arrays layout.
+ *
+ * Each slot holds the channel values contiguously, padded to a whole number of cache lines, so
+ * per-channel loops over a frame vectorize and neighbouring slots never share a line. Publishing
+ * writes in place and readers receive views instead of copies.
+ */
+class SensorFrameRing {
+public:
+  SensorFrameRing(std::size_t channels, std::size_t depth);
+
+  std::size_t channels() const { return _channels; }
+  /** Distance in doubles between the starts of consecutive slots (channels rounded up to a cache line). */
+  std::size_t stride() const { return _stride; }
+  std::size_t depth() const { return _depth; }
+
+  /** Writer: claim the next slot; returns stride() writable doubles, the first channels() of which are published. */
+  double* beginWrite();
+  /** Writer: publish the slot claimed by beginWrite(). */
+  void publish(std::uint64_t seq, std::uint64_t monotonicNs);
+
+  /** Reader: newest published frame, or an empty view before the first publish. */
+  SensorFrameView latest() const;
+
+private:
+  struct alignas(64) SlotMeta {
+    std::atomic<std::uint64_t> version{0};
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<std::uint64_t> monotonicNs{0};
+  };
+
+  static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+  std::size_t _channels;
+  std::size_t _stride;
+  std::size_t _depth;
+  common::rt::AlignedBuffer<double> _values;
+  std::unique_ptr<SlotMeta[]> _meta;
+
+  alignas(64) std::atomic<std::size_t> _published{kNone};
+  alignas(64) std::size_t _writeIndex{0};
+};
+
+} // namespace common::sensor
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "common/rt/AlignedBuffer.h"
+#include "common/rt/MonotonicWindow.h"
+#include "common/rt/TripleBufferChannel.h"
+#include "common/sensor/SensorModels.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace common::sensor {
+
+constexpr std::size_t kMaxStatWindows = 4;
+
+struct ChannelWindowStats {
+  double min{0.0};
+  double max{0.0};
+  double mean{0.0};
+};
+
+/** Running statistics of channels A/B/C over the last windowSamples samples. */
+struct SensorWindowStats {
+  std::uint32_t windowSamples{0};
+  /** Samples actually covered (< windowSamples until the window has filled). */
+  std::uint32_t filled{0};
+  ChannelWindowStats a;
+  ChannelWindowStats b;
+  ChannelWindowStats c;
+};
+
+struct SensorStatsSnapshot {
+  std::uint64_t seq{0};
+  std::uint32_t windowCount{0};
+  SensorWindowStats windows[kMaxStatWindows];
+};
+
+class SensorHistory;
+
+/**
+ * Zero-copy view of a contiguous run of samples in the history ring. Because the ring wraps, the run
+ * is exposed as up to two contiguous pieces. Read the samples first, then call valid(): false means
+ * the writer has overwritten the oldest part of the span while it was being read.
+ */
+class SampleSpan {
+public:
+  const SensorSample* first{nullptr};
+  std::size_t firstCount{0};
+  const SensorSample* second{nullptr};
+  std::size_t secondCount{0};
+  /** The query reached further back than the ring retains; the span starts at the oldest retained sample. */
+  bool truncated{false};
+
+  std::size_t size() const { return firstCount + secondCount; }
+  bool empty() const { return size() == 0; }
+  const SensorSample& operator[](std::size_t i) const { return i < firstCount ? first[i] : second[i - firstCount]; }
+
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    for (std::size_t i = 0; i < firstCount; ++i) fn(first[i]);
+    for (std::size_t i = 0; i < secondCount; ++i) fn(second[i]);
+  }
+
+  bool valid() const;
+
+private:
+  friend class SensorHistory;
+  const SensorHistory* _owner{nullptr};
+  std::uint64_t _beginIndex{0};
+};
+
+/**
+ * Fixed-capacity, lock-free, single-writer ring of recent SensorSamples.
+ *
+ * The writer (sensor thread) calls push() once per sample; any thread may query. Queries by sequence
+ * number or time return SampleSpans pointing into the ring. Alongside the samples the ring keeps
+ * compensated prefix sums of A/B/C, so the mean over any retained range is O(1) and does not lose
+ * precision as the run gets longer, and per-window monotonic deques
+ * maintained on push give O(1) min/max/mean for the configured windows via stats().
+ */
+class SensorHistory {
+public:
+  /** capacity is rounded up to a power of two; windows longer than capacity - 1 are clamped, at most kMaxStatWindows are kept. */
+  SensorHistory(std::size_t capacity, const std::vector<std::size_t>& statWindows);
+
+  std::size_t capacity() const { return _capacity; }
+
+  /** Writer only. */
+  void push(const SensorSample& sample);
+
+  /** Samples with seq >= fromSeq (inclusive). */
+  SampleSpan sinceSeq(std::uint64_t fromSeq) const;
+  /** Samples with t0Ns <= monotonicNs <= t1Ns. */
+  SampleSpan between(std::uint64_t t0Ns, std::uint64_t t1Ns) const;
+
+  /** Mean of A/B/C over fromSeq..toSeq (inclusive) in O(1); false if the range is not fully retained. */
+  bool rangeMean(std::uint64_t fromSeq, std::uint64_t toSeq, double& a, double& b, double& c) const;
+
+  /** Latest running statistics for the configured windows. */
+  SensorStatsSnapshot stats() const { return _stats.readSnapshot(); }
+
+  /** Number of samples pushed so far. */
+  std::uint64_t count() const { return _head.load(std::memory_order_acquire); }
+
+private:
+  friend class SampleSpan;
+
+  /** Running sums with their accumulated rounding error (Kahan/TwoSum), so range differences stay exact-ish. */
+  struct Prefix {
+    double a;
+    double b;
+    double c;
+    double errA;
+    double errB;
+    double errC;
+  };
+
+  struct WindowState {
+    std::size_t length;
+    common::rt::MinWindow minA, minB, minC;
+    common::rt::MaxWindow maxA, maxB, maxC;
+  };
+
+  const SensorSample& slot(std::uint64_t index) const { return _samples[index & _mask]; }
+  /** Oldest absolute index that has not been claimed for overwrite. */
+  std::uint64_t oldestIndex() const;
+  /** First absolute index in [lo, hi) whose key is >= value. */
+  template <typename Key>
+  std::uint64_t lowerBound(std::uint64_t lo, std::uint64_t hi, std::uint64_t value, Key key) const;
+  SampleSpan makeSpan(std::uint64_t begin, std::uint64_t end, bool truncated) const;
+  bool indexOfSeq(std::uint64_t seq, std::uint64_t lo, std::uint64_t hi, std::uint64_t& index) const;
+
+  std::size_t _capacity;
+  std::uint64_t _mask;
+  common::rt::AlignedBuffer<SensorSample> _samples;
+  common::rt::AlignedBuffer<Prefix> _prefix;
+
+  // _claimed runs ahead of _head while a slot is being rewritten.
+  alignas(64) std::atomic<std::uint64_t> _claimed{0};
+  alignas(64) std::atomic<std::uint64_t> _head{0};
+
+  // Writer-owned.
+  alignas(64) Prefix _running{};
+  std::vector<WindowState> _windows;
+  common::rt::TripleBufferChannel<SensorStatsSnapshot> _stats;
+};
+
+} // namespace common::sensor
@@ -4,6 +4,10 @@
 
 namespace common::sensor {
 
+/**
+ * Per-sample header. The full N-channel values live in SensorFrameRing (see SensorPipeline::latestFrame());
+ * valueA/B/C mirror channels 0..2 for consumers that only carry the three-signal view (IPC SensorFrame, UI).
+ */
 struct SensorSample {
   std::uint64_t seq{0};
   std::uint64_t monotonicNs{0};
@@ -18,6 +22,11 @@ struct SensorSnapshot {
 
   double effectiveRateHz{0.0};
   std::uint64_t missedDeadlines{0};
+  std::uint32_t channelCount{0};
+
+  /** Filter stage cost per sample (moving average over ~64 samples, and worst case); 0 when no filters are configured. */
+  double filterCostNs{0.0};
+  std::uint64_t filterCostMaxNs{0};
 };
 
 } // namespace common::sensor
@@ -1,10 +1,18 @@
 #pragma once
 
-#include "common/rt/DoubleBufferChannel.h"
+#include "common/rt/PeriodicTimer.h"
+#include "common/rt/SeqNotifier.h"
+#include "common/rt/SnapshotChannel.h"
+#include "common/sensor/FilterChain.h"
+#include "common/sensor/SensorFrameRing.h"
+#include "common/sensor/SensorHistory.h"
 #include "common/sensor/SensorModels.h"
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <thread>
+#include <vector>
 
 namespace common::sensor {
 
@@ -12,6 +20,22 @@ class SensorPipeline {
 public:
   struct Params {
     int rateHz{200};
+    std::size_t channels{3};
+    /** Simulator noise seed; 0 seeds from std::random_device. */
+    std::uint64_t seed{0};
+    /** Frames retained in the ring; a view from latestFrame() stays valid for depth - 1 publishes. */
+    std::size_t frameDepth{8};
+    /** Samples retained in history() (rounded up to a power of two). */
+    std::size_t historyCapacity{4096};
+    /** Window lengths, in samples, for the running min/max/mean in history().stats(). */
+    std::vector<std::size_t> statWindows{20, 200, 2000};
+    /** Per-channel filter chains applied before publish (see LoadFilterChains); empty disables the stage. */
+    std::vector<FilterChainSpec> filters;
+    /**
+     * Loop pacing (period is set from rateHz). Late cycles run back-to-back by default so the sample count
+     * keeps pace with wall-clock time.
+     */
+    common::rt::PeriodicTimer::Params timing{{}, common::rt::OverrunPolicy::CatchUp};
   };
 
   explicit SensorPipeline(Params params);
@@ -21,15 +45,34 @@ class SensorPipeline {
   void stop();
 
   SensorSnapshot latest() const;
+  /** Zero-copy view of the newest N-channel frame; check view.valid() after reading the values. */
+  SensorFrameView latestFrame() const;
+  std::size_t channelCount() const { return _frames.channels(); }
+  /** Recent samples with seq/time window queries and running statistics. */
+  const SensorHistory& history() const { return _history; }
+  /** Signalled after each sample is fully published (snapshot, frame and history); wait with waitNewer(). */
+  const common::rt::SeqNotifier& notifier() const { return _notifier; }
+  /** Sensor thread wake-up jitter and overrun counters. */
+  common::rt::PeriodicStats timing() const { return _timer.stats(); }
 
 private:
   void run();
 
   Params _params;
-  mutable common::rt::DoubleBufferChannel<SensorSnapshot> _channel;
+  common::rt::SnapshotChannel<SensorSnapshot, common::rt::ChannelKind::TripleBuffer> _channel;
+  SensorFrameRing _frames;
+  SensorHistory _history;
+  common::rt::PeriodicTimer _timer;
+  common::rt::SeqNotifier _notifier;
 
   std::atomic<bool> _running{false};
   std::thread _thread;
 };
 
+/**
+ * Pipeline settings from [sensor]: rate_hz, channels, seed, frame_depth, history_capacity, stat_windows,
+ * the pacing keys (see LoadTimerParams) and [sensor.filters].
+ */
+SensorPipeline::Params LoadSensorParams(const common::config::Config& cfg);
+
 } // namespace common::sensor
@@ -1,32 +1,75 @@
 #pragma once
 
+#include "common/rt/AlignedBuffer.h"
+#include "common/rt/LaneRandom.h"
 #include "common/sensor/SensorModels.h"
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <random>
+#include <vector>
 
 namespace common::sensor {
 
+/**
+ * Synthetic N-channel source: per-channel sine plus Gaussian noise. Oscillators advance by a fixed
+ * rotation per sample and noise comes from 8-lane xoshiro256+ / Box-Muller, so a whole frame is
+ * straight-line lane arithmetic. Output is a pure function of Params::seed and the sample index.
+ */
 class SensorSimulator {
 public:
   struct Params {
     int rateHz{200};
+    std::size_t channels{3};
+    /** Noise seed; 0 seeds from std::random_device. */
+    std::uint64_t seed{0};
   };
 
   explicit SensorSimulator(Params params);
 
-  SensorSample generate();
+  std::size_t channels() const { return _params.channels; }
+
+  /** Generate one sample: writes channels() values to out and returns the header (channels 0..2 mirrored). */
+  SensorSample generate(double* out);
+
+  /**
+   * Generate k consecutive samples without pacing: sample i's channels() values go to out + i * stride.
+   * headers (optional) receives k headers with nominal timestamps (call time + i * period). Produces the
+   * same values as k calls to generate(); effectiveRateHz()/missedDeadlines() are not touched.
+   */
+  void generateBatch(std::size_t k, double* out, std::size_t stride, SensorSample* headers = nullptr);
 
   double effectiveRateHz() const { return _effectiveRateHz.load(); }
   std::uint64_t missedDeadlines() const { return _missedDeadlines.load(); }
 
 private:
+  static constexpr std::size_t kLanes = common::rt::LaneXoshiro::kLanes;
+
+  struct ChannelShape {
+    double amplitude{1.0};
+    double freqHz{1.0};
+    double phase{0.0};
+  };
+
+  static ChannelShape ShapeFor(std::size_t channel);
+
+  /** Advance every oscillator one sample and write the padded frame into _frame. */
+  void step();
+
   Params _params;
+  std::size_t _padded{0};
   std::uint64_t _seq{0};
-  std::mt19937 _rng;
-  std::normal_distribution<double> _noise{0.0, 0.02};
+  common::rt::LaneXoshiro _rng;
+
+  // Oscillator state in lanes: (cos, sin) of the current phase, per-sample rotation, amplitude.
+  common::rt::AlignedBuffer<double> _cos;
+  common::rt::AlignedBuffer<double> _sin;
+  common::rt::AlignedBuffer<double> _rotCos;
+  common::rt::AlignedBuffer<double> _rotSin;
+  common::rt::AlignedBuffer<double> _amp;
+  common::rt::AlignedBuffer<double> _frame;
+  std::uint32_t _sinceRenorm{0};
 
   std::chrono::steady_clock::time_point _last;
   std::atomic<double> _effectiveRateHz{0.0};
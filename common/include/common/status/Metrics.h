@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace common::status {
+
+/** Monotonic or absolute uint64 metric. One writer; any number of readers; never locks. */
+class alignas(64) Counter {
+public:
+  void add(std::uint64_t n = 1) { _value.fetch_add(n, std::memory_order_relaxed); }
+  void set(std::uint64_t v) { _value.store(v, std::memory_order_relaxed); }
+  std::uint64_t load() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<std::uint64_t> _value{0};
+};
+
+/** Last-value double metric, stored as its bit pattern so the atomic is always lock-free. */
+class alignas(64) Gauge {
+public:
+  void set(double v) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    _bits.store(bits, std::memory_order_relaxed);
+  }
+  double load() const {
+    const std::uint64_t bits = _bits.load(std::memory_order_relaxed);
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+  }
+
+private:
+  std::atomic<std::uint64_t> _bits{0};
+};
+
+/**
+ * Named gauges and counters, each on its own cache line. Registration takes a lock and
+ * allocates, so producers resolve their metrics once at construction and keep the references;
+ * updates afterwards are single relaxed stores.
+ */
+class MetricsRegistry {
+public:
+  struct Sample {
+    std::string name;
+    double value{0.0};
+  };
+
+  /** Returns the gauge registered under name, creating it on first use. The reference stays valid for the registry's lifetime. */
+  Gauge& gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lk(_mu);
+    auto& slot = _gauges[name];
+    if (!slot) slot = std::make_unique<Gauge>();
+    return *slot;
+  }
+
+  Counter& counter(const std::string& name) {
+    std::lock_guard<std::mutex> lk(_mu);
+    auto& slot = _counters[name];
+    if (!slot) slot = std::make_unique<Counter>();
+    return *slot;
+  }
+
+  /** Current value of every metric, sorted by name (gauges first). For export and diagnostics, not hot paths. */
+  std::vector<Sample> collect() const {
+    std::lock_guard<std::mutex> lk(_mu);
+    std::vector<Sample> out;
+    out.reserve(_gauges.size() + _counters.size());
+    for (const auto& [name, g] : _gauges) out.push_back({name, g->load()});
+    for (const auto& [name, c] : _counters) out.push_back({name, static_cast<double>(c->load())});
+    return out;
+  }
+
+private:
+  mutable std::mutex _mu;
+  std::map<std::string, std::unique_ptr<Gauge>> _gauges;
+  std::map<std::string, std::unique_ptr<Counter>> _counters;
+};
+
+} // namespace common::status
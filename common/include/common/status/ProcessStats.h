@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace common::status {
+
+/** Resident memory of this process in bytes (VmRSS on Linux, working set on Windows); 0 where unsupported. */
+std::uint64_t ResidentBytes();
+/** Peak resident memory of this process in bytes (VmHWM / peak working set); 0 where unsupported. */
+std::uint64_t PeakResidentBytes();
+/** "rss_mb=<n> peak_rss_mb=<n>" for log lines. */
+std::string DescribeMemory();
+
+} // namespace common::status
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "common/status/StatusSnapshot.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Poco::Net {
+class HTTPServer;
+}
+
+namespace common::config {
+class Config;
+}
+
+namespace common::status {
+
+/**
+ * Plain-text status over HTTP for processes without a UI: GET / or /status (any query is ignored)
+ * returns one "name value" line per field of StatusStore::read(), every registered metric, and
+ * whatever the extra callback appends. Served by a single Poco HTTPServer thread; each request reads the store once and never
+ * touches the producers.
+ */
+class StatusServer {
+public:
+  struct Params {
+    std::string host{"127.0.0.1"};
+    /** 0 disables the server. */
+    int port{0};
+  };
+  /** Appends further "name value\n" lines to the response (runs on the server thread). */
+  using Extra = std::function<void(std::string&)>;
+
+  StatusServer(const StatusStore& store, Params params, Extra extra = {});
+  ~StatusServer();
+
+  StatusServer(const StatusServer&) = delete;
+  StatusServer& operator=(const StatusServer&) = delete;
+
+  /** Binds and starts serving; false (and logged) if the port is 0 or cannot be bound. */
+  bool start();
+  void stop();
+
+  /** The response body served for /status. */
+  std::string render() const;
+
+private:
+  const StatusStore& _store;
+  Params _params;
+  Extra _extra;
+  std::unique_ptr<Poco::Net::HTTPServer> _server;
+};
+
+/**
+ * "name value" lines for a snapshot and a set of metrics, as served by StatusServer. Free-text values (error
+ * message, e-stop reason) are escaped so each stays on its one line.
+ */
+std::string FormatStatus(const StatusSnapshot& s, const std::vector<MetricsRegistry::Sample>& metrics);
+
+/** [status] host and port. */
+StatusServer::Params LoadStatusServerParams(const common::config::Config& cfg);
+
+} // namespace common::status
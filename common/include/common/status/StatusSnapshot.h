@@ -1,7 +1,9 @@
 #pragma once
 
+#include "common/status/Metrics.h"
 #include "common/status/Models.h"
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <string>
@@ -36,21 +38,127 @@ struct StatusSnapshot {
   std::string estopReason;
 };
 
+/** Written by the control thread each cycle (ControlLoop, or the DDS status updater). */
+struct ControlMetrics {
+  explicit ControlMetrics(MetricsRegistry& r)
+      : loopHz(r.gauge("control.loop_hz")),
+        algoLatencyMs(r.gauge("control.algo_latency_ms")),
+        lastCommand(r.gauge("control.last_command")),
+        actuatorPosition(r.gauge("actuator.position")),
+        actuatorVelocity(r.gauge("actuator.velocity")) {}
+
+  Gauge& loopHz;
+  Gauge& algoLatencyMs;
+  Gauge& lastCommand;
+  Gauge& actuatorPosition;
+  Gauge& actuatorVelocity;
+};
+
+/** Sensor stream as last seen by the consumer of SensorPipeline. */
+struct SensorMetrics {
+  explicit SensorMetrics(MetricsRegistry& r)
+      : rateHz(r.gauge("sensor.rate_hz")),
+        seq(r.counter("sensor.seq")),
+        missedDeadlines(r.counter("sensor.missed_deadlines")) {}
+
+  Gauge& rateHz;
+  Counter& seq;
+  Counter& missedDeadlines;
+};
+
+/** Written by the supervisor thread (ControllerRuntime). */
+struct HealthMetrics {
+  explicit HealthMetrics(MetricsRegistry& r)
+      : heartbeatRttMs(r.gauge("heartbeat.rtt_ms")),
+        heartbeatTimeouts(r.counter("heartbeat.timeouts")),
+        algoRestarts(r.counter("algo.restarts")) {}
+
+  Gauge& heartbeatRttMs;
+  Counter& heartbeatTimeouts;
+  Counter& algoRestarts;
+};
+
+/**
+ * Live status shared between producer threads and the UI. Each producer owns its metric group
+ * and updates individual fields with relaxed atomic stores, so no producer overwrites another's
+ * fields and the hot paths neither lock nor allocate. States are atomics; the two strings sit
+ * behind a mutex that is taken only when an error code or e-stop reason actually changes.
+ * read() assembles a StatusSnapshot on demand; fields from different producers may be from
+ * slightly different instants.
+ */
 class StatusStore {
 public:
-  void update(const StatusSnapshot& snapshot) {
-    std::lock_guard<std::mutex> lk(_mu);
-    _snapshot = snapshot;
+  StatusStore() : _control(_registry), _sensor(_registry), _health(_registry) {}
+  StatusStore(const StatusStore&) = delete;
+  StatusStore& operator=(const StatusStore&) = delete;
+
+  ControlMetrics& control() { return _control; }
+  SensorMetrics& sensor() { return _sensor; }
+  HealthMetrics& health() { return _health; }
+  /** All named metrics, including any registered by other producers. */
+  MetricsRegistry& registry() { return _registry; }
+  const MetricsRegistry& registry() const { return _registry; }
+
+  void setSystemState(SystemState s) { _systemState.store(s, std::memory_order_relaxed); }
+  void setSafetyState(SafetyState s) { _safetyState.store(s, std::memory_order_relaxed); }
+  void setAlgoHealth(AlgoHealthState s) { _algoHealth.store(s, std::memory_order_relaxed); }
+
+  /** Records an error. The message is only replaced when the code changes, so repeating the current error is lock-free. */
+  void setError(ErrorCode code, const std::string& message) {
+    if (_lastError.load(std::memory_order_relaxed) == code) return;
+    std::lock_guard<std::mutex> lk(_textMu);
+    _lastErrorMessage = message;
+    _lastError.store(code, std::memory_order_relaxed);
+  }
+
+  /** Back to ErrorCode::Ok once the fault has cleared (e.g. the worker is healthy again); lock-free when already Ok. */
+  void clearError() {
+    if (_lastError.load(std::memory_order_relaxed) == ErrorCode::Ok) return;
+    std::lock_guard<std::mutex> lk(_textMu);
+    _lastErrorMessage.clear();
+    _lastError.store(ErrorCode::Ok, std::memory_order_relaxed);
   }
 
   StatusSnapshot read() const {
-    std::lock_guard<std::mutex> lk(_mu);
-    return _snapshot;
+    StatusSnapshot s;
+    s.systemState = _systemState.load(std::memory_order_relaxed);
+    s.safetyState = _safetyState.load(std::memory_order_relaxed);
+    s.algoHealth = _algoHealth.load(std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lk(_textMu);
+      s.lastError = _lastError.load(std::memory_order_relaxed);
+      s.lastErrorMessage = _lastErrorMessage;
+    }
+
+    s.sensorRateHz = _sensor.rateHz.load();
+    s.sensorSeq = _sensor.seq.load();
+    s.sensorMissedDeadlines = _sensor.missedDeadlines.load();
+
+    s.controlLoopHz = _control.loopHz.load();
+    s.algoLatencyMs = _control.algoLatencyMs.load();
+    s.lastCommand = _control.lastCommand.load();
+    s.actuatorPosition = _control.actuatorPosition.load();
+    s.actuatorVelocity = _control.actuatorVelocity.load();
+
+    s.heartbeatRttMs = _health.heartbeatRttMs.load();
+    s.heartbeatTimeouts = _health.heartbeatTimeouts.load();
+    s.algoRestarts = _health.algoRestarts.load();
+    return s;
   }
 
 private:
-  mutable std::mutex _mu;
-  StatusSnapshot _snapshot;
+  MetricsRegistry _registry;
+  ControlMetrics _control;
+  SensorMetrics _sensor;
+  HealthMetrics _health;
+
+  std::atomic<SystemState> _systemState{SystemState::Starting};
+  std::atomic<SafetyState> _safetyState{SafetyState::Normal};
+  std::atomic<AlgoHealthState> _algoHealth{AlgoHealthState::Unknown};
+  std::atomic<ErrorCode> _lastError{ErrorCode::Ok};
+
+  mutable std::mutex _textMu;
+  std::string _lastErrorMessage;
 };
 
 } // namespace common::status
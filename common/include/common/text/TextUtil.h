@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string_view>
+
+namespace common::text {
+
+/** True if s ends with suffix (file name extensions: ".seg", ".gz"). */
+inline bool EndsWith(std::string_view s, std::string_view suffix) {
+  return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace common::text
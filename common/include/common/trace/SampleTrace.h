@@ -0,0 +1,99 @@
+#pragma once
+
+#include "common/rt/LatencyHistogram.h"
+#include "common/rt/SpscRing.h"
+#include "common/time/MonotonicClock.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace common::trace {
+
+/** Pipeline stages of one sensor sample, in the order it passes through them. */
+enum class Stage : std::uint8_t {
+  SensorSample = 0,  // SensorSample::monotonicNs (acquisition)
+  SensorPublish,     // SensorPipeline made the sample visible
+  ControlPickup,     // controller thread picked the sample up
+  IpcSend,           // handed to the transport towards algo_worker
+  WorkerReceive,     // algo_worker took the sample
+  ComputeStart,
+  ComputeEnd,
+  ResultReceive,     // controller took the algo result
+  ActuatorApply,     // first ActuatorSimulator::apply with a command based on this sample
+};
+
+constexpr std::size_t kStageCount = 9;
+
+constexpr std::size_t Index(Stage s) { return static_cast<std::size_t>(s); }
+
+const char* ToString(Stage s);
+
+/**
+ * Fixed-size per-sample record: one steady_clock timestamp per stage (0 = not reached). Both processes
+ * stamp from the same monotonic clock, so worker stamps compare directly with controller stamps.
+ * The record travels with the sample (trace_ns in the JointState and ControlCommand messages) and is
+ * completed on the thread that applies the command.
+ */
+struct SampleTrace {
+  std::uint64_t sensorSeq{0};
+  std::array<std::uint64_t, kStageCount> ns{};
+
+  void stamp(Stage s, std::uint64_t t = common::time::NowMonotonicNs()) { ns[Index(s)] = t; }
+  std::uint64_t at(Stage s) const { return ns[Index(s)]; }
+  bool has(Stage s) const { return at(s) != 0; }
+};
+
+/**
+ * Aggregates completed SampleTraces into one latency histogram per hop (previous reached stage to
+ * this stage) plus sample-to-actuation end to end, and keeps every exportEvery-th record in a
+ * common::rt::SpscRing for export. record() is for one thread, allocation- and
+ * lock-free; histogram reads and drainSamples() may run on any other thread.
+ */
+class TraceAggregator {
+public:
+  struct Params {
+    /** Keep 1 in N completed records for export; 0 disables export. */
+    std::uint32_t exportEvery{100};
+    /** Export ring capacity (records, rounded up to a power of two); when the consumer lags, new samples are dropped. */
+    std::size_t exportCapacity{256};
+  };
+
+  TraceAggregator() : TraceAggregator(Params{}) {}
+  explicit TraceAggregator(Params params);
+
+  void record(const SampleTrace& t);
+
+  /** Latency into stage s from the closest earlier stage that was stamped. */
+  common::rt::LatencySnapshot hop(Stage s) const { return _hops[Index(s)].snapshot(); }
+  /** SensorSample to ActuatorApply. */
+  common::rt::LatencySnapshot endToEnd() const { return _endToEnd.snapshot(); }
+
+  std::uint64_t recorded() const { return _recorded.load(std::memory_order_relaxed); }
+  /** Records without SensorSample or ActuatorApply (counted, not aggregated). */
+  std::uint64_t incomplete() const { return _incomplete.load(std::memory_order_relaxed); }
+  std::uint64_t exportDropped() const { return _ring.dropped(); }
+
+  /** Consumer side: move pending export samples into out (appends); returns how many. */
+  std::size_t drainSamples(std::vector<SampleTrace>& out);
+
+  /** Multi-line summary: per-hop mean/p50/p99/max and end to end. */
+  std::string describe() const;
+
+private:
+  Params _params;
+  std::array<common::rt::LatencyHistogram, kStageCount> _hops;
+  common::rt::LatencyHistogram _endToEnd;
+  std::atomic<std::uint64_t> _recorded{0};
+  std::atomic<std::uint64_t> _incomplete{0};
+  common::rt::SpscRing<SampleTrace> _ring;  // record() produces, drainSamples() consumes
+};
+
+/** CSV export: "sensor_seq,<stage>_ns,..." header and one row per record (absolute ns, 0 = missing). */
+std::string CsvHeader();
+std::string ToCsvRow(const SampleTrace& t);
+
+} // namespace common::trace
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "common/time/MonotonicClock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace common::config {
+class Config;
+}
+
+namespace common::trace {
+
+/**
+ * Hot-path span tracing to Chrome trace JSON (opens in chrome://tracing and ui.perfetto.dev).
+ *
+ * MRCD_TRACE_SPAN(name) / MRCD_TRACE_SPAN_SEQ(name, sensorSeq) time the enclosing scope. Each thread
+ * writes complete events into its own single-producer ring; a background flusher drains all rings and
+ * appends them to one file, labelled with the thread's SetThreadName() name. Spans that carry a sensor
+ * seq are linked by flow arrows across threads and processes (controller_app and algo_worker append to
+ * the same file and share the monotonic clock). name must be a string literal or otherwise outlive
+ * the process.
+ *
+ * Built with MRCD_TRACE_SPANS=OFF the macros expand to nothing. Compiled in but disabled
+ * ([trace] spans=false), a span costs one relaxed load and a not-taken branch.
+ */
+struct SpanParams {
+  bool enabled{false};
+  std::string path{"mrcd_trace.json"};
+  /** Start a new file (the first process of a run); others append. */
+  bool truncate{false};
+  std::chrono::milliseconds flushInterval{100};
+  /** Per-thread ring capacity (rounded up to a power of two); spans are dropped (and counted) while a ring is full. */
+  std::uint32_t ringEvents{8192};
+};
+
+/** Reads trace.spans, trace.spans_file, trace.spans_flush_ms, trace.spans_ring_events. */
+SpanParams LoadSpanParams(const common::config::Config& cfg);
+
+/** Starts the flusher and enables spans if params.enabled. processName labels this process in the trace. */
+void StartSpans(const SpanParams& params, const std::string& processName);
+/** Disables spans, stops the flusher and writes what is still buffered. Safe to call when not started. */
+void StopSpans();
+
+namespace detail {
+
+extern std::atomic<bool> gSpansEnabled;
+
+inline bool SpansEnabled() { return gSpansEnabled.load(std::memory_order_relaxed); }
+
+void Emit(const char* name, std::uint64_t startNs, std::uint64_t endNs, std::uint64_t seq);
+
+} // namespace detail
+
+class ScopedSpan {
+public:
+  explicit ScopedSpan(const char* name, std::uint64_t seq = 0)
+      : _name(detail::SpansEnabled() ? name : nullptr), _seq(seq) {
+    if (_name) _startNs = common::time::NowMonotonicNs();
+  }
+  ~ScopedSpan() { end(); }
+
+  /** Attach a sensor seq learned inside the span (e.g. after a receive). */
+  void setSeq(std::uint64_t seq) { _seq = seq; }
+
+  /** Close the span before the end of scope (e.g. ahead of a loop's sleep). */
+  void end() {
+    if (_name) detail::Emit(_name, _startNs, common::time::NowMonotonicNs(), _seq);
+    _name = nullptr;
+  }
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+  const char* _name;
+  std::uint64_t _seq;
+  std::uint64_t _startNs{0};
+};
+
+} // namespace common::trace
+
+#define MRCD_TRACE_CONCAT_INNER(a, b) a##b
+#define MRCD_TRACE_CONCAT(a, b) MRCD_TRACE_CONCAT_INNER(a, b)
+
+#if defined(MRCD_TRACE_SPANS)
+#define MRCD_TRACE_SPAN(name) ::common::trace::ScopedSpan MRCD_TRACE_CONCAT(mrcdSpan_, __LINE__)(name)
+#define MRCD_TRACE_SPAN_SEQ(name, seq) ::common::trace::ScopedSpan MRCD_TRACE_CONCAT(mrcdSpan_, __LINE__)(name, seq)
+/** Named span: the seq can be attached later and the span closed before the end of scope. */
+#define MRCD_TRACE_SPAN_VAR(var, name) ::common::trace::ScopedSpan var(name)
+#define MRCD_TRACE_SET_SEQ(var, seq) (var).setSeq(seq)
+#define MRCD_TRACE_SPAN_END(var) (var).end()
+#else
+#define MRCD_TRACE_SPAN(name) ((void)0)
+#define MRCD_TRACE_SPAN_SEQ(name, seq) ((void)0)
+#define MRCD_TRACE_SPAN_VAR(var, name) ((void)0)
+#define MRCD_TRACE_SET_SEQ(var, seq) ((void)0)
+#define MRCD_TRACE_SPAN_END(var) ((void)0)
+#endif
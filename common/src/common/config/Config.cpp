@@ -5,6 +5,7 @@
 #include <Poco/Util/IniFileConfiguration.h>
 
 #include <memory>
+#include <sstream>
 
 namespace common::config {
 
@@ -54,6 +55,20 @@ bool Config::getBool(const std::string& key, bool defaultValue) const {
   return c->getBool(key, defaultValue);
 }
 
+std::vector<int> Config::getIntList(const std::string& key, const std::vector<int>& defaultValue) const {
+  auto* c = _impl->active();
+  if (!c || !c->hasProperty(key)) return defaultValue;
+  return ParseIntList(c->getString(key));
+}
+
+std::vector<std::string> Config::keys(const std::string& prefix) const {
+  auto* c = _impl->active();
+  if (!c) return {};
+  Poco::Util::AbstractConfiguration::Keys out;
+  c->keys(prefix, out);
+  return out;
+}
+
 Config Config::WrapPocoConfig(void* pocoAbstractConfiguration) {
   auto* ac = static_cast<Poco::Util::AbstractConfiguration*>(pocoAbstractConfiguration);
   auto impl = std::make_unique<ConfigImpl>();
@@ -61,4 +76,29 @@ Config Config::WrapPocoConfig(void* pocoAbstractConfiguration) {
   return Config(std::move(impl));
 }
 
+std::vector<int> ParseIntList(const std::string& text) {
+  std::vector<int> out;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    try {
+      out.push_back(std::stoi(item));
+    } catch (...) {
+    }
+  }
+  return out;
+}
+
+std::vector<std::string> ParseList(const std::string& text) {
+  std::vector<std::string> out;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    const auto b = item.find_first_not_of(" \t");
+    const auto e = item.find_last_not_of(" \t");
+    if (b != std::string::npos) out.push_back(item.substr(b, e - b + 1));
+  }
+  return out;
+}
+
 } // namespace common::config
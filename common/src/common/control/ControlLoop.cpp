@@ -1,7 +1,9 @@
 #include "common/control/ControlLoop.h"
 
 #include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/time/MonotonicClock.h"
+#include "common/trace/Spans.h"
 
 #include <chrono>
 
@@ -12,7 +14,12 @@ ControlLoop::ControlLoop(const common::sensor::SensorPipeline& sensor,
                          ActuatorSimulator& actuator,
                          common::status::StatusStore& status,
                          Params params)
-    : _sensor(sensor), _ipc(ipc), _actuator(actuator), _status(status), _params(params) {}
+    : _sensor(sensor),
+      _ipc(ipc),
+      _actuator(actuator),
+      _status(status),
+      _params(params),
+      _timer(common::rt::PeriodicTimer::WithRate(params.timing, params.rateHz)) {}
 
 ControlLoop::~ControlLoop() { stop(); }
 
@@ -43,29 +50,41 @@ ControlCommand ControlLoop::computeCommand(const common::sensor::SensorSnapshot&
   }
 
   // Demo mapping: pass algo output through as command.
+  cmd.basedOnSensorSeq = algo->sensorSeq;
   cmd.cmdValue = algo->outValue;
   return cmd;
 }
 
 void ControlLoop::run() {
   common::log::SetThreadName("control");
+  common::rt::ConfigureCurrentThread("control");
 
   const double dt = 1.0 / static_cast<double>(std::max(1, _params.rateHz));
-  const auto period = std::chrono::duration<double>(dt);
 
+  // Bounded waits so stop() is noticed even when the sensor is stalled.
+  const auto idleWait = std::chrono::milliseconds(100);
+  const auto& notifier = _sensor.notifier();
   std::uint64_t lastSeq = 0;
 
+  auto& metrics = _status.control();
+  auto& sensorMetrics = _status.sensor();
+  metrics.loopHz.set(static_cast<double>(_params.rateHz));
+
+  _timer.start();
   while (_running.load()) {
-    const auto t0 = std::chrono::steady_clock::now();
+    if (_params.trigger == Trigger::Sensor) {
+      if (notifier.waitNewer(lastSeq, std::chrono::steady_clock::now() + idleWait) == lastSeq) continue;
+    } else {
+      _timer.wait();
+    }
 
     const auto snap = _sensor.latest();
-
-    // Sync to sensor: only compute when we see a new seq.
-    if (snap.latest.seq == lastSeq) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
-      continue;
-    }
+    if (snap.latest.seq == lastSeq) continue;  // Timer tick without a new sample.
     lastSeq = snap.latest.seq;
+    MRCD_TRACE_SPAN_SEQ("control.cycle", lastSeq);
+    const auto publishNs = notifier.lastPublishNs();
+    const auto startNs = common::time::NowMonotonicNs();
+    if (startNs > publishNs) _pickup.record(startNs - publishNs);
 
     // Send sensor frame to algo worker (best-effort).
     if (_ipc.isConnected()) {
@@ -100,20 +119,23 @@ void ControlLoop::run() {
     _actuator.apply(cmd, dt);
     const auto act = _actuator.state();
 
-    // Update status snapshot with control metrics.
-    auto st = _status.read();
-    st.controlLoopHz = static_cast<double>(_params.rateHz);
-    st.algoLatencyMs = algoPtr ? algoPtr->latencyMs : 0.0;
-    st.lastCommand = cmd.cmdValue;
-    st.actuatorPosition = act.position;
-    st.actuatorVelocity = act.velocity;
-    _status.update(st);
-
-    const auto t1 = std::chrono::steady_clock::now();
-    const auto elapsed = t1 - t0;
-    if (elapsed < period) {
-      std::this_thread::sleep_for(period - elapsed);
-    }
+    // Publish control metrics field by field: relaxed stores, no lock, no snapshot copy.
+    metrics.algoLatencyMs.set(algoPtr ? algoPtr->latencyMs : 0.0);
+    metrics.lastCommand.set(cmd.cmdValue);
+    metrics.actuatorPosition.set(act.position);
+    metrics.actuatorVelocity.set(act.velocity);
+    sensorMetrics.rateHz.set(snap.effectiveRateHz);
+    sensorMetrics.seq.set(snap.latest.seq);
+    sensorMetrics.missedDeadlines.set(snap.missedDeadlines);
+  }
+
+  const auto pickup = _pickup.snapshot();
+  common::log::Info("control", std::string("trigger=") + (_params.trigger == Trigger::Sensor ? "sensor" : "timer") +
+                                   " pickup_mean_us=" + std::to_string(static_cast<std::uint64_t>(pickup.meanNs() / 1000.0)) +
+                                   " pickup_p99_us=" + std::to_string(pickup.percentileNs(0.99) / 1000) +
+                                   " pickup_max_us=" + std::to_string(pickup.maxNs / 1000));
+  if (_params.trigger == Trigger::Timer) {
+    common::log::Info("control", "timing: " + common::rt::Describe(_timer.stats()));
   }
 }
 
@@ -1,6 +1,8 @@
 #include "common/controller/ControllerRuntime.h"
 
 #include "common/log/Log.h"
+#include "common/log/LogMacros.h"
+#include "common/rt/ThreadPolicy.h"
 
 #include <Poco/Net/SocketAddress.h>
 #include <Poco/Path.h>
@@ -33,7 +35,10 @@ ControllerRuntime::ControllerRuntime(const common::config::Config& cfg,
   const int rateHz = cfg.getInt("sensor.rate_hz", 200);
   _controlLoop = std::make_unique<common::control::ControlLoop>(
       _sensor, _ipcClient, _actuator, _status,
-      common::control::ControlLoop::Params{rateHz, std::chrono::milliseconds(1)});
+      common::control::ControlLoop::Params{
+          rateHz, std::chrono::milliseconds(1), common::rt::LoadTimerParams(cfg, "control", common::rt::OverrunPolicy::Skip),
+          cfg.getString("control.trigger", "sensor") == "timer" ? common::control::ControlLoop::Trigger::Timer
+                                                                : common::control::ControlLoop::Trigger::Sensor});
 }
 
 ControllerRuntime::~ControllerRuntime() { stop(); }
@@ -53,10 +58,10 @@ void ControllerRuntime::stop() {
 
 void ControllerRuntime::run() {
   common::log::SetThreadName("controller");
+  common::rt::ConfigureCurrentThread("controller");
 
-  common::status::StatusSnapshot snap;
-  snap.systemState = common::status::SystemState::Starting;
-  _status.update(snap);
+  auto& health = _status.health();
+  _status.setSystemState(common::status::SystemState::Starting);
 
   _heartbeat.start();
 
@@ -72,14 +77,12 @@ void ControllerRuntime::run() {
       _hasBeenHealthy = false;
       _controlLoopStarted = false;
       _consecutiveUnhealthy = 0;
-      common::log::Debug("controller", "not connected; ensureConnected failed");
-      snap.systemState = common::status::SystemState::Degraded;
-      snap.algoHealth = common::status::AlgoHealthState::Disconnected;
-      snap.lastError = common::status::ErrorCode::IpcConnectFailed;
-      snap.lastErrorMessage = "IPC connect/start failed";
-      snap.heartbeatTimeouts = _heartbeat.timeouts();
-      snap.heartbeatRttMs = _heartbeat.lastRttMs();
-      _status.update(snap);
+      MRCD_LOG_DEBUG("controller", "not connected; ensureConnected failed");
+      _status.setSystemState(common::status::SystemState::Degraded);
+      _status.setAlgoHealth(common::status::AlgoHealthState::Disconnected);
+      _status.setError(common::status::ErrorCode::IpcConnectFailed, "IPC connect/start failed");
+      health.heartbeatTimeouts.set(_heartbeat.timeouts());
+      health.heartbeatRttMs.set(_heartbeat.lastRttMs());
       std::this_thread::sleep_for(std::chrono::milliseconds(500));
       continue;
     }
@@ -98,38 +101,33 @@ void ControllerRuntime::run() {
         common::log::Info("controller", "heartbeat established; control loop started");
       }
       if (_consecutiveUnhealthy > 0) {
-        common::log::Debug("controller", "heartbeat OK again; consecutiveUnhealthy reset from " + std::to_string(_consecutiveUnhealthy));
+        MRCD_LOG_DEBUG("controller", "heartbeat OK again; consecutiveUnhealthy reset from ", _consecutiveUnhealthy);
       }
       _consecutiveUnhealthy = 0;
     }
     const bool inGrace = _connectionGraceEnd.has_value() &&
                          std::chrono::steady_clock::now() < *_connectionGraceEnd;
 
-    common::log::Debug("controller", "hbOk=" + std::string(hbOk ? "true" : "false") +
-                         " inGrace=" + std::string(inGrace ? "true" : "false") +
-                         " hasBeenHealthy=" + std::string(_hasBeenHealthy ? "true" : "false") +
-                         " consecutiveUnhealthy=" + std::to_string(_consecutiveUnhealthy));
+    MRCD_LOG_DEBUG("controller", "hbOk=", hbOk, " inGrace=", inGrace, " hasBeenHealthy=", _hasBeenHealthy,
+                   " consecutiveUnhealthy=", _consecutiveUnhealthy);
 
     if (!hbOk && !inGrace && _hasBeenHealthy) {
       ++_consecutiveUnhealthy;
       common::log::Info("controller", "heartbeat unhealthy: consecutiveUnhealthy=" + std::to_string(_consecutiveUnhealthy) +
                          "/" + std::to_string(kRestartAfterConsecutiveUnhealthy) +
                          " timeouts=" + std::to_string(_heartbeat.timeouts()));
-      snap.systemState = common::status::SystemState::Degraded;
-      snap.algoHealth = common::status::AlgoHealthState::Unhealthy;
-      snap.lastError = common::status::ErrorCode::HeartbeatTimeout;
-      snap.lastErrorMessage = "Heartbeat unhealthy";
-      snap.heartbeatTimeouts = _heartbeat.timeouts();
-      snap.heartbeatRttMs = _heartbeat.lastRttMs();
-      snap.algoRestarts = _procManager.restartCount();
-      _status.update(snap);
+      _status.setSystemState(common::status::SystemState::Degraded);
+      _status.setAlgoHealth(common::status::AlgoHealthState::Unhealthy);
+      _status.setError(common::status::ErrorCode::HeartbeatTimeout, "Heartbeat unhealthy");
+      health.heartbeatTimeouts.set(_heartbeat.timeouts());
+      health.heartbeatRttMs.set(_heartbeat.lastRttMs());
+      health.algoRestarts.set(_procManager.restartCount());
 
       if (_consecutiveUnhealthy >= kRestartAfterConsecutiveUnhealthy) {
         common::log::Warn("controller", "restarting algo_worker: consecutiveUnhealthy=" + std::to_string(_consecutiveUnhealthy) +
                            " (threshold " + std::to_string(kRestartAfterConsecutiveUnhealthy) + ")");
         (void)_procManager.restart();
-        snap.algoRestarts = _procManager.restartCount();
-        _status.update(snap);
+        health.algoRestarts.set(_procManager.restartCount());
         _wasConnected = false;
         _connectionGraceEnd.reset();
         _hasBeenHealthy = false;
@@ -142,28 +140,27 @@ void ControllerRuntime::run() {
       continue;
     }
     if (!hbOk && (inGrace || !_hasBeenHealthy)) {
-      snap.systemState = common::status::SystemState::Running;
-      snap.algoHealth = common::status::AlgoHealthState::Healthy;
-      snap.heartbeatRttMs = _heartbeat.lastRttMs();
-      snap.heartbeatTimeouts = _heartbeat.timeouts();
-      snap.algoRestarts = _procManager.restartCount();
-      _status.update(snap);
+      _status.setSystemState(common::status::SystemState::Running);
+      _status.setAlgoHealth(common::status::AlgoHealthState::Healthy);
+      _status.clearError();
+      health.heartbeatRttMs.set(_heartbeat.lastRttMs());
+      health.heartbeatTimeouts.set(_heartbeat.timeouts());
+      health.algoRestarts.set(_procManager.restartCount());
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
       continue;
     }
 
-    snap.systemState = common::status::SystemState::Running;
-    snap.algoHealth = common::status::AlgoHealthState::Healthy;
-    snap.heartbeatRttMs = _heartbeat.lastRttMs();
-    snap.heartbeatTimeouts = _heartbeat.timeouts();
-    snap.algoRestarts = _procManager.restartCount();
-    _status.update(snap);
+    _status.setSystemState(common::status::SystemState::Running);
+    _status.setAlgoHealth(common::status::AlgoHealthState::Healthy);
+    _status.clearError();
+    health.heartbeatRttMs.set(_heartbeat.lastRttMs());
+    health.heartbeatTimeouts.set(_heartbeat.timeouts());
+    health.algoRestarts.set(_procManager.restartCount());
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
 
-  snap.systemState = common::status::SystemState::Stopping;
-  _status.update(snap);
+  _status.setSystemState(common::status::SystemState::Stopping);
 }
 
 } // namespace common::controller
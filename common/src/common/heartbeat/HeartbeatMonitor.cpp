@@ -1,7 +1,10 @@
 #include "common/heartbeat/HeartbeatMonitor.h"
 
 #include "common/log/Log.h"
+#include "common/log/LogMacros.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/time/MonotonicClock.h"
+#include "common/trace/Spans.h"
 
 #include <thread>
 
@@ -24,6 +27,7 @@ void HeartbeatMonitor::stop() {
 
 void HeartbeatMonitor::run() {
   common::log::SetThreadName("heartbeat");
+  common::rt::ConfigureCurrentThread("heartbeat");
 
   std::uint64_t seq = 0;
   std::uint32_t misses = 0;
@@ -32,11 +36,12 @@ void HeartbeatMonitor::run() {
   while (_running.load()) {
     if (!_client.isConnected()) {
       _healthy.store(false);
-      common::log::Debug("heartbeat", "not connected; skipping ping");
+      MRCD_LOG_DEBUG("heartbeat", "not connected; skipping ping");
       std::this_thread::sleep_for(_params.interval);
       continue;
     }
 
+    MRCD_TRACE_SPAN_VAR(span, "heartbeat.ping");
     common::ipc::Ping ping;
     ping.seq = ++seq;
     ping.t0MonotonicNs = common::time::NowMonotonicNs();
@@ -45,6 +50,7 @@ void HeartbeatMonitor::run() {
 
     common::ipc::Pong pong;
     const bool got = _client.tryReceivePong(pong, _params.timeout);
+    MRCD_TRACE_SPAN_END(span);
 
     // Accept Pong for current or recent Ping (late Pong still proves worker is alive; allow up to 2 rounds late)
     constexpr std::uint64_t kMaxRoundsLate = 2;
@@ -55,20 +61,12 @@ void HeartbeatMonitor::run() {
       _timeouts.fetch_add(1);
       const bool stillHealthy = misses < _params.missThreshold;
       _healthy.store(stillHealthy);
-      const std::string msg = "miss: got=" + std::string(got ? "true" : "false") +
-          " pong.seq=" + std::to_string(got ? pong.seq : 0) +
-          " ping.seq=" + std::to_string(ping.seq) +
-          " misses=" + std::to_string(misses) +
-          " threshold=" + std::to_string(_params.missThreshold) +
-          " healthy=" + std::string(stillHealthy ? "true" : "false");
-      if (stillHealthy) {
-        common::log::Debug("heartbeat", msg);
-      } else {
-        common::log::Warn("heartbeat", msg + " (unhealthy)");
-      }
+      MRCD_LOG(stillHealthy ? common::log::Level::Debug : common::log::Level::Warn, "heartbeat",
+               "miss: got=", got, " pong.seq=", got ? pong.seq : 0, " ping.seq=", ping.seq, " misses=", misses,
+               " threshold=", _params.missThreshold, " healthy=", stillHealthy, stillHealthy ? "" : " (unhealthy)");
     } else {
       if (misses > 0) {
-        common::log::Debug("heartbeat", "pong OK seq=" + std::to_string(pong.seq) + " misses reset to 0");
+        MRCD_LOG_DEBUG("heartbeat", "pong OK seq=", pong.seq, " misses reset to 0");
       }
       misses = 0;
       if (pong.seq == ping.seq) {
@@ -2,6 +2,8 @@
 
 #include "common/ipc/BinaryCodec.h"
 #include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
+#include "common/trace/Spans.h"
 
 #include <Poco/Exception.h>
 #include <Poco/Net/NetException.h>
@@ -94,6 +96,7 @@ bool IpcClient::isConnected() const {
 
 void IpcClient::receiverLoop() {
   common::log::SetThreadName("ipc-recv");
+  common::rt::ConfigureCurrentThread("ipc-recv");
   constexpr std::chrono::milliseconds kRecvTimeout{200};
 
   while (_receiverRunning.load() && _connected.load()) {
@@ -108,6 +111,7 @@ void IpcClient::receiverLoop() {
       }
     }
 
+    MRCD_TRACE_SPAN_VAR(span, "ipc.recv");
     const MsgType type = static_cast<MsgType>(header.type);
     if (type == MsgType::Pong && header.payloadSize == sizeof(Pong)) {
       try {
@@ -126,6 +130,7 @@ void IpcClient::receiverLoop() {
         Poco::BinaryReader r(is, Poco::BinaryReader::BIG_ENDIAN_BYTE_ORDER);
         AlgoResult result;
         ReadPayload(r, result);
+        MRCD_TRACE_SET_SEQ(span, result.sensorSeq);
         std::lock_guard<std::mutex> lk(_queueMu);
         _algoResultQueue.push(result);
         _algoResultCv.notify_one();
@@ -0,0 +1,508 @@
+#include "common/log/BinaryLog.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/time/MonotonicClock.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+#include <Poco/SharedMemory.h>
+#include <Poco/Timestamp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common::log::binary {
+
+namespace detail {
+std::atomic<bool> gEnabled{false};
+} // namespace detail
+
+namespace {
+
+/** Per-thread counters; the owning thread is the only writer, GetBinaryLogStats() reads them. */
+struct ThreadStats {
+  std::atomic<std::uint64_t> records{0};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<std::uint64_t> bytes{0};
+  std::atomic<std::uint64_t> segments{0};
+};
+
+void Bump(std::atomic<std::uint64_t>& c, std::uint64_t n = 1) {
+  c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct FormatEntry {
+  std::uint16_t id;
+  std::string module;
+  std::string types;
+  std::string format;
+};
+
+std::mutex gMu;  // everything below except the hot-path reads of gGeneration
+BinaryLogParams gParams;
+std::string gPrefix;  // <dir>/<process>-<pid>
+std::FILE* gFormatFile = nullptr;
+std::vector<FormatEntry> gFormats;
+std::vector<std::shared_ptr<ThreadStats>> gStats;
+std::uint32_t gNextThreadIndex = 1;
+/** Bumped by every Start/Stop; a writer from an older session closes its segment before the next record. */
+std::atomic<std::uint32_t> gGeneration{0};
+std::uint64_t gStartNs = 0;
+std::uint64_t gCommittedBytes = 0;  // charged per segment against max_mb_per_s
+
+std::string OneLine(const char* s) {
+  std::string out(s ? s : "");
+  std::replace(out.begin(), out.end(), '\t', ' ');
+  std::replace(out.begin(), out.end(), '\n', ' ');
+  return out;
+}
+
+/** Caller holds gMu. */
+void WriteFormatLine(const FormatEntry& f) {
+  if (!gFormatFile) return;
+  std::fprintf(gFormatFile, "%u\t%s\t%s\t%s\n", static_cast<unsigned>(f.id), f.module.c_str(), f.types.c_str(),
+               f.format.c_str());
+  std::fflush(gFormatFile);
+}
+
+/**
+ * Charges one segment to the process-wide bandwidth budget. While it is used up, returns false and sets
+ * retryAtNs to when it allows the next one. Caller holds gMu.
+ */
+bool ReserveLocked(std::size_t bytes, std::uint64_t& retryAtNs) {
+  const double bytesPerNs = std::max(gParams.maxMBps, 0.001) * 1024.0 * 1024.0 / 1e9;
+  const auto earliest = gStartNs + static_cast<std::uint64_t>(static_cast<double>(gCommittedBytes) / bytesPerNs);
+  if (common::time::NowMonotonicNs() < earliest) {
+    retryAtNs = earliest;
+    return false;
+  }
+  gCommittedBytes += bytes;
+  return true;
+}
+
+/** One mapped segment file: owned by its writer while current, by binlog_io as a spare or once retired. */
+struct Segment {
+  std::unique_ptr<Poco::SharedMemory> map;
+  char* base{nullptr};
+  std::string path;
+  std::size_t used{0};
+  Segment* next{nullptr};  // Lane::retired link
+};
+
+/**
+ * What one writing thread shares with binlog_io, and nobody else. The writer takes the spare and pushes full
+ * segments onto retired; binlog_io refills the spare and trims and deletes retired segments.
+ */
+struct Lane {
+  std::atomic<Segment*> spare{nullptr};
+  std::atomic<Segment*> retired{nullptr};
+  std::atomic<bool> closed{false};
+  // Set before binlog_io sees the lane, then used by binlog_io only.
+  std::string prefix;  // <dir>/<process>-<pid>-<threadIndex>
+  std::string threadName;
+  std::uint32_t threadIndex{0};
+  std::size_t segmentBytes{0};
+  std::uint32_t maxSegments{1};
+  std::uint32_t segmentNo{0};
+  std::deque<std::string> files;  // trimmed segments, oldest first
+  bool failed{false};
+};
+
+/** Creates, sizes, maps and pre-faults the lane's next segment with its header; nullptr (and a warning) on failure. */
+Segment* MapSegment(Lane& lane) {
+  auto seg = std::make_unique<Segment>();
+  seg->path = lane.prefix + "-" + std::to_string(lane.segmentNo++) + ".seg";
+  try {
+    Poco::File file(seg->path);
+    file.createFile();
+    file.setSize(lane.segmentBytes);
+    seg->map = std::make_unique<Poco::SharedMemory>(file, Poco::SharedMemory::AM_WRITE);
+  } catch (const Poco::Exception& e) {
+    common::log::Warn("binlog", "cannot map segment " + seg->path + ": " + e.displayText() +
+                                    "; binary log off for thread " + lane.threadName);
+    return nullptr;
+  }
+  seg->base = seg->map->begin();
+  // The mapping is process-wide, so touching every page here spares the writer the page faults.
+  for (std::size_t off = 0; off < lane.segmentBytes; off += 4096) seg->base[off] = 0;
+
+  format::SegmentHeader h{};
+  std::memcpy(h.magic, format::kMagic, sizeof h.magic);
+  h.version = format::kVersion;
+  h.headerBytes = sizeof h;
+  h.wallUs = Poco::Timestamp().epochMicroseconds();
+  h.monotonicNs = common::time::NowMonotonicNs();
+  h.pid = static_cast<std::uint32_t>(Poco::Process::id());
+  h.threadIndex = lane.threadIndex;
+  std::memcpy(h.threadName, lane.threadName.data(), std::min(lane.threadName.size(), sizeof h.threadName - 1));
+  std::memcpy(seg->base, &h, sizeof h);
+  seg->used = sizeof h;
+  return seg.release();
+}
+
+/** Unmaps a retired segment, trims the file to the bytes written and deletes the lane's oldest beyond keep. */
+void TrimSegment(Lane& lane, Segment* retired, std::size_t keep) {
+  std::unique_ptr<Segment> seg(retired);
+  seg->map.reset();
+  try {
+    Poco::File(seg->path).setSize(seg->used);
+  } catch (const Poco::Exception&) {
+  }
+  lane.files.push_back(seg->path);
+  while (lane.files.size() > keep) {
+    try {
+      Poco::File(lane.files.front()).remove();
+    } catch (const Poco::Exception&) {
+    }
+    lane.files.pop_front();
+  }
+}
+
+/** Removes an unused spare of a closed lane. */
+void DiscardSegment(Segment* spare) {
+  std::unique_ptr<Segment> seg(spare);
+  seg->map.reset();
+  try {
+    Poco::File(seg->path).remove();
+  } catch (const Poco::Exception&) {
+  }
+}
+
+/** State of the binlog_io thread. Leaked, like the thread itself, so exiting writers never outlive it. */
+struct IoThread {
+  std::mutex mu;
+  std::condition_variable cv;
+  std::vector<std::shared_ptr<Lane>> lanes;
+  /** Set by writers (without mu) when a lane needs a pass: a spare was taken or the thread exited. */
+  std::atomic<bool> wake{false};
+  bool started{false};
+  std::uint64_t passesRequested{0};
+  std::uint64_t passesDone{0};
+};
+
+IoThread& Io() {
+  static auto* io = new IoThread;
+  return *io;
+}
+
+void WakeIo() {
+  auto& io = Io();
+  io.wake.store(true, std::memory_order_release);
+  io.cv.notify_one();
+}
+
+/**
+ * One binlog_io pass over a lane; true once the lane is closed and fully handled. A spare held back by the
+ * bandwidth cap lowers retryAtNs to when it may be mapped.
+ */
+bool ServiceLane(Lane& lane, std::uint64_t& retryAtNs) {
+  const bool closed = lane.closed.load(std::memory_order_acquire);
+  // Pushed newest first; trim oldest first so retention deletes in segment order.
+  Segment* newestFirst = lane.retired.exchange(nullptr, std::memory_order_acquire);
+  Segment* oldestFirst = nullptr;
+  while (newestFirst) {
+    Segment* next = newestFirst->next;
+    newestFirst->next = oldestFirst;
+    oldestFirst = newestFirst;
+    newestFirst = next;
+  }
+  // While the thread writes, its current segment counts against max_segments too.
+  const std::size_t keep = closed ? lane.maxSegments : lane.maxSegments - 1;
+  while (oldestFirst) {
+    Segment* next = oldestFirst->next;
+    TrimSegment(lane, oldestFirst, keep);
+    oldestFirst = next;
+  }
+  if (closed) {
+    if (Segment* spare = lane.spare.exchange(nullptr, std::memory_order_acquire)) DiscardSegment(spare);
+    return true;
+  }
+  if (lane.failed || lane.spare.load(std::memory_order_relaxed)) return false;
+  {
+    std::uint64_t at = 0;
+    std::lock_guard<std::mutex> lk(gMu);
+    if (!ReserveLocked(lane.segmentBytes, at)) {
+      retryAtNs = std::min(retryAtNs, at);
+      return false;
+    }
+  }
+  Segment* spare = MapSegment(lane);
+  if (spare) {
+    lane.spare.store(spare, std::memory_order_release);
+  } else {
+    lane.failed = true;
+  }
+  return false;
+}
+
+void RunIo() {
+  SetThreadName("binlog_io");
+  auto& io = Io();
+  constexpr std::uint64_t kPollNs = 10'000'000;
+  std::uint64_t retryAtNs = std::numeric_limits<std::uint64_t>::max();
+  for (;;) {
+    std::vector<std::shared_ptr<Lane>> lanes;
+    std::uint64_t pass;
+    {
+      std::unique_lock<std::mutex> lk(io.mu);
+      if (io.passesRequested == io.passesDone) {
+        // Writers wake the thread without the lock, so a wakeup can still slip in between the check and the
+        // wait; polling while lanes exist bounds that delay. A spare held back by the bandwidth cap is retried on time.
+        const auto due = [&] { return io.wake.load(std::memory_order_acquire) || io.passesRequested != io.passesDone; };
+        if (io.lanes.empty()) {
+          io.cv.wait(lk, [&] { return !io.lanes.empty() || due(); });
+        } else {
+          const auto now = common::time::NowMonotonicNs();
+          const auto waitNs = retryAtNs > now ? std::min(retryAtNs - now, kPollNs) : 0;
+          io.cv.wait_for(lk, std::chrono::nanoseconds(waitNs), due);
+        }
+      }
+      io.wake.store(false, std::memory_order_relaxed);
+      lanes = io.lanes;
+      pass = io.passesRequested;
+    }
+    std::vector<Lane*> finished;
+    retryAtNs = std::numeric_limits<std::uint64_t>::max();
+    for (const auto& lane : lanes) {
+      if (ServiceLane(*lane, retryAtNs)) finished.push_back(lane.get());
+    }
+    {
+      std::lock_guard<std::mutex> lk(io.mu);
+      io.lanes.erase(std::remove_if(io.lanes.begin(), io.lanes.end(),
+                                    [&](const std::shared_ptr<Lane>& l) {
+                                      return std::find(finished.begin(), finished.end(), l.get()) != finished.end();
+                                    }),
+                     io.lanes.end());
+      io.passesDone = pass;
+    }
+    io.cv.notify_all();
+  }
+}
+
+/** Runs one full binlog_io pass that starts after this call and waits for it. */
+void WaitForIoPass() {
+  auto& io = Io();
+  std::unique_lock<std::mutex> lk(io.mu);
+  if (!io.started) return;
+  const auto target = ++io.passesRequested;
+  io.cv.notify_all();
+  io.cv.wait(lk, [&] { return io.passesDone >= target; });
+}
+
+class Writer {
+public:
+  Writer(std::uint32_t generation, std::shared_ptr<Lane> lane, std::shared_ptr<ThreadStats> stats, Segment* first)
+      : _generation(generation), _lane(std::move(lane)), _stats(std::move(stats)) {
+    if (first) use(first);
+  }
+
+  ~Writer() {
+    retire();
+    _lane->closed.store(true, std::memory_order_release);
+    WakeIo();
+  }
+
+  std::uint32_t generation() const { return _generation; }
+
+  void append(std::uint16_t id, const std::uint64_t* args, std::uint16_t argc) {
+    const std::size_t need = sizeof(format::RecordHeader) + sizeof(std::uint64_t) * argc;
+    if (_used + need > _capacity && !roll()) {
+      Bump(_stats->dropped);
+      return;
+    }
+    char* p = _base + _used;
+    const format::RecordHeader h{common::time::NowMonotonicNs(), id, argc, 0};
+    std::memcpy(p, &h, sizeof h);
+    std::memcpy(p + sizeof h, args, sizeof(std::uint64_t) * argc);
+    _used += need;
+    Bump(_stats->records);
+    Bump(_stats->bytes, need);
+  }
+
+private:
+  /** Swaps in the spare binlog_io has mapped; false (the record is dropped) while there is none. */
+  bool roll() {
+    if (!_lane->spare.load(std::memory_order_relaxed)) return false;
+    Segment* next = _lane->spare.exchange(nullptr, std::memory_order_acquire);
+    retire();
+    use(next);
+    WakeIo();
+    return true;
+  }
+
+  void use(Segment* seg) {
+    _current = seg;
+    _base = seg->base;
+    _capacity = _lane->segmentBytes;
+    _used = seg->used;
+    Bump(_stats->segments);
+    Bump(_stats->bytes, _used);
+  }
+
+  /** Hands the current segment to binlog_io for trimming. */
+  void retire() {
+    if (!_current) return;
+    _current->used = _used;
+    _current->next = _lane->retired.load(std::memory_order_relaxed);
+    while (!_lane->retired.compare_exchange_weak(_current->next, _current, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+    }
+    _current = nullptr;
+    _base = nullptr;
+    _capacity = 0;
+    _used = 0;
+  }
+
+  const std::uint32_t _generation;
+  std::shared_ptr<Lane> _lane;
+  std::shared_ptr<ThreadStats> _stats;
+  Segment* _current{nullptr};
+  char* _base{nullptr};
+  std::size_t _capacity{0};
+  std::size_t _used{0};
+};
+
+thread_local std::unique_ptr<Writer> tWriter;
+
+/** First record of a thread in a session: registers its lane and maps its first segment on this thread. */
+std::unique_ptr<Writer> OpenWriter(std::uint32_t generation) {
+  auto stats = std::make_shared<ThreadStats>();
+  auto lane = std::make_shared<Lane>();
+  bool reserved;
+  std::uint64_t retryAtNs = 0;  // over budget, binlog_io maps the spare once it allows
+  {
+    std::lock_guard<std::mutex> lk(gMu);
+    gStats.push_back(stats);
+    lane->threadIndex = gNextThreadIndex++;
+    lane->prefix = gPrefix + "-" + std::to_string(lane->threadIndex);
+    lane->segmentBytes = std::max<std::size_t>(gParams.segmentBytes, 64 * 1024);
+    lane->maxSegments = std::max<std::uint32_t>(gParams.maxSegments, 1);
+    reserved = ReserveLocked(lane->segmentBytes, retryAtNs);
+  }
+  lane->threadName = CurrentThreadName();
+  Segment* first = reserved ? MapSegment(*lane) : nullptr;
+  lane->failed = reserved && !first;
+  auto writer = std::make_unique<Writer>(generation, lane, std::move(stats), first);
+  {
+    std::lock_guard<std::mutex> lk(Io().mu);
+    Io().lanes.push_back(std::move(lane));
+  }
+  WakeIo();
+  return writer;
+}
+
+Writer& CurrentWriter() {
+  const auto generation = gGeneration.load(std::memory_order_acquire);
+  if (!tWriter || tWriter->generation() != generation) {
+    tWriter.reset();
+    tWriter = OpenWriter(generation);
+  }
+  return *tWriter;
+}
+
+} // namespace
+
+std::uint16_t detail::Register(Site& site, const char* types) {
+  std::lock_guard<std::mutex> lk(gMu);
+  auto id = site.id.load(std::memory_order_relaxed);
+  if (id != 0) return id;
+  if (gFormats.size() >= std::numeric_limits<std::uint16_t>::max() - 1) return 0;
+  id = static_cast<std::uint16_t>(gFormats.size() + 1);
+  gFormats.push_back(FormatEntry{id, OneLine(site.module), types, OneLine(site.format)});
+  WriteFormatLine(gFormats.back());
+  site.id.store(id, std::memory_order_release);
+  return id;
+}
+
+void detail::Append(std::uint16_t id, const std::uint64_t* args, std::uint16_t argc) {
+  if (id == 0) return;
+  CurrentWriter().append(id, args, argc);
+}
+
+BinaryLogParams LoadBinaryLogParams(const common::config::Config& cfg) {
+  BinaryLogParams p;
+  p.enabled = cfg.getBool("binlog.enabled", p.enabled);
+  p.dir = cfg.getString("binlog.dir", p.dir);
+  p.segmentBytes = static_cast<std::size_t>(std::max(64, cfg.getInt("binlog.segment_kb", 4096))) * 1024;
+  p.maxSegments = static_cast<std::uint32_t>(std::max(1, cfg.getInt("binlog.max_segments", 16)));
+  p.maxMBps = std::max(1, cfg.getInt("binlog.max_mb_per_s", 32));
+  return p;
+}
+
+void StartBinaryLog(const BinaryLogParams& params, const std::string& processName) {
+  if (!params.enabled) return;
+  StopBinaryLog();
+
+  std::lock_guard<std::mutex> lk(gMu);
+  try {
+    Poco::File(params.dir).createDirectories();
+  } catch (const Poco::Exception& e) {
+    common::log::Warn("binlog", "cannot create " + params.dir + ": " + e.displayText());
+    return;
+  }
+  gParams = params;
+  gPrefix = Poco::Path(params.dir).append(processName + "-" + std::to_string(Poco::Process::id())).toString();
+  const std::string table = gPrefix + ".fmt";
+  gFormatFile = std::fopen(table.c_str(), "wb");
+  if (!gFormatFile) {
+    common::log::Warn("binlog", "cannot open format table " + table);
+    return;
+  }
+  // Sites registered in an earlier session keep their ids.
+  for (const auto& f : gFormats) WriteFormatLine(f);
+  gStats.clear();
+  gStartNs = common::time::NowMonotonicNs();
+  gCommittedBytes = 0;
+  gGeneration.fetch_add(1, std::memory_order_release);
+  {
+    auto& io = Io();
+    std::lock_guard<std::mutex> ioLk(io.mu);
+    if (!io.started) {
+      io.started = true;
+      std::thread(RunIo).detach();
+    }
+  }
+  detail::gEnabled.store(true);
+  common::log::Info("binlog", "binary log to " + gPrefix + "-*.seg (" + std::to_string(params.segmentBytes / 1024) +
+                                  " KiB segments, " + std::to_string(params.maxSegments) + " per thread, " +
+                                  std::to_string(static_cast<int>(params.maxMBps)) + " MB/s)");
+}
+
+void StopBinaryLog() {
+  detail::gEnabled.store(false);
+  tWriter.reset();
+  {
+    std::lock_guard<std::mutex> lk(gMu);
+    gGeneration.fetch_add(1, std::memory_order_release);
+    if (gFormatFile) {
+      std::fclose(gFormatFile);
+      gFormatFile = nullptr;
+    }
+  }
+  WaitForIoPass();
+}
+
+BinaryLogStats GetBinaryLogStats() {
+  std::lock_guard<std::mutex> lk(gMu);
+  BinaryLogStats s;
+  for (const auto& t : gStats) {
+    s.records += t->records.load(std::memory_order_relaxed);
+    s.dropped += t->dropped.load(std::memory_order_relaxed);
+    s.bytes += t->bytes.load(std::memory_order_relaxed);
+    s.segments += t->segments.load(std::memory_order_relaxed);
+  }
+  return s;
+}
+
+} // namespace common::log::binary
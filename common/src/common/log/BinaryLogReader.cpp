@@ -0,0 +1,224 @@
+#include "common/log/BinaryLogReader.h"
+
+#include "common/text/TextUtil.h"
+
+#include <Poco/DateTimeFormatter.h>
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/LocalDateTime.h>
+#include <Poco/Path.h>
+#include <Poco/Timestamp.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace common::log::binary {
+
+namespace {
+
+using common::text::EndsWith;
+
+/** "<process>-<pid>-<thread>-<n>.seg" -> "<process>-<pid>" (process names may contain '-'). */
+std::string SessionStem(const std::string& fileName) {
+  std::string stem = fileName.substr(0, fileName.size() - 4);
+  for (int i = 0; i < 2; ++i) {
+    const auto dash = stem.rfind('-');
+    if (dash == std::string::npos) return stem;
+    stem.resize(dash);
+  }
+  return stem;
+}
+
+std::string ProcessFromStem(const std::string& stem) {
+  const auto dash = stem.rfind('-');
+  return dash == std::string::npos ? stem : stem.substr(0, dash);
+}
+
+std::string FormatArg(char type, std::uint64_t raw) {
+  switch (type) {
+    case format::kSigned:
+      return std::to_string(static_cast<std::int64_t>(raw));
+    case format::kFloat: {
+      double d;
+      std::memcpy(&d, &raw, sizeof d);
+      char buf[32];
+      std::snprintf(buf, sizeof buf, "%g", d);
+      return buf;
+    }
+    case format::kBool:
+      return raw ? "true" : "false";
+    default:
+      return std::to_string(raw);
+  }
+}
+
+std::string CsvQuoted(const std::string& s) {
+  std::string out = "\"";
+  for (const char c : s) {
+    if (c == '"') out += '"';
+    out += c;
+  }
+  return out + "\"";
+}
+
+} // namespace
+
+bool BinaryLogReader::add(const std::string& path) {
+  try {
+    Poco::File f(path);
+    if (!f.exists()) {
+      _error = path + ": not found";
+      return false;
+    }
+    if (!f.isDirectory()) return addSegment(path);
+
+    std::vector<std::string> names;
+    f.list(names);
+    std::sort(names.begin(), names.end());
+    for (const auto& name : names) {
+      if (EndsWith(name, ".seg") && !addSegment(Poco::Path(path).append(name).toString())) return false;
+    }
+    return true;
+  } catch (const Poco::Exception& e) {
+    _error = path + ": " + e.displayText();
+    return false;
+  }
+}
+
+const std::map<std::uint16_t, FormatInfo>* BinaryLogReader::formatsFor(const std::string& tablePath) {
+  const auto it = _tables.find(tablePath);
+  if (it != _tables.end()) return &it->second;
+
+  std::ifstream in(tablePath);
+  if (!in) return nullptr;
+  auto& table = _tables[tablePath];
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream ss(line);
+    std::string id;
+    FormatInfo info;
+    if (!std::getline(ss, id, '\t') || !std::getline(ss, info.module, '\t') || !std::getline(ss, info.types, '\t')) continue;
+    std::getline(ss, info.format);
+    info.id = static_cast<std::uint16_t>(std::strtoul(id.c_str(), nullptr, 10));
+    if (info.id != 0) table[info.id] = std::move(info);
+  }
+  return &table;
+}
+
+bool BinaryLogReader::addSegment(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    _error = path + ": cannot open";
+    return false;
+  }
+  const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  format::SegmentHeader h{};
+  if (data.size() < sizeof h) {
+    _error = path + ": truncated header";
+    return false;
+  }
+  std::memcpy(&h, data.data(), sizeof h);
+  if (std::memcmp(h.magic, format::kMagic, sizeof h.magic) != 0 || h.version != format::kVersion) {
+    _error = path + ": not a binary log segment (or unsupported version)";
+    return false;
+  }
+
+  const Poco::Path p(path);
+  const std::string stem = SessionStem(p.getFileName());
+  const auto* table = formatsFor(Poco::Path(p).setFileName(stem + ".fmt").toString());
+  const std::string process = ProcessFromStem(stem);
+  const std::string thread(h.threadName, std::find(h.threadName, h.threadName + sizeof h.threadName, '\0'));
+
+  std::size_t pos = h.headerBytes;
+  while (pos + sizeof(format::RecordHeader) <= data.size()) {
+    format::RecordHeader rh;
+    std::memcpy(&rh, data.data() + pos, sizeof rh);
+    const std::size_t size = sizeof rh + sizeof(std::uint64_t) * rh.argc;
+    if (rh.id == 0 || pos + size > data.size()) break;  // unused tail (or a record cut short by a crash)
+
+    DecodedRecord r;
+    r.monotonicNs = rh.monotonicNs;
+    r.wallNs = h.wallUs * 1000 + (static_cast<std::int64_t>(rh.monotonicNs) - static_cast<std::int64_t>(h.monotonicNs));
+    r.pid = h.pid;
+    r.process = process;
+    r.thread = thread;
+    r.id = rh.id;
+    if (table) {
+      const auto it = table->find(rh.id);
+      if (it != table->end()) r.info = &it->second;
+    }
+    if (!r.info) ++_unknown;
+    r.args.resize(rh.argc);
+    std::memcpy(r.args.data(), data.data() + pos + sizeof rh, sizeof(std::uint64_t) * rh.argc);
+    _records.push_back(std::move(r));
+    pos += size;
+  }
+  _sorted = false;
+  return true;
+}
+
+const std::vector<DecodedRecord>& BinaryLogReader::records() {
+  if (!_sorted) {
+    std::stable_sort(_records.begin(), _records.end(),
+                     [](const DecodedRecord& a, const DecodedRecord& b) { return a.monotonicNs < b.monotonicNs; });
+    _sorted = true;
+  }
+  return _records;
+}
+
+std::string FormatMessage(const DecodedRecord& r) {
+  const std::string fmt = r.info ? r.info->format : "event#" + std::to_string(r.id);
+  const auto typeOf = [&](std::size_t i) { return r.info && i < r.info->types.size() ? r.info->types[i] : format::kUnsigned; };
+
+  std::string out;
+  std::size_t next = 0;
+  std::size_t pos = 0;
+  while (pos < fmt.size()) {
+    const auto ph = fmt.find("{}", pos);
+    if (ph == std::string::npos || next >= r.args.size()) {
+      out.append(fmt, pos, std::string::npos);
+      break;
+    }
+    out.append(fmt, pos, ph - pos);
+    out += FormatArg(typeOf(next), r.args[next]);
+    ++next;
+    pos = ph + 2;
+  }
+  for (; next < r.args.size(); ++next) {
+    out += ' ';
+    out += FormatArg(typeOf(next), r.args[next]);
+  }
+  return out;
+}
+
+std::string ToTextLine(const DecodedRecord& r) {
+  const Poco::Timestamp ts(static_cast<Poco::Timestamp::TimeVal>(r.wallNs / 1000));
+  std::string out = Poco::DateTimeFormatter::format(Poco::LocalDateTime(ts), "%Y-%m-%d %H:%M:%S.%F");
+  out += " [" + r.process + ":" + std::to_string(r.pid) + "][" + r.thread + "][" + (r.info ? r.info->module : "?") + "] ";
+  out += FormatMessage(r);
+  return out;
+}
+
+std::string CsvHeader(std::size_t maxArgs) {
+  std::string out = "monotonic_ns,wall_ns,process,pid,thread,module,event";
+  for (std::size_t i = 0; i < maxArgs; ++i) out += ",arg" + std::to_string(i);
+  return out;
+}
+
+std::string ToCsvRow(const DecodedRecord& r, std::size_t maxArgs) {
+  std::string out = std::to_string(r.monotonicNs) + "," + std::to_string(r.wallNs) + "," + CsvQuoted(r.process) + "," +
+                    std::to_string(r.pid) + "," + CsvQuoted(r.thread) + "," + CsvQuoted(r.info ? r.info->module : "") +
+                    "," + CsvQuoted(r.info ? r.info->format : "event#" + std::to_string(r.id));
+  for (std::size_t i = 0; i < maxArgs; ++i) {
+    out += ',';
+    if (i < r.args.size()) out += FormatArg(r.info && i < r.info->types.size() ? r.info->types[i] : format::kUnsigned, r.args[i]);
+  }
+  return out;
+}
+
+} // namespace common::log::binary
@@ -1,30 +1,184 @@
 #include "common/log/Log.h"
 #include "common/config/Config.h"
+#include "common/log/RotatingFileChannel.h"
+#include "common/rt/MpscQueue.h"
 
 #include <Poco/AutoPtr.h>
 #include <Poco/ConsoleChannel.h>
 #include <Poco/FileChannel.h>
 #include <Poco/FormattingChannel.h>
 #include <Poco/Logger.h>
+#include <Poco/NullChannel.h>
 #include <Poco/PatternFormatter.h>
 #include <Poco/Thread.h>
+#include <Poco/Timestamp.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace common::log {
 
+namespace detail {
+std::atomic<int> gMinLevel{static_cast<int>(Level::Info)};
+} // namespace detail
+
 namespace {
 std::string gProcessName = "process";
 Poco::Logger* gLogger = nullptr;
 std::once_flag gOnceFlag;
-Sink gSink;
-std::mutex gSinkMu;
+constexpr int kNoLevel = static_cast<int>(Level::Fatal) + 1;
+std::atomic<int> gLoggerMin{static_cast<int>(Level::Info)};
+
+// --- Sink registry ---------------------------------------------------------------------------------
+
+struct SinkEntry {
+  SinkId id;
+  int minLevel;
+  Sink fn;
+};
+
+/** Immutable once published; AddSink/RemoveSink publish a modified copy. */
+struct SinkList {
+  std::vector<SinkEntry> entries;
+};
+
+std::mutex gSinkMu;  // Registry updates only; delivery never takes it.
+std::atomic<const SinkList*> gSinks{nullptr};
+/** Threads currently delivering through a list they loaded from gSinks. */
+std::atomic<int> gSinkReaders{0};
+std::vector<const SinkList*> gRetiredSinks;  // gSinkMu
+std::atomic<bool> gSinksRetired{false};       // gRetiredSinks is non-empty
+SinkId gNextSinkId = 1;                      // gSinkMu
+SinkId gSetSinkId = 0;                       // gSinkMu; the SetSink() slot
+std::atomic<int> gSinkMin{kNoLevel};
+
+/** Caller holds gSinkMu and has seen no reader. A reader that registers afterwards loads the current list. */
+void FreeRetiredSinksLocked() {
+  for (const auto* l : gRetiredSinks) delete l;
+  gRetiredSinks.clear();
+  gSinksRetired.store(false);
+}
+
+/**
+ * Called by the last reader to leave while retired lists wait. Skips if a registry update holds gSinkMu (that
+ * update frees them itself when it sees no reader; otherwise the next reader to leave retries).
+ */
+void ReclaimRetiredSinks() {
+  std::unique_lock<std::mutex> lk(gSinkMu, std::try_to_lock);
+  if (lk.owns_lock() && gSinkReaders.load() == 0) FreeRetiredSinksLocked();
+}
+
+/** Pins the current sink list for the guard's lifetime. */
+class SinkReadGuard {
+public:
+  SinkReadGuard() {
+    gSinkReaders.fetch_add(1);
+    _list = gSinks.load();
+  }
+  ~SinkReadGuard() {
+    if (gSinkReaders.fetch_sub(1) == 1 && gSinksRetired.load()) ReclaimRetiredSinks();
+  }
+  SinkReadGuard(const SinkReadGuard&) = delete;
+  SinkReadGuard& operator=(const SinkReadGuard&) = delete;
+
+  void deliver(Level level, std::string_view module, std::string_view message) const {
+    if (!_list) return;
+    for (const auto& e : _list->entries) {
+      if (static_cast<int>(level) >= e.minLevel) e.fn(level, module, message);
+    }
+  }
+
+private:
+  const SinkList* _list;
+};
 
 std::string& ThreadNameSlot() {
   static thread_local std::string name;
   return name;
 }
 
+const char* LevelName(Level level) {
+  switch (level) {
+    case Level::Trace:
+      return "TRACE";
+    case Level::Debug:
+      return "DEBUG";
+    case Level::Info:
+      return "INFO";
+    case Level::Warn:
+      return "WARN";
+    case Level::Error:
+      return "ERROR";
+    case Level::Fatal:
+      return "FATAL";
+  }
+  return "INFO";
+}
+
+void UpdateMinLevel() {
+  detail::gMinLevel.store(std::min(gLoggerMin.load(), gSinkMin.load()), std::memory_order_relaxed);
+}
+
+/** Caller holds gSinkMu. Swaps in next; a replaced list is freed once no reader can still hold it. */
+void PublishSinks(std::unique_ptr<SinkList> next) {
+  int minLevel = kNoLevel;
+  for (const auto& e : next->entries) minLevel = std::min(minLevel, e.minLevel);
+  if (const SinkList* old = gSinks.exchange(next.release())) {
+    gRetiredSinks.push_back(old);
+    gSinksRetired.store(true);
+  }
+  // A reader that registers after this check loads the new list, so the retired ones are unreachable.
+  if (gSinkReaders.load() == 0) FreeRetiredSinksLocked();
+  gSinkMin.store(minLevel);
+  UpdateMinLevel();
+}
+
+/** Caller holds gSinkMu. */
+std::unique_ptr<SinkList> CopySinks() {
+  const SinkList* cur = gSinks.load();
+  return cur ? std::make_unique<SinkList>(*cur) : std::make_unique<SinkList>();
+}
+
+void RemoveSinkLocked(SinkId id) {
+  auto next = CopySinks();
+  auto& v = next->entries;
+  v.erase(std::remove_if(v.begin(), v.end(), [id](const SinkEntry& e) { return e.id == id; }), v.end());
+  PublishSinks(std::move(next));
+}
+
+SinkId AddSinkLocked(Sink sink, Level minLevel) {
+  auto next = CopySinks();
+  const SinkId id = gNextSinkId++;
+  next->entries.push_back(SinkEntry{id, static_cast<int>(minLevel), std::move(sink)});
+  PublishSinks(std::move(next));
+  return id;
+}
+
+/** Lowest Level passed by a Poco logger threshold (PRIO_* value; higher lets more through). */
+int MinLevelFromPoco(int threshold) {
+  if (threshold >= Poco::Message::PRIO_TRACE) return static_cast<int>(Level::Trace);
+  if (threshold >= Poco::Message::PRIO_DEBUG) return static_cast<int>(Level::Debug);
+  if (threshold >= Poco::Message::PRIO_INFORMATION) return static_cast<int>(Level::Info);
+  if (threshold >= Poco::Message::PRIO_WARNING) return static_cast<int>(Level::Warn);
+  if (threshold >= Poco::Message::PRIO_ERROR) return static_cast<int>(Level::Error);
+  if (threshold >= Poco::Message::PRIO_FATAL) return static_cast<int>(Level::Fatal);
+  return kNoLevel;
+}
+
+void SyncLoggerLevel() {
+  gLoggerMin.store(MinLevelFromPoco(gLogger->getLevel()));
+  UpdateMinLevel();
+}
+
 void InitPocoLogger() {
     if (gLogger != nullptr) return;  // Already configured by InitFromConfig
     Poco::AutoPtr<Poco::PatternFormatter> pf(new Poco::PatternFormatter);
@@ -38,6 +192,7 @@ void InitPocoLogger() {
     Poco::Logger::root().setLevel("information");
 
     gLogger = &Poco::Logger::get(gProcessName);
+    SyncLoggerLevel();
 }
 
 Poco::Message::Priority ToPoco(Level level) {
@@ -63,64 +218,479 @@ Poco::Logger& GetLogger() {
   return *gLogger;
 }
 
-std::string MakePrefix(const std::string& module) {
-  const auto tid = Poco::Thread::currentTid();
+std::string ThreadLabel() {
   const auto& tn = ThreadNameSlot();
-  std::string thread = tn.empty() ? std::to_string(tid) : tn;
-  return "[" + module + "][" + thread + "] ";
+  return tn.empty() ? std::to_string(Poco::Thread::currentTid()) : tn;
 }
 
-} // namespace
+void Deliver(Poco::Logger& lg, Level level, std::string_view module, const std::string& thread, std::string_view message,
+             const Poco::Timestamp* time) {
+  const auto prio = ToPoco(level);
+  if (lg.is(prio)) {
+    // "[module][thread] message"; Poco::Message keeps its own copy of the text.
+    std::string text;
+    text.reserve(module.size() + thread.size() + message.size() + 5);
+    text.append("[").append(module).append("][").append(thread).append("] ").append(message);
+    Poco::Message msg(lg.name(), text, prio);
+    if (time) {
+      msg.setTime(*time);
+      msg.setThread(thread);
+    }
+    lg.log(msg);
+  }
+}
 
-void Init(const std::string& processName) {
-  gProcessName = processName;
-  (void)GetLogger(); // Eagerly initialize
+// --- Asynchronous backend -------------------------------------------------------------------------
+
+/** Fixed-size queue record; the whole line usually fits inline. */
+struct Record {
+  static constexpr std::size_t kModule = 24;
+  static constexpr std::size_t kThread = 24;
+  static constexpr std::size_t kText = 184;
+
+  Poco::Timestamp::TimeVal time{0};
+  Level level{Level::Info};
+  std::uint16_t textLen{0};
+  char module[kModule]{};
+  char thread[kThread]{};
+  char text[kText]{};
+  std::string* spill{nullptr};  // Owned; set when the message does not fit in text.
+};
+
+void CopyTruncated(char* dst, std::size_t cap, std::string_view src) {
+  const std::size_t n = std::min(src.size(), cap - 1);
+  std::memcpy(dst, src.data(), n);
+  dst[n] = '\0';
 }
 
-void InitFromConfig(const common::config::Config& cfg, const std::string& loggerName) {
-  gProcessName = loggerName;
-  const std::string pattern = cfg.getString("logging.pattern", "%Y-%m-%d %H:%M:%S.%i [%p][%s] %t");
-  const std::string level = cfg.getString("logging.level", "information");
-  const std::string channel = cfg.getString("logging.channel", "console");
-  const std::string filePath = cfg.getString("logging.file", "logs/app.log");
+class AsyncBackend {
+public:
+  explicit AsyncBackend(const AsyncParams& params) : _params(params), _queue(params.capacity) {
+    _thread = std::thread(&AsyncBackend::run, this);
+  }
+
+  ~AsyncBackend() {
+    _running.store(false);
+    wake();
+    _thread.join();
+  }
+
+  /** Returns false when the record was dropped. */
+  bool push(Level level, std::string_view module, std::string_view message) {
+    const auto& tn = ThreadNameSlot();
+    const auto fill = [&](Record& r) {
+      r.time = Poco::Timestamp().epochMicroseconds();
+      r.level = level;
+      CopyTruncated(r.module, Record::kModule, module);
+      if (tn.empty()) {
+        const auto end = std::to_chars(r.thread, r.thread + Record::kThread - 1, Poco::Thread::currentTid()).ptr;
+        *end = '\0';
+      } else {
+        CopyTruncated(r.thread, Record::kThread, tn);
+      }
+      if (message.size() < Record::kText) {
+        std::memcpy(r.text, message.data(), message.size());
+        r.textLen = static_cast<std::uint16_t>(message.size());
+        r.spill = nullptr;
+      } else {
+        r.textLen = 0;
+        r.spill = new std::string(message);
+        _spilled.fetch_add(1, std::memory_order_relaxed);
+      }
+    };
+    while (!_queue.tryEmplace(fill)) {
+      if (_params.overflow == OverflowPolicy::Drop || !_running.load(std::memory_order_relaxed)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      wake();
+      std::this_thread::yield();
+    }
+    if (_idle.load(std::memory_order_seq_cst)) wake();
+    return true;
+  }
+
+  void flush() {
+    const auto target = _queue.enqueued();
+    wake();
+    while (_queue.consumed() < target && _running.load()) {
+      std::this_thread::yield();
+    }
+  }
+
+  AsyncStats stats() const {
+    return AsyncStats{_written.load(std::memory_order_relaxed), _dropped.load(std::memory_order_relaxed),
+                      _spilled.load(std::memory_order_relaxed)};
+  }
 
+  const AsyncParams& params() const { return _params; }
+
+private:
+  void wake() {
+    std::lock_guard<std::mutex> lk(_wakeMu);
+    _wakeCv.notify_one();
+  }
+
+  void run() {
+    SetThreadName("log");
+    constexpr std::size_t kBatch = 256;
+    auto& lg = GetLogger();
+    for (;;) {
+      std::size_t n = 0;
+      {
+        const SinkReadGuard sinks;
+        while (n < kBatch && _queue.tryConsume([&](Record& r) { write(lg, sinks, r); })) ++n;
+      }
+      _written.fetch_add(n, std::memory_order_relaxed);
+      if (n > 0) continue;
+      if (!_running.load()) break;
+
+      // Idle: sleep until a producer sees _idle and wakes us (bounded so a missed wake costs at most 20 ms).
+      std::unique_lock<std::mutex> lk(_wakeMu);
+      _idle.store(true, std::memory_order_seq_cst);
+      if (_queue.consumed() == _queue.enqueued() && _running.load()) {
+        _wakeCv.wait_for(lk, std::chrono::milliseconds(20));
+      }
+      _idle.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  static void write(Poco::Logger& lg, const SinkReadGuard& sinks, Record& r) {
+    std::string text = r.spill ? std::move(*r.spill) : std::string(r.text, r.textLen);
+    delete r.spill;
+    r.spill = nullptr;
+    const std::string module(r.module);
+    const std::string thread(r.thread);
+    const Poco::Timestamp time(r.time);
+    Deliver(lg, r.level, module, thread, text, &time);
+    sinks.deliver(r.level, module, text);
+  }
+
+  AsyncParams _params;
+  common::rt::MpscQueue<Record> _queue;
+  std::atomic<bool> _running{true};
+  std::atomic<bool> _idle{false};
+  std::atomic<std::uint64_t> _written{0};
+  std::atomic<std::uint64_t> _dropped{0};
+  std::atomic<std::uint64_t> _spilled{0};
+  std::mutex _wakeMu;
+  std::condition_variable _wakeCv;
+  std::thread _thread;
+};
+
+std::mutex gAsyncMu;  // Start/stop only.
+std::unique_ptr<AsyncBackend> gAsyncOwner;
+std::atomic<AsyncBackend*> gAsync{nullptr};
+
+/**
+ * Per-thread hazard slot: the backend this thread is calling into right now, or null. Writers only store
+ * to their own slot, so the async path shares no counter between producers; StartAsync scans the slots
+ * and deletes the old backend once none of them holds it.
+ */
+struct AsyncSlot {
+  alignas(64) std::atomic<AsyncBackend*> inUse{nullptr};
+};
+
+struct AsyncSlots {
+  std::mutex mu;
+  std::vector<AsyncSlot*> slots;  // mu
+  std::condition_variable released;
+};
+
+/** Never freed: threads may still log while static objects are destroyed. */
+AsyncSlots& Slots() {
+  static auto* slots = new AsyncSlots;
+  return *slots;
+}
+
+/** Set while StartAsync waits for the old backend's slots to clear; releasing writers then notify it. */
+std::atomic<bool> gAsyncRetiring{false};
+
+/** Registers the calling thread's slot on first use and unregisters it at thread exit. */
+class AsyncSlotHandle {
+public:
+  AsyncSlotHandle() {
+    auto& s = Slots();
+    std::lock_guard<std::mutex> lk(s.mu);
+    s.slots.push_back(&_slot);
+  }
+  ~AsyncSlotHandle() {
+    auto& s = Slots();
+    std::lock_guard<std::mutex> lk(s.mu);
+    s.slots.erase(std::find(s.slots.begin(), s.slots.end(), &_slot));
+  }
+  AsyncSlotHandle(const AsyncSlotHandle&) = delete;
+  AsyncSlotHandle& operator=(const AsyncSlotHandle&) = delete;
+
+  AsyncSlot& slot() { return _slot; }
+
+private:
+  AsyncSlot _slot;
+};
+
+/** Pins the running backend, if any, for the guard's lifetime. Not reentrant: one guard per thread at a time. */
+class AsyncGuard {
+public:
+  AsyncGuard() {
+    static thread_local AsyncSlotHandle handle;
+    _slot = &handle.slot();
+    AsyncBackend* a = gAsync.load(std::memory_order_acquire);
+    if (!a) return;
+    _slot->inUse.store(a, std::memory_order_seq_cst);
+    // StartAsync clears gAsync before it scans the slots: either it sees this slot or this load sees the change.
+    if (gAsync.load(std::memory_order_seq_cst) != a) {
+      release();
+      return;
+    }
+    _backend = a;
+  }
+  ~AsyncGuard() {
+    if (_backend) release();
+  }
+  AsyncGuard(const AsyncGuard&) = delete;
+  AsyncGuard& operator=(const AsyncGuard&) = delete;
+
+  AsyncBackend* get() const { return _backend; }
+
+private:
+  void release() {
+    _slot->inUse.store(nullptr, std::memory_order_seq_cst);
+    if (gAsyncRetiring.load(std::memory_order_seq_cst)) {
+      auto& s = Slots();
+      std::lock_guard<std::mutex> lk(s.mu);
+      s.released.notify_all();
+    }
+  }
+
+  AsyncSlot* _slot;
+  AsyncBackend* _backend{nullptr};
+};
+
+/** Caller holds gAsyncMu and has cleared gAsync. Blocks until no writer still holds old. */
+void WaitForAsyncWriters(const AsyncBackend* old) {
+  auto& s = Slots();
+  gAsyncRetiring.store(true, std::memory_order_seq_cst);
+  {
+    std::unique_lock<std::mutex> lk(s.mu);
+    s.released.wait(lk, [&] {
+      return std::none_of(s.slots.begin(), s.slots.end(),
+                          [old](const AsyncSlot* x) { return x->inUse.load(std::memory_order_seq_cst) == old; });
+    });
+  }
+  gAsyncRetiring.store(false, std::memory_order_relaxed);
+}
+
+OverflowPolicy ParseOverflow(const std::string& s) {
+  return s == "block" ? OverflowPolicy::Block : OverflowPolicy::Drop;
+}
+
+void ApplyOutput(const Output& output) {
   Poco::AutoPtr<Poco::PatternFormatter> pf(new Poco::PatternFormatter);
-  pf->setProperty("pattern", pattern);
+  pf->setProperty("pattern", output.pattern);
   pf->setProperty("times", "local");
 
   Poco::AutoPtr<Poco::Channel> ch;
-  if (channel == "file") {
-    ch = new Poco::FileChannel(filePath);
+  if (output.channel == "file" && output.rotation.enabled()) {
+    ch = new RotatingFileChannel(output.file, output.rotation);
+  } else if (output.channel == "file") {
+    ch = new Poco::FileChannel(output.file);
+  } else if (output.channel == "null") {
+    ch = new Poco::NullChannel;
   } else {
     ch = new Poco::ConsoleChannel;
   }
 
   Poco::AutoPtr<Poco::FormattingChannel> fc(new Poco::FormattingChannel(pf, ch));
   Poco::Logger::root().setChannel(fc);
+  // Loggers created before this call keep their old channel; update the one Write() uses.
+  if (gLogger) gLogger->setChannel(fc);
+}
+
+/** Queues the line when the log thread runs; false means the caller writes synchronously. */
+bool TryWriteAsync(Level level, std::string_view module, std::string_view message) {
+  bool queued = false;
+  {
+    const AsyncGuard guard;
+    // Lines below the logger level still pass IsEnabled() when the sink wants them.
+    if (auto* a = guard.get()) {
+      (void)a->push(level, module, message);
+      queued = true;
+    }
+  }
+  if (queued && level == Level::Fatal) Flush();
+  return queued;
+}
+
+void WriteSync(Level level, std::string_view module, std::string_view message) {
+  auto& lg = GetLogger();
+  if (lg.is(ToPoco(level))) Deliver(lg, level, module, ThreadLabel(), message, nullptr);
+  if (static_cast<int>(level) >= gSinkMin.load(std::memory_order_relaxed)) SinkReadGuard().deliver(level, module, message);
+}
+
+} // namespace
+
+void Init(const std::string& processName) {
+  gProcessName = processName;
+  (void)GetLogger(); // Eagerly initialize
+}
+
+Output LoadOutput(const common::config::Config& cfg) {
+  Output output;
+  output.pattern = cfg.getString("logging.pattern", output.pattern);
+  output.channel = cfg.getString("logging.channel", output.channel);
+  output.file = cfg.getString("logging.file", output.file);
+  auto& r = output.rotation;
+  r.maxBytes = static_cast<std::size_t>(std::max(0, cfg.getInt("logging.rotate_mb", 0))) * 1024 * 1024;
+  r.intervalMinutes = std::max(0, cfg.getInt("logging.rotate_minutes", 0));
+  r.compress = cfg.getBool("logging.compress", r.compress);
+  r.keepFiles = std::max(0, cfg.getInt("logging.keep_files", r.keepFiles));
+  r.keepDays = std::max(0, cfg.getInt("logging.keep_days", r.keepDays));
+  return output;
+}
+
+AsyncParams LoadAsyncParams(const common::config::Config& cfg) {
+  AsyncParams async;
+  async.enabled = cfg.getBool("logging.async", async.enabled);
+  async.capacity = static_cast<std::size_t>(std::max(64, cfg.getInt("logging.queue_records", 8192)));
+  async.overflow = ParseOverflow(cfg.getString("logging.overflow", "drop"));
+  return async;
+}
+
+void InitFromConfig(const common::config::Config& cfg, const std::string& loggerName) {
+  gProcessName = loggerName;
+  const std::string level = cfg.getString("logging.level", "information");
+
+  ApplyOutput(LoadOutput(cfg));
   Poco::Logger::root().setLevel(level);
 
   gLogger = &Poco::Logger::get(loggerName);
+  SyncLoggerLevel();
+
+  StartAsync(LoadAsyncParams(cfg));
+}
+
+void SetOutput(const Output& output) {
+  // The log thread holds the channel while it writes; stop it across the swap and resume with the same parameters.
+  AsyncParams resume;
+  {
+    std::lock_guard<std::mutex> lk(gAsyncMu);
+    if (gAsyncOwner) resume = gAsyncOwner->params();
+  }
+  StopAsync();
+  (void)GetLogger();
+  ApplyOutput(output);
+  if (resume.enabled) StartAsync(resume);
+}
+
+void StartAsync(const AsyncParams& params) {
+  std::lock_guard<std::mutex> lk(gAsyncMu);
+  if (gAsyncOwner) {
+    gAsync.store(nullptr, std::memory_order_seq_cst);
+    WaitForAsyncWriters(gAsyncOwner.get());
+    gAsyncOwner.reset();  // Drains and joins.
+  }
+  if (!params.enabled) return;
+  (void)GetLogger();
+  gAsyncOwner = std::make_unique<AsyncBackend>(params);
+  gAsync.store(gAsyncOwner.get());
+}
+
+void StopAsync() { StartAsync(AsyncParams{}); }
+
+void Flush() {
+  const AsyncGuard guard;
+  if (auto* a = guard.get()) a->flush();
+}
+
+AsyncStats GetAsyncStats() {
+  std::lock_guard<std::mutex> lk(gAsyncMu);
+  return gAsyncOwner ? gAsyncOwner->stats() : AsyncStats{};
 }
 
 void SetThreadName(const std::string& name) {
   ThreadNameSlot() = name;
 }
 
-void SetSink(Sink sink) {
+const std::string& CurrentThreadName() { return ThreadNameSlot(); }
+
+void SetLevel(Level level) {
+  auto& lg = GetLogger();
+  Poco::Logger::root().setLevel(ToPoco(level));
+  lg.setLevel(ToPoco(level));
+  SyncLoggerLevel();
+}
+
+SinkId AddSink(Sink sink, Level minLevel) {
+  if (!sink) return 0;
   std::lock_guard<std::mutex> lk(gSinkMu);
-  gSink = std::move(sink);
+  return AddSinkLocked(std::move(sink), minLevel);
 }
 
-void Write(Level level, const std::string& module, const std::string& message) {
-  auto& lg = GetLogger();
-  lg.log(Poco::Message(lg.name(), MakePrefix(module) + message, ToPoco(level)));
-  Sink copy;
-  {
-    std::lock_guard<std::mutex> lk(gSinkMu);
-    copy = gSink;
+void RemoveSink(SinkId id) {
+  std::lock_guard<std::mutex> lk(gSinkMu);
+  RemoveSinkLocked(id);
+  if (id == gSetSinkId) gSetSinkId = 0;
+}
+
+void SetSink(Sink sink, Level minLevel) {
+  std::lock_guard<std::mutex> lk(gSinkMu);
+  if (gSetSinkId != 0) RemoveSinkLocked(gSetSinkId);
+  gSetSinkId = sink ? AddSinkLocked(std::move(sink), minLevel) : 0;
+}
+
+struct BufferedSink::Record {
+  Level level{Level::Info};
+  std::uint16_t len{0};
+  char text[kLineBytes]{};
+};
+
+BufferedSink::BufferedSink(std::size_t capacity) : _queue(std::make_unique<common::rt::MpscQueue<Record>>(capacity)) {}
+
+BufferedSink::~BufferedSink() = default;
+
+Sink BufferedSink::sink() {
+  auto self = shared_from_this();
+  return [self](Level level, std::string_view module, std::string_view message) { self->push(level, module, message); };
+}
+
+void BufferedSink::push(Level level, std::string_view module, std::string_view message) {
+  const bool queued = _queue->tryEmplace([&](Record& r) {
+    std::size_t n = 0;
+    const auto append = [&](std::string_view part) {
+      const std::size_t k = std::min(part.size(), sizeof r.text - n);
+      std::memcpy(r.text + n, part.data(), k);
+      n += k;
+    };
+    append("[");
+    append(LevelName(level));
+    append("][");
+    append(module);
+    append("] ");
+    append(message);
+    r.level = level;
+    r.len = static_cast<std::uint16_t>(n);
+  });
+  if (!queued) _dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t BufferedSink::drain(std::vector<LogLine>& out) {
+  // Bounded by one ring's worth so producers that keep writing cannot hold the consumer here.
+  const std::size_t max = _queue->capacity();
+  std::size_t n = 0;
+  while (n < max && _queue->tryConsume([&](const Record& r) { out.push_back(LogLine{r.level, std::string(r.text, r.len)}); })) {
+    ++n;
   }
-  if (copy)
-    copy(level, module, message);
+  return n;
+}
+
+void detail::WriteView(Level level, std::string_view module, std::string_view message) {
+  if (!IsEnabled(level) || TryWriteAsync(level, module, message)) return;
+  WriteSync(level, module, message);
+}
+
+void Write(Level level, const std::string& module, const std::string& message) {
+  if (!IsEnabled(level) || TryWriteAsync(level, module, message)) return;
+  WriteSync(level, module, message);
 }
 
 void Trace(const std::string& module, const std::string& message) { Write(Level::Trace, module, message); }
@@ -130,22 +700,18 @@ void Warn(const std::string& module, const std::string& message) { Write(Level::
 void Error(const std::string& module, const std::string&message) { Write(Level::Error, module, message); }
 void Fatal(const std::string& module, const std::string& message) { Write(Level::Fatal, module, message); }
 
-std::string LevelToString(Level level) {
-  switch (level) {
-    case Level::Trace:
-      return "TRACE";
-    case Level::Debug:
-      return "DEBUG";
-    case Level::Info:
-      return "INFO";
-    case Level::Warn:
-      return "WARN";
-    case Level::Error:
-      return "ERROR";
-    case Level::Fatal:
-      return "FATAL";
-  }
-  return "INFO";
+std::string LevelToString(Level level) { return LevelName(level); }
+
+Level LevelFromString(const std::string& name, Level fallback) {
+  std::string s(name);
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if (s == "trace") return Level::Trace;
+  if (s == "debug") return Level::Debug;
+  if (s == "information" || s == "info" || s == "notice") return Level::Info;
+  if (s == "warning" || s == "warn") return Level::Warn;
+  if (s == "error") return Level::Error;
+  if (s == "fatal" || s == "critical") return Level::Fatal;
+  return fallback;
 }
 
 } // namespace common::log
@@ -0,0 +1,239 @@
+#include "common/log/RotatingFileChannel.h"
+
+#include "common/text/TextUtil.h"
+
+#include <Poco/DateTimeFormatter.h>
+#include <Poco/DeflatingStream.h>
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/LocalDateTime.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+#include <Poco/Timestamp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace common::log {
+
+namespace {
+
+constexpr std::int64_t kUsPerMinute = 60LL * 1000 * 1000;
+constexpr std::int64_t kUsPerDay = 24LL * 60 * kUsPerMinute;
+
+using common::text::EndsWith;
+
+std::string DirOf(const std::string& path) {
+  const std::string dir = Poco::Path(path).setFileName("").toString();
+  return dir.empty() ? "." : dir;
+}
+
+std::string ExtensionOf(const std::string& path) {
+  const std::string ext = Poco::Path(path).getExtension();
+  return ext.empty() ? "" : "." + ext;
+}
+
+/** Segment or compressed segment written by any run sharing this stem: <stem>-<8 digit date>-... */
+bool IsSegmentName(const std::string& name, const std::string& stem, const std::string& ext) {
+  if (name.size() <= stem.size() + 9 || name.compare(0, stem.size(), stem) != 0 || name[stem.size()] != '-') return false;
+  for (std::size_t i = stem.size() + 1; i < stem.size() + 9; ++i) {
+    if (name[i] < '0' || name[i] > '9') return false;
+  }
+  return EndsWith(name, ext) || EndsWith(name, ext + ".gz");
+}
+
+/**
+ * Oldest first: by the run tag before the last '-', then by the segment number after it, compared as a number
+ * so segment 10000 sorts after 9999 even though the names are only zero-padded to four digits.
+ */
+bool SegmentOlder(const std::string& a, const std::string& b) {
+  const std::size_t da = a.rfind('-');
+  const std::size_t db = b.rfind('-');
+  const int byRun = a.compare(0, da, b, 0, db);
+  if (byRun != 0) return byRun < 0;
+  return std::strtoull(a.c_str() + da + 1, nullptr, 10) < std::strtoull(b.c_str() + db + 1, nullptr, 10);
+}
+
+} // namespace
+
+RotatingFileChannel::RotatingFileChannel(const std::string& path, const FileRotation& rotation)
+    : _dir(DirOf(path)), _stem(Poco::Path(path).getBaseName()), _ext(ExtensionOf(path)), _rotation(rotation) {}
+
+RotatingFileChannel::~RotatingFileChannel() {
+  close();
+}
+
+void RotatingFileChannel::open() {
+  std::lock_guard<std::mutex> lk(_mu);
+  if (_running) return;
+  try {
+    Poco::File(_dir).createDirectories();
+  } catch (const Poco::Exception&) {
+    // fopen below fails too and log() drops lines until the next segment opens.
+  }
+  const Poco::Timestamp now;
+  _runTag = Poco::DateTimeFormatter::format(Poco::LocalDateTime(now), "%Y%m%d-%H%M%S") + "-" +
+            std::to_string(Poco::Process::id());
+  _nextSegment = 1;
+  _current.path = nextSegmentPath();
+  _current.file = std::fopen(_current.path.c_str(), "ab");
+  _bytes = 0;
+  _rotateAtUs = _rotation.intervalMinutes > 0 ? now.epochMicroseconds() + _rotation.intervalMinutes * kUsPerMinute : 0;
+  _running = true;
+  _thread = std::thread(&RotatingFileChannel::run, this);
+}
+
+void RotatingFileChannel::close() {
+  {
+    std::lock_guard<std::mutex> lk(_mu);
+    if (!_running) return;
+    _running = false;
+  }
+  _cv.notify_all();
+  _thread.join();
+
+  std::vector<Segment> full;
+  Segment current;
+  Segment spare;
+  {
+    std::lock_guard<std::mutex> lk(_mu);
+    full.swap(_full);
+    std::swap(current, _current);
+    std::swap(spare, _spare);
+  }
+  for (auto& seg : full) archive(seg);
+  if (spare.file) {
+    std::fclose(spare.file);
+    std::remove(spare.path.c_str());
+  }
+  if (current.file) std::fclose(current.file);
+  purge(current.path, "");
+}
+
+void RotatingFileChannel::log(const Poco::Message& msg) {
+  const std::string& text = msg.getText();
+  std::unique_lock<std::mutex> lk(_mu);
+  if (!_running) {
+    lk.unlock();
+    open();
+    lk.lock();
+  }
+  const auto nowUs = msg.getTime().epochMicroseconds();
+  if ((_rotation.maxBytes > 0 && _bytes > 0 && _bytes + text.size() + 1 > _rotation.maxBytes) ||
+      (_rotateAtUs > 0 && nowUs >= _rotateAtUs)) {
+    rotateLocked(nowUs);
+  }
+  if (!_current.file) return;
+  std::fwrite(text.data(), 1, text.size(), _current.file);
+  std::fputc('\n', _current.file);
+  std::fflush(_current.file);
+  _bytes += text.size() + 1;
+}
+
+void RotatingFileChannel::rotateLocked(std::int64_t nowUs) {
+  // Without a spare the current segment keeps growing and the deadline stays, so the next write retries; the
+  // archive thread is already opening one.
+  if (!_spare.file) return;
+  if (_rotateAtUs > 0 && nowUs >= _rotateAtUs) _rotateAtUs = nowUs + _rotation.intervalMinutes * kUsPerMinute;
+  if (_bytes == 0) return;
+  if (_current.file) _full.push_back(_current);
+  _current = _spare;
+  _spare = Segment{};
+  _bytes = 0;
+  _cv.notify_one();
+}
+
+std::string RotatingFileChannel::nextSegmentPath() {
+  char n[16];
+  std::snprintf(n, sizeof n, "%04u", _nextSegment++);
+  return Poco::Path(_dir).append(_stem + "-" + _runTag + "-" + n + _ext).toString();
+}
+
+void RotatingFileChannel::archive(Segment& seg) {
+  std::fclose(seg.file);
+  seg.file = nullptr;
+  if (!_rotation.compress) return;
+  try {
+    {
+      std::ifstream in(seg.path, std::ios::binary);
+      std::ofstream out(seg.path + ".gz", std::ios::binary);
+      if (!in || !out) return;
+      Poco::DeflatingOutputStream gz(out, Poco::DeflatingStreamBuf::STREAM_GZIP);
+      gz << in.rdbuf();
+      gz.close();
+      if (!out) return;
+    }
+    Poco::File(seg.path).remove();
+  } catch (const Poco::Exception&) {
+    // Keep the uncompressed segment; retention still applies to it.
+  }
+}
+
+void RotatingFileChannel::purge(const std::string& current, const std::string& spare) {
+  if (_rotation.keepFiles <= 0 && _rotation.keepDays <= 0) return;
+  try {
+    std::vector<std::string> names;
+    Poco::File(_dir).list(names);
+    std::vector<std::string> closed;
+    for (const auto& name : names) {
+      if (!IsSegmentName(name, _stem, _ext)) continue;
+      const std::string path = Poco::Path(_dir).append(name).toString();
+      if (path != current && path != spare) closed.push_back(path);
+    }
+    // Names start with the run's start time and then the segment number.
+    std::sort(closed.begin(), closed.end(), SegmentOlder);
+    const std::size_t keep = _rotation.keepFiles > 0 ? static_cast<std::size_t>(_rotation.keepFiles) : closed.size();
+    const std::size_t excess = closed.size() > keep ? closed.size() - keep : 0;
+    const std::int64_t cutoffUs = Poco::Timestamp().epochMicroseconds() - _rotation.keepDays * kUsPerDay;
+    for (std::size_t i = 0; i < closed.size(); ++i) {
+      Poco::File f(closed[i]);
+      if (i < excess || (_rotation.keepDays > 0 && f.getLastModified().epochMicroseconds() < cutoffUs)) f.remove();
+    }
+  } catch (const Poco::Exception&) {
+    // Another process may be purging the same directory; the next pass catches up.
+  }
+}
+
+void RotatingFileChannel::run() {
+  SetThreadName("log_archive");
+  for (;;) {
+    std::vector<Segment> full;
+    bool needSpare = false;
+    bool running = false;
+    std::string current;
+    std::string spare;
+    {
+      std::unique_lock<std::mutex> lk(_mu);
+      // The timeout applies keepDays while no segment fills up.
+      _cv.wait_for(lk, std::chrono::minutes(1), [&] { return !_running || !_full.empty() || !_spare.file; });
+      full.swap(_full);
+      current = _current.path;
+      spare = _spare.path;
+      running = _running;
+      needSpare = running && !_spare.file;
+      if (needSpare) spare = nextSegmentPath();
+    }
+    bool spareFailed = false;
+    if (needSpare) {
+      // Opened outside the lock so writers never wait on the file system.
+      std::FILE* file = std::fopen(spare.c_str(), "ab");
+      std::lock_guard<std::mutex> lk(_mu);
+      _spare = Segment{file, spare};
+      spareFailed = file == nullptr;
+    }
+    for (auto& seg : full) archive(seg);
+    // A segment rotated out during this pass is the newest closed one, so retention never selects it.
+    purge(current, spare);
+    if (!running) break;
+    if (spareFailed) {
+      // Disk full or no permission: retry once a second instead of spinning on the empty spare.
+      std::unique_lock<std::mutex> lk(_mu);
+      _cv.wait_for(lk, std::chrono::seconds(1), [&] { return !_running; });
+    }
+  }
+}
+
+} // namespace common::log
@@ -0,0 +1,204 @@
+#include "common/rt/PeriodicTimer.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/CpuRelax.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/prctl.h>
+#include <time.h>
+#endif
+
+namespace common::rt {
+
+namespace {
+
+std::int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void SleepUntilNs(std::int64_t deadlineNs) {
+#if defined(__linux__)
+  // steady_clock is CLOCK_MONOTONIC on Linux, so deadlines carry over unchanged.
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(deadlineNs / 1000000000);
+  ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+  }
+#else
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadlineNs)));
+#endif
+}
+
+// Single writer: plain load/store keeps the loop thread free of locked read-modify-writes.
+void Add(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+  a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+void Max(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+  if (v > a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
+}
+
+} // namespace
+
+const char* ToString(OverrunPolicy policy) {
+  switch (policy) {
+    case OverrunPolicy::Skip:
+      return "skip";
+    case OverrunPolicy::CatchUp:
+      return "catchup";
+    case OverrunPolicy::Rephase:
+      return "rephase";
+  }
+  return "skip";
+}
+
+OverrunPolicy ParseOverrunPolicy(const std::string& text, OverrunPolicy fallback) {
+  if (text == "skip") return OverrunPolicy::Skip;
+  if (text == "catchup") return OverrunPolicy::CatchUp;
+  if (text == "rephase") return OverrunPolicy::Rephase;
+  return fallback;
+}
+
+const char* ToString(TimerMode mode) {
+  switch (mode) {
+    case TimerMode::Sleep:
+      return "sleep";
+    case TimerMode::Hybrid:
+      return "hybrid";
+    case TimerMode::Spin:
+      return "spin";
+  }
+  return "sleep";
+}
+
+TimerMode ParseTimerMode(const std::string& text, TimerMode fallback) {
+  if (text == "sleep") return TimerMode::Sleep;
+  if (text == "hybrid") return TimerMode::Hybrid;
+  if (text == "spin") return TimerMode::Spin;
+  return fallback;
+}
+
+std::string Describe(const PeriodicStats& stats) {
+  return "cycles=" + std::to_string(stats.cycles) + " overruns=" + std::to_string(stats.overruns) +
+         " skipped=" + std::to_string(stats.skippedCycles) +
+         " jitter_mean_us=" + std::to_string(static_cast<std::uint64_t>(stats.jitter.meanNs() / 1000.0)) +
+         " jitter_p99_us=" + std::to_string(stats.jitter.percentileNs(0.99) / 1000) +
+         " jitter_max_us=" + std::to_string(stats.jitter.maxNs / 1000) +
+         " overrun_max_us=" + std::to_string(stats.overrunMaxNs / 1000) +
+         " spin_ms=" + std::to_string(stats.spinNs / 1000000);
+}
+
+PeriodicTimer::PeriodicTimer(Params params) : _params(params) {
+  if (_params.period.count() <= 0) _params.period = std::chrono::nanoseconds(1);
+}
+
+std::chrono::nanoseconds PeriodicTimer::PeriodForRate(int rateHz) {
+  return std::chrono::nanoseconds(1000000000LL / std::max(1, rateHz));
+}
+
+PeriodicTimer::Params PeriodicTimer::WithRate(Params params, int rateHz) {
+  params.period = PeriodForRate(rateHz);
+  return params;
+}
+
+void PeriodicTimer::start() {
+  if (_params.timerSlack.count() > 0) {
+#if defined(__linux__)
+    if (prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(_params.timerSlack.count()), 0, 0, 0) != 0) {
+      common::log::Warn("rt", "PR_SET_TIMERSLACK failed, keeping default timer slack");
+    }
+#else
+    common::log::Warn("rt", "timer slack is only adjustable on Linux; ignoring");
+#endif
+  }
+  _deadlineNs = NowNs();
+}
+
+std::uint64_t PeriodicTimer::wait() {
+  const std::int64_t period = _params.period.count();
+  _deadlineNs += period;
+  Add(_cycles, 1);
+
+  const std::int64_t now = NowNs();
+  std::uint64_t skipped = 0;
+  if (now > _deadlineNs) {
+    const std::int64_t late = now - _deadlineNs;
+    Add(_overruns, 1);
+    Max(_overrunMaxNs, static_cast<std::uint64_t>(late));
+
+    switch (_params.overrun) {
+      case OverrunPolicy::CatchUp:
+        if (late < static_cast<std::int64_t>(_params.maxCatchUp) * period) return 0;
+        _deadlineNs = now;
+        return 0;
+      case OverrunPolicy::Rephase:
+        _deadlineNs = now;
+        return 0;
+      case OverrunPolicy::Skip:
+        skipped = static_cast<std::uint64_t>(late / period) + 1;
+        _deadlineNs += static_cast<std::int64_t>(skipped) * period;
+        Add(_skipped, skipped);
+        break;
+    }
+  }
+
+  sleepToDeadline();
+  return skipped;
+}
+
+void PeriodicTimer::sleepToDeadline() {
+  if (_params.mode == TimerMode::Sleep) {
+    SleepUntilNs(_deadlineNs);
+    recordWake(static_cast<std::uint64_t>(std::max<std::int64_t>(0, NowNs() - _deadlineNs)));
+    return;
+  }
+
+  if (_params.mode == TimerMode::Hybrid) {
+    const std::int64_t wakeAt = _deadlineNs - _params.spinMargin.count();
+    if (NowNs() < wakeAt) SleepUntilNs(wakeAt);
+  }
+
+  const std::int64_t spinStart = NowNs();
+  std::int64_t now = spinStart;
+  while (now < _deadlineNs) {
+    CpuRelax();
+    now = NowNs();
+  }
+  Add(_spinNs, static_cast<std::uint64_t>(now - spinStart));
+  recordWake(static_cast<std::uint64_t>(now - _deadlineNs));
+}
+
+void PeriodicTimer::recordWake(std::uint64_t jitterNs) {
+  _jitter.record(jitterNs);
+  _jitterLastNs.store(jitterNs, std::memory_order_relaxed);
+}
+
+PeriodicStats PeriodicTimer::stats() const {
+  PeriodicStats s;
+  s.cycles = _cycles.load(std::memory_order_relaxed);
+  s.overruns = _overruns.load(std::memory_order_relaxed);
+  s.skippedCycles = _skipped.load(std::memory_order_relaxed);
+  s.jitter = _jitter.snapshot();
+  s.jitterLastNs = _jitterLastNs.load(std::memory_order_relaxed);
+  s.overrunMaxNs = _overrunMaxNs.load(std::memory_order_relaxed);
+  s.spinNs = _spinNs.load(std::memory_order_relaxed);
+  return s;
+}
+
+PeriodicTimer::Params LoadTimerParams(const common::config::Config& cfg, const std::string& prefix,
+                                      OverrunPolicy defaultOverrun) {
+  PeriodicTimer::Params p;
+  p.overrun = ParseOverrunPolicy(cfg.getString(prefix + ".overrun", ToString(defaultOverrun)), defaultOverrun);
+  p.mode = ParseTimerMode(cfg.getString(prefix + ".timer_mode", "sleep"), TimerMode::Sleep);
+  p.spinMargin = std::chrono::microseconds(std::max(0, cfg.getInt(prefix + ".spin_margin_us", 200)));
+  p.timerSlack = std::chrono::microseconds(std::max(0, cfg.getInt(prefix + ".timer_slack_us", 0)));
+  return p;
+}
+
+} // namespace common::rt
@@ -0,0 +1,75 @@
+#include "common/rt/SeqNotifier.h"
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace common::rt {
+
+namespace {
+
+std::uint64_t NowNs() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(SeqNotifier::Clock::now().time_since_epoch()).count());
+}
+
+#if defined(__linux__)
+// FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout, which is steady_clock on Linux.
+void FutexWaitUntil(std::atomic<std::uint32_t>* word, std::uint32_t expected, SeqNotifier::Clock::time_point deadline) {
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns % 1000000000);
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT_BITSET_PRIVATE, expected, &ts, nullptr,
+          FUTEX_BITSET_MATCH_ANY);
+}
+
+void FutexWakeAll(std::atomic<std::uint32_t>* word) {
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+void SeqNotifier::publish(std::uint64_t seq) {
+  _publishNs.store(NowNs(), std::memory_order_relaxed);
+  _seq.store(seq, std::memory_order_release);
+  // seq_cst increment + load pairs with the waiter's increment + re-check: either the waiter sees the new
+  // seq/epoch, or we see the waiter and wake it.
+  _epoch.fetch_add(1, std::memory_order_seq_cst);
+#if defined(__linux__)
+  if (_waiters.load(std::memory_order_seq_cst) == 0) return;
+  FutexWakeAll(&_epoch);
+#else
+  // A waiter holds _mu from its increment of _waiters until it blocks, so checking the count under _mu cannot
+  // fall between its predicate check and its wait (the lost wakeup an unlocked check allows).
+  std::lock_guard<std::mutex> lk(_mu);
+  if (_waiters.load(std::memory_order_relaxed) != 0) _cv.notify_all();
+#endif
+}
+
+std::uint64_t SeqNotifier::waitNewer(std::uint64_t lastSeen, Clock::time_point deadline) const {
+#if defined(__linux__)
+  for (;;) {
+    const std::uint32_t epoch = _epoch.load(std::memory_order_acquire);
+    const std::uint64_t seq = _seq.load(std::memory_order_acquire);
+    if (seq != lastSeen || Clock::now() >= deadline) return seq;
+    _waiters.fetch_add(1, std::memory_order_seq_cst);
+    // Returns at once (EAGAIN) if a publish bumped the epoch after we sampled it.
+    FutexWaitUntil(&_epoch, epoch, deadline);
+    _waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+#else
+  std::unique_lock<std::mutex> lk(_mu);
+  _waiters.fetch_add(1, std::memory_order_seq_cst);
+  _cv.wait_until(lk, deadline, [&] { return _seq.load(std::memory_order_acquire) != lastSeen; });
+  _waiters.fetch_sub(1, std::memory_order_relaxed);
+  return _seq.load(std::memory_order_acquire);
+#endif
+}
+
+} // namespace common::rt
@@ -0,0 +1,216 @@
+#include "common/rt/ThreadPolicy.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#if defined(__linux__)
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace common::rt {
+
+namespace {
+
+std::mutex gMu;
+std::map<std::string, ThreadRtSpec> gSpecs;
+ProcessRtParams gProcess;
+
+std::string CpuListToString(const std::vector<int>& cpus) {
+  std::string out;
+  for (const int c : cpus) {
+    if (!out.empty()) out += ',';
+    out += std::to_string(c);
+  }
+  return out.empty() ? "inherit" : out;
+}
+
+#if defined(__linux__)
+void LockAndPrefault(const ProcessRtParams& p) {
+  if (p.lockMemory) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      common::log::Warn("rt", std::string("mlockall failed (") + std::strerror(errno) +
+                                  "); raise RLIMIT_MEMLOCK (ulimit -l) or grant CAP_IPC_LOCK. Memory stays pageable");
+    } else {
+      common::log::Info("rt", "memory locked (mlockall current+future)");
+    }
+  }
+  if (p.prefaultHeapBytes > 0) {
+#if defined(__GLIBC__)
+    // Keep freed memory in the heap and serve large blocks from it, so the touched pages stay usable.
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    const long page = sysconf(_SC_PAGESIZE);
+    auto* block = static_cast<char*>(std::malloc(p.prefaultHeapBytes));
+    if (block) {
+      for (std::size_t off = 0; off < p.prefaultHeapBytes; off += static_cast<std::size_t>(page)) block[off] = 0;
+      std::free(block);
+      common::log::Info("rt", "prefaulted " + std::to_string(p.prefaultHeapBytes >> 20) + " MB heap");
+    } else {
+      common::log::Warn("rt", "heap prefault allocation failed");
+    }
+  }
+}
+
+/** Stack left below the current frame on this thread, or 0 if it cannot be read. */
+std::size_t StackRoom() {
+  pthread_attr_t attr;
+  if (pthread_getattr_np(pthread_self(), &attr) != 0) return 0;
+  void* low = nullptr;
+  std::size_t size = 0;
+  const int rc = pthread_attr_getstack(&attr, &low, &size);
+  pthread_attr_destroy(&attr);
+  if (rc != 0) return 0;
+  const char here = 0;
+  const auto sp = reinterpret_cast<std::uintptr_t>(&here);
+  const auto base = reinterpret_cast<std::uintptr_t>(low);
+  return sp > base ? sp - base : 0;
+}
+
+/**
+ * Touches bytes of stack below the current frame, clamped to the stack that is left minus a margin for the
+ * frames the thread still needs, so a large rt.stack_prefault_kb warns instead of overflowing.
+ */
+void PrefaultStack(const std::string& name, std::size_t bytes) {
+  constexpr std::size_t kMargin = 64 * 1024;
+  const std::size_t room = StackRoom();
+  const std::size_t limit = room > kMargin ? room - kMargin : 0;
+  if (bytes > limit) {
+    common::log::Warn("rt", "thread " + name + ": stack_prefault_kb=" + std::to_string(bytes >> 10) +
+                                " exceeds the stack left (" + std::to_string(room >> 10) + " KB); prefaulting " +
+                                std::to_string(limit >> 10) + " KB");
+    bytes = limit;
+  }
+  if (bytes == 0) return;
+  // alloca'd region below the current frame; volatile writes so the touches are not elided.
+  auto* p = static_cast<volatile char*>(alloca(bytes));
+  const long page = sysconf(_SC_PAGESIZE);
+  for (std::size_t off = 0; off < bytes; off += static_cast<std::size_t>(page)) p[off] = 0;
+}
+
+void ApplySpec(const std::string& name, const ThreadRtSpec& spec) {
+  std::vector<int> applied;
+  if (!spec.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int c : spec.cpus) {
+      if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+    }
+    const int rc = pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+    if (rc != 0) {
+      common::log::Warn("rt", "thread " + name + ": affinity " + CpuListToString(spec.cpus) + " rejected (" +
+                                  std::strerror(rc) + "); running on inherited CPU set");
+    } else {
+      applied = spec.cpus;
+    }
+  }
+
+  if (spec.policy != SchedPolicy::Other) {
+    const int policy = spec.policy == SchedPolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+    sched_param sp{};
+    sp.sched_priority = std::clamp(spec.priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+    const int rc = pthread_setschedparam(pthread_self(), policy, &sp);
+    if (rc != 0) {
+      common::log::Warn("rt", "thread " + name + ": " + ToString(spec.policy) + "/" +
+                                  std::to_string(sp.sched_priority) + " denied (" + std::strerror(rc) +
+                                  "); needs CAP_SYS_NICE or an rtprio limit. Staying on SCHED_OTHER");
+      return;
+    }
+  }
+
+  common::log::Info("rt", "thread " + name + ": " + ToString(spec.policy) + "/" + std::to_string(spec.priority) +
+                              " cpus=" + CpuListToString(applied));
+}
+#endif
+
+} // namespace
+
+const char* ToString(SchedPolicy policy) {
+  switch (policy) {
+    case SchedPolicy::Other:
+      return "other";
+    case SchedPolicy::Fifo:
+      return "fifo";
+    case SchedPolicy::RoundRobin:
+      return "rr";
+  }
+  return "other";
+}
+
+SchedPolicy ParseSchedPolicy(const std::string& text, SchedPolicy fallback) {
+  if (text == "other") return SchedPolicy::Other;
+  if (text == "fifo") return SchedPolicy::Fifo;
+  if (text == "rr") return SchedPolicy::RoundRobin;
+  return fallback;
+}
+
+void InitFromConfig(const common::config::Config& cfg) {
+  ProcessRtParams process;
+  process.lockMemory = cfg.getBool("rt.lock_memory", false);
+  process.prefaultHeapBytes = static_cast<std::size_t>(std::max(0, cfg.getInt("rt.prefault_heap_mb", 0))) << 20;
+  process.stackPrefaultBytes = static_cast<std::size_t>(std::max(0, cfg.getInt("rt.stack_prefault_kb", 0))) << 10;
+
+  std::map<std::string, ThreadRtSpec> specs;
+  for (const auto& name : cfg.keys("rt")) {
+    const std::string prefix = "rt." + name;
+    if (cfg.keys(prefix).empty()) continue;  // scalar [rt] key, not a thread section
+    ThreadRtSpec spec;
+    const std::string policy = cfg.getString(prefix + ".policy", "other");
+    spec.policy = ParseSchedPolicy(policy, SchedPolicy::Other);
+    if (ToString(spec.policy) != policy) {
+      common::log::Warn("rt", "thread " + name + ": unknown policy '" + policy + "', using other");
+    }
+    spec.priority = cfg.getInt(prefix + ".priority", 0);
+    spec.cpus = cfg.getIntList(prefix + ".cpus", {});
+    specs[name] = spec;
+  }
+
+  const bool anySpecs = !specs.empty();
+  {
+    std::lock_guard<std::mutex> lk(gMu);
+    gSpecs = std::move(specs);
+    gProcess = process;
+  }
+
+#if defined(__linux__)
+  (void)anySpecs;
+  LockAndPrefault(process);
+#else
+  if (process.lockMemory || process.prefaultHeapBytes > 0 || anySpecs) {
+    common::log::Warn("rt", "[rt] settings are only applied on Linux; running with default scheduling");
+  }
+#endif
+}
+
+void ConfigureCurrentThread(const std::string& name) {
+  ThreadRtSpec spec;
+  std::size_t stackBytes = 0;
+  {
+    std::lock_guard<std::mutex> lk(gMu);
+    const auto it = gSpecs.find(name);
+    if (it == gSpecs.end()) return;
+    spec = it->second;
+    stackBytes = gProcess.stackPrefaultBytes;
+  }
+#if defined(__linux__)
+  if (stackBytes > 0) PrefaultStack(name, stackBytes);
+  ApplySpec(name, spec);
+#else
+  (void)stackBytes;
+#endif
+}
+
+} // namespace common::rt
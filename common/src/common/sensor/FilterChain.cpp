@@ -0,0 +1,373 @@
+#include "common/sensor/FilterChain.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/AlignedBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace common::sensor {
+
+namespace {
+
+// Kernels run over fixed-size lane blocks; the frame stride is a multiple of this.
+constexpr std::size_t kLanes = 8;
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<std::string> Split(const std::string& text, char sep) {
+  std::vector<std::string> out;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    const auto b = item.find_first_not_of(" \t");
+    const auto e = item.find_last_not_of(" \t");
+    out.push_back(b == std::string::npos ? std::string() : item.substr(b, e - b + 1));
+  }
+  return out;
+}
+
+bool ParseDoubles(const std::string& text, std::vector<double>& out) {
+  out.clear();
+  for (const auto& item : Split(text, ',')) {
+    try {
+      std::size_t used = 0;
+      out.push_back(std::stod(item, &used));
+      if (used != item.size()) return false;
+    } catch (...) {
+      return false;
+    }
+  }
+  return !out.empty();
+}
+
+/** RBJ audio-EQ-cookbook low/high-pass, normalized to a0 = 1. */
+void DesignBiquad(bool highPass, double cutoffHz, double q, double sampleRateHz, double (&c)[5]) {
+  const double w0 = 2.0 * kPi * cutoffHz / sampleRateHz;
+  const double cosw = std::cos(w0);
+  const double alpha = std::sin(w0) / (2.0 * q);
+  const double a0 = 1.0 + alpha;
+  const double b1 = highPass ? -(1.0 + cosw) : (1.0 - cosw);
+  const double b0 = highPass ? (1.0 + cosw) / 2.0 : (1.0 - cosw) / 2.0;
+  c[0] = b0 / a0;
+  c[1] = b1 / a0;
+  c[2] = b0 / a0;
+  c[3] = -2.0 * cosw / a0;
+  c[4] = (1.0 - alpha) / a0;
+}
+
+} // namespace
+
+bool ParseFilterChain(const std::string& text, double sampleRateHz, FilterChainSpec& out, std::string& error) {
+  out.clear();
+  for (const auto& stageText : Split(text, '|')) {
+    if (stageText.empty()) continue;
+    const auto parts = Split(stageText, ':');
+    const std::string& name = parts[0];
+    FilterSpec spec;
+
+    if (name == "ma") {
+      int window = 0;
+      try {
+        window = parts.size() > 1 ? std::stoi(parts[1]) : 0;
+      } catch (...) {
+      }
+      if (window < 1) {
+        error = "ma needs a window >= 1: " + stageText;
+        return false;
+      }
+      spec.kind = FilterSpec::Kind::MovingAverage;
+      spec.window = static_cast<std::size_t>(window);
+    } else if (name == "biquad_lp" || name == "biquad_hp") {
+      double cutoff = 0.0;
+      double q = 0.7071067811865476;
+      try {
+        if (parts.size() > 1) cutoff = std::stod(parts[1]);
+        if (parts.size() > 2) q = std::stod(parts[2]);
+      } catch (...) {
+        cutoff = 0.0;
+      }
+      if (cutoff <= 0.0 || cutoff >= sampleRateHz / 2.0 || q <= 0.0) {
+        error = "biquad cutoff must be in (0, rate/2) and Q > 0: " + stageText;
+        return false;
+      }
+      spec.kind = FilterSpec::Kind::Biquad;
+      DesignBiquad(name == "biquad_hp", cutoff, q, sampleRateHz, spec.biquad);
+    } else if (name == "biquad") {
+      std::vector<double> c;
+      if (parts.size() < 2 || !ParseDoubles(parts[1], c) || c.size() != 5) {
+        error = "biquad needs b0,b1,b2,a1,a2: " + stageText;
+        return false;
+      }
+      spec.kind = FilterSpec::Kind::Biquad;
+      std::copy(c.begin(), c.end(), spec.biquad);
+    } else if (name == "fir") {
+      if (parts.size() < 2 || !ParseDoubles(parts[1], spec.taps)) {
+        error = "fir needs at least one tap: " + stageText;
+        return false;
+      }
+      spec.kind = FilterSpec::Kind::Fir;
+    } else {
+      error = "unknown filter stage: " + stageText;
+      return false;
+    }
+    out.push_back(std::move(spec));
+  }
+  return true;
+}
+
+std::vector<FilterChainSpec> LoadFilterChains(const common::config::Config& cfg, std::size_t channels, double sampleRateHz) {
+  if (!cfg.getBool("sensor.filters.enable", false)) return {};
+
+  std::string error;
+  FilterChainSpec defaultChain;
+  const std::string defaultText = cfg.getString("sensor.filters.default", "");
+  if (!ParseFilterChain(defaultText, sampleRateHz, defaultChain, error)) {
+    common::log::Warn("sensor", "sensor.filters.default ignored: " + error);
+    defaultChain.clear();
+  }
+
+  std::vector<FilterChainSpec> chains(channels, defaultChain);
+  bool any = !defaultChain.empty();
+  for (std::size_t ch = 0; ch < channels; ++ch) {
+    const std::string key = "sensor.filters.ch" + std::to_string(ch);
+    const std::string text = cfg.getString(key, "");
+    if (text.empty()) continue;
+    if (!ParseFilterChain(text, sampleRateHz, chains[ch], error)) {
+      common::log::Warn("sensor", key + " ignored: " + error);
+      chains[ch] = defaultChain;
+    }
+    any = any || !chains[ch].empty();
+  }
+  if (!any) return {};
+  return chains;
+}
+
+class FilterChain::Stage {
+public:
+  virtual ~Stage() = default;
+  virtual void process(double* x) = 0;
+  virtual void reset() = 0;
+  virtual std::string name() const = 0;
+};
+
+namespace {
+
+/** Running-sum moving average; inactive channels pass through via a 0/1 gain. */
+class MovingAverageStage : public FilterChain::Stage {
+public:
+  MovingAverageStage(std::size_t stride, std::size_t window, const std::vector<std::size_t>& active)
+      : _stride(stride), _window(window), _hist(stride * window), _sum(stride), _gain(stride) {
+    for (const auto ch : active) _gain[ch] = 1.0;
+  }
+
+  void process(double* x) override {
+    _count = std::min(_count + 1, _window);
+    const double inv = 1.0 / static_cast<double>(_count);
+    double* __restrict h = _hist.data() + _pos * _stride;
+    double* __restrict sum = _sum.data();
+    const double* __restrict gain = _gain.data();
+    for (std::size_t c = 0; c < _stride; c += kLanes) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        const std::size_t i = c + l;
+        const double in = x[i];
+        sum[i] += in - h[i];
+        h[i] = in;
+        x[i] = in + gain[i] * (sum[i] * inv - in);
+      }
+    }
+    if (++_pos == _window) {
+      _pos = 0;
+      // Re-derive the running sums periodically so rounding error cannot accumulate.
+      if (++_wraps % 1024 == 0) resum();
+    }
+  }
+
+  void reset() override {
+    std::fill(_hist.data(), _hist.data() + _hist.size(), 0.0);
+    std::fill(_sum.data(), _sum.data() + _sum.size(), 0.0);
+    _pos = 0;
+    _count = 0;
+    _wraps = 0;
+  }
+
+  std::string name() const override { return "ma(" + std::to_string(_window) + ")"; }
+
+private:
+  void resum() {
+    std::fill(_sum.data(), _sum.data() + _stride, 0.0);
+    for (std::size_t k = 0; k < _window; ++k) {
+      const double* h = _hist.data() + k * _stride;
+      for (std::size_t i = 0; i < _stride; ++i) _sum[i] += h[i];
+    }
+  }
+
+  std::size_t _stride;
+  std::size_t _window;
+  common::rt::AlignedBuffer<double> _hist;
+  common::rt::AlignedBuffer<double> _sum;
+  common::rt::AlignedBuffer<double> _gain;
+  std::size_t _pos{0};
+  std::size_t _count{0};
+  std::size_t _wraps{0};
+};
+
+/** Direct form II transposed biquad with per-channel coefficients. */
+class BiquadStage : public FilterChain::Stage {
+public:
+  BiquadStage(std::size_t stride, const std::vector<std::pair<std::size_t, const FilterSpec*>>& active)
+      : _stride(stride), _b0(stride), _b1(stride), _b2(stride), _a1(stride), _a2(stride), _z1(stride), _z2(stride) {
+    std::fill(_b0.data(), _b0.data() + stride, 1.0);
+    for (const auto& [ch, spec] : active) {
+      _b0[ch] = spec->biquad[0];
+      _b1[ch] = spec->biquad[1];
+      _b2[ch] = spec->biquad[2];
+      _a1[ch] = spec->biquad[3];
+      _a2[ch] = spec->biquad[4];
+    }
+  }
+
+  void process(double* x) override {
+    const double* __restrict b0 = _b0.data();
+    const double* __restrict b1 = _b1.data();
+    const double* __restrict b2 = _b2.data();
+    const double* __restrict a1 = _a1.data();
+    const double* __restrict a2 = _a2.data();
+    double* __restrict z1 = _z1.data();
+    double* __restrict z2 = _z2.data();
+    for (std::size_t c = 0; c < _stride; c += kLanes) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        const std::size_t i = c + l;
+        const double in = x[i];
+        const double y = b0[i] * in + z1[i];
+        z1[i] = b1[i] * in - a1[i] * y + z2[i];
+        z2[i] = b2[i] * in - a2[i] * y;
+        x[i] = y;
+      }
+    }
+  }
+
+  void reset() override {
+    std::fill(_z1.data(), _z1.data() + _stride, 0.0);
+    std::fill(_z2.data(), _z2.data() + _stride, 0.0);
+  }
+
+  std::string name() const override { return "biquad"; }
+
+private:
+  std::size_t _stride;
+  common::rt::AlignedBuffer<double> _b0, _b1, _b2, _a1, _a2, _z1, _z2;
+};
+
+/** FIR over a circular delay line; taps are zero-padded to the longest chain in the stage. */
+class FirStage : public FilterChain::Stage {
+public:
+  FirStage(std::size_t stride, const std::vector<std::pair<std::size_t, const FilterSpec*>>& active)
+      : _stride(stride) {
+    for (const auto& entry : active) _taps = std::max(_taps, entry.second->taps.size());
+    _coef = common::rt::AlignedBuffer<double>(_taps * stride);
+    _hist = common::rt::AlignedBuffer<double>(_taps * stride);
+    _acc = common::rt::AlignedBuffer<double>(stride);
+    std::fill(_coef.data(), _coef.data() + stride, 1.0);
+    for (const auto& [ch, spec] : active) {
+      for (std::size_t k = 0; k < _taps; ++k) {
+        _coef[k * stride + ch] = k < spec->taps.size() ? spec->taps[k] : 0.0;
+      }
+    }
+  }
+
+  void process(double* x) override {
+    std::copy(x, x + _stride, _hist.data() + _pos * _stride);
+    double* __restrict acc = _acc.data();
+    std::fill(acc, acc + _stride, 0.0);
+    for (std::size_t k = 0; k < _taps; ++k) {
+      const std::size_t slot = (_pos + _taps - k) % _taps;
+      const double* __restrict coef = _coef.data() + k * _stride;
+      const double* __restrict h = _hist.data() + slot * _stride;
+      for (std::size_t c = 0; c < _stride; c += kLanes) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          acc[c + l] += coef[c + l] * h[c + l];
+        }
+      }
+    }
+    std::copy(acc, acc + _stride, x);
+    _pos = (_pos + 1) % _taps;
+  }
+
+  void reset() override {
+    std::fill(_hist.data(), _hist.data() + _hist.size(), 0.0);
+    _pos = 0;
+  }
+
+  std::string name() const override { return "fir(" + std::to_string(_taps) + ")"; }
+
+private:
+  std::size_t _stride;
+  std::size_t _taps{1};
+  common::rt::AlignedBuffer<double> _coef;
+  common::rt::AlignedBuffer<double> _hist;
+  common::rt::AlignedBuffer<double> _acc;
+  std::size_t _pos{0};
+};
+
+} // namespace
+
+FilterChain::FilterChain() = default;
+
+FilterChain::FilterChain(std::size_t channels, std::size_t stride, const std::vector<FilterChainSpec>& perChannel)
+    : _channels(channels), _stride(stride) {
+  // Group stages by (position in chain, kind, MA window) so each group is one pass over all channels.
+  using Key = std::tuple<std::size_t, int, std::size_t>;
+  std::map<Key, std::vector<std::pair<std::size_t, const FilterSpec*>>> groups;
+  for (std::size_t ch = 0; ch < std::min(channels, perChannel.size()); ++ch) {
+    for (std::size_t pos = 0; pos < perChannel[ch].size(); ++pos) {
+      const auto& spec = perChannel[ch][pos];
+      const std::size_t window = spec.kind == FilterSpec::Kind::MovingAverage ? spec.window : 0;
+      groups[Key{pos, static_cast<int>(spec.kind), window}].emplace_back(ch, &spec);
+    }
+  }
+
+  for (const auto& [key, members] : groups) {
+    switch (static_cast<FilterSpec::Kind>(std::get<1>(key))) {
+      case FilterSpec::Kind::MovingAverage: {
+        std::vector<std::size_t> active;
+        for (const auto& m : members) active.push_back(m.first);
+        _stages.push_back(std::make_unique<MovingAverageStage>(stride, std::get<2>(key), active));
+        break;
+      }
+      case FilterSpec::Kind::Biquad:
+        _stages.push_back(std::make_unique<BiquadStage>(stride, members));
+        break;
+      case FilterSpec::Kind::Fir:
+        _stages.push_back(std::make_unique<FirStage>(stride, members));
+        break;
+    }
+  }
+}
+
+FilterChain::~FilterChain() = default;
+FilterChain::FilterChain(FilterChain&&) noexcept = default;
+FilterChain& FilterChain::operator=(FilterChain&&) noexcept = default;
+
+void FilterChain::process(double* values) {
+  for (auto& stage : _stages) stage->process(values);
+}
+
+void FilterChain::reset() {
+  for (auto& stage : _stages) stage->reset();
+}
+
+std::string FilterChain::describe() const {
+  std::string out;
+  for (const auto& stage : _stages) {
+    if (!out.empty()) out += " -> ";
+    out += stage->name();
+  }
+  return out.empty() ? "none" : out;
+}
+
+} // namespace common::sensor
@@ -0,0 +1,62 @@
+#include "common/sensor/SensorFrameRing.h"
+
+#include "common/rt/CpuRelax.h"
+
+#include <algorithm>
+
+namespace common::sensor {
+
+namespace {
+constexpr std::size_t kDoublesPerLine = 64 / sizeof(double);
+
+std::size_t RoundUpToLine(std::size_t n) {
+  return (n + kDoublesPerLine - 1) / kDoublesPerLine * kDoublesPerLine;
+}
+} // namespace
+
+SensorFrameRing::SensorFrameRing(std::size_t channels, std::size_t depth)
+    : _channels(std::max<std::size_t>(1, channels)),
+      _stride(RoundUpToLine(_channels)),
+      _depth(std::max<std::size_t>(2, depth)),
+      _values(_stride * _depth),
+      _meta(new SlotMeta[_depth]) {}
+
+double* SensorFrameRing::beginWrite() {
+  auto& meta = _meta[_writeIndex];
+  meta.version.store(meta.version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  return _values.data() + _writeIndex * _stride;
+}
+
+void SensorFrameRing::publish(std::uint64_t seq, std::uint64_t monotonicNs) {
+  auto& meta = _meta[_writeIndex];
+  meta.seq.store(seq, std::memory_order_relaxed);
+  meta.monotonicNs.store(monotonicNs, std::memory_order_relaxed);
+  meta.version.store(meta.version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  _published.store(_writeIndex, std::memory_order_release);
+  _writeIndex = (_writeIndex + 1) % _depth;
+}
+
+SensorFrameView SensorFrameRing::latest() const {
+  for (;;) {
+    const std::size_t idx = _published.load(std::memory_order_acquire);
+    if (idx == kNone) return {};
+
+    const auto& meta = _meta[idx];
+    const std::uint64_t v = meta.version.load(std::memory_order_acquire);
+    if ((v & 1u) == 0) {
+      SensorFrameView view;
+      view.seq = meta.seq.load(std::memory_order_relaxed);
+      view.monotonicNs = meta.monotonicNs.load(std::memory_order_relaxed);
+      view.values = _values.data() + idx * _stride;
+      view.channels = _channels;
+      view._version = &meta.version;
+      view._expected = v;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (meta.version.load(std::memory_order_relaxed) == v) return view;
+    }
+    common::rt::CpuRelax();
+  }
+}
+
+} // namespace common::sensor
@@ -0,0 +1,187 @@
+#include "common/sensor/SensorHistory.h"
+#include "common/rt/PowerOfTwo.h"
+
+#include <algorithm>
+
+namespace common::sensor {
+
+namespace {
+
+using common::rt::RoundUpPow2;
+
+/**
+ * sum += x, keeping the rounding error of the addition in err (TwoSum). The plain sum grows without bound over a run;
+ * with the error term, the difference of two prefixes stays accurate to the size of the range, not of the run.
+ */
+void Accumulate(double& sum, double& err, double x) {
+  const double s = sum + x;
+  const double bp = s - sum;
+  err += (sum - (s - bp)) + (x - bp);
+  sum = s;
+}
+
+/** Sum of the samples after start up to and including end. */
+double RangeSum(double endSum, double endErr, double startSum, double startErr) {
+  return (endSum - startSum) + (endErr - startErr);
+}
+
+std::uint64_t SeqKey(const SensorSample& s) { return s.seq; }
+std::uint64_t TimeKey(const SensorSample& s) { return s.monotonicNs; }
+} // namespace
+
+bool SampleSpan::valid() const {
+  if (!_owner) return true;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return _owner->_claimed.load(std::memory_order_relaxed) <= _beginIndex + _owner->_capacity;
+}
+
+SensorHistory::SensorHistory(std::size_t capacity, const std::vector<std::size_t>& statWindows)
+    : _capacity(RoundUpPow2(capacity)),
+      _mask(static_cast<std::uint64_t>(_capacity - 1)),
+      _samples(_capacity),
+      _prefix(_capacity) {
+  for (const std::size_t w : statWindows) {
+    if (_windows.size() == kMaxStatWindows) break;
+    if (w == 0) continue;
+    const std::size_t length = std::min(w, _capacity - 1);
+    _windows.push_back(WindowState{length,
+                                   common::rt::MinWindow(length), common::rt::MinWindow(length), common::rt::MinWindow(length),
+                                   common::rt::MaxWindow(length), common::rt::MaxWindow(length), common::rt::MaxWindow(length)});
+  }
+}
+
+void SensorHistory::push(const SensorSample& sample) {
+  const std::uint64_t idx = _head.load(std::memory_order_relaxed);
+  _claimed.store(idx + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Accumulate(_running.a, _running.errA, sample.valueA);
+  Accumulate(_running.b, _running.errB, sample.valueB);
+  Accumulate(_running.c, _running.errC, sample.valueC);
+  _samples[idx & _mask] = sample;
+  _prefix[idx & _mask] = _running;
+  _head.store(idx + 1, std::memory_order_release);
+
+  if (_windows.empty()) return;
+
+  auto& out = _stats.back();
+  out.seq = sample.seq;
+  out.windowCount = static_cast<std::uint32_t>(_windows.size());
+  for (std::size_t i = 0; i < _windows.size(); ++i) {
+    auto& w = _windows[i];
+    w.minA.push(idx, sample.valueA);
+    w.minB.push(idx, sample.valueB);
+    w.minC.push(idx, sample.valueC);
+    w.maxA.push(idx, sample.valueA);
+    w.maxB.push(idx, sample.valueB);
+    w.maxC.push(idx, sample.valueC);
+
+    // Window [idx - length + 1, idx]: mean from the difference of two prefix sums.
+    const std::uint64_t filled = std::min<std::uint64_t>(idx + 1, w.length);
+    Prefix before{};
+    if (idx + 1 > w.length) before = _prefix[(idx - w.length) & _mask];
+    const double n = static_cast<double>(filled);
+
+    auto& ws = out.windows[i];
+    ws.windowSamples = static_cast<std::uint32_t>(w.length);
+    ws.filled = static_cast<std::uint32_t>(filled);
+    ws.a = {w.minA.value(), w.maxA.value(), RangeSum(_running.a, _running.errA, before.a, before.errA) / n};
+    ws.b = {w.minB.value(), w.maxB.value(), RangeSum(_running.b, _running.errB, before.b, before.errB) / n};
+    ws.c = {w.minC.value(), w.maxC.value(), RangeSum(_running.c, _running.errC, before.c, before.errC) / n};
+  }
+  _stats.publishSwap();
+}
+
+std::uint64_t SensorHistory::oldestIndex() const {
+  const std::uint64_t claimed = _claimed.load(std::memory_order_acquire);
+  return claimed > _capacity ? claimed - _capacity : 0;
+}
+
+template <typename Key>
+std::uint64_t SensorHistory::lowerBound(std::uint64_t lo, std::uint64_t hi, std::uint64_t value, Key key) const {
+  while (lo < hi) {
+    const std::uint64_t mid = lo + (hi - lo) / 2;
+    if (key(slot(mid)) < value) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+SampleSpan SensorHistory::makeSpan(std::uint64_t begin, std::uint64_t end, bool truncated) const {
+  SampleSpan span;
+  span._owner = this;
+  span._beginIndex = begin;
+  span.truncated = truncated;
+  if (end <= begin) return span;
+
+  const auto count = static_cast<std::size_t>(end - begin);
+  const auto start = static_cast<std::size_t>(begin & _mask);
+  span.first = _samples.data() + start;
+  span.firstCount = std::min(count, _capacity - start);
+  span.secondCount = count - span.firstCount;
+  span.second = span.secondCount ? _samples.data() : nullptr;
+  return span;
+}
+
+SampleSpan SensorHistory::sinceSeq(std::uint64_t fromSeq) const {
+  const std::uint64_t hi = _head.load(std::memory_order_acquire);
+  const std::uint64_t lo = oldestIndex();
+  if (lo >= hi) return makeSpan(hi, hi, false);
+
+  const std::uint64_t begin = lowerBound(lo, hi, fromSeq, SeqKey);
+  const bool truncated = lo > 0 && begin == lo && slot(lo).seq > fromSeq;
+  return makeSpan(begin, hi, truncated);
+}
+
+SampleSpan SensorHistory::between(std::uint64_t t0Ns, std::uint64_t t1Ns) const {
+  const std::uint64_t hi = _head.load(std::memory_order_acquire);
+  const std::uint64_t lo = oldestIndex();
+  if (lo >= hi || t1Ns < t0Ns) return makeSpan(hi, hi, false);
+
+  const std::uint64_t begin = lowerBound(lo, hi, t0Ns, TimeKey);
+  const std::uint64_t end = t1Ns == UINT64_MAX ? hi : lowerBound(begin, hi, t1Ns + 1, TimeKey);
+  const bool truncated = lo > 0 && begin == lo && slot(lo).monotonicNs > t0Ns;
+  return makeSpan(begin, end, truncated);
+}
+
+bool SensorHistory::indexOfSeq(std::uint64_t seq, std::uint64_t lo, std::uint64_t hi, std::uint64_t& index) const {
+  // Sequence numbers are normally contiguous, so try the direct offset from the newest sample first.
+  const std::uint64_t newest = slot(hi - 1).seq;
+  if (seq <= newest && newest - seq < hi - lo) {
+    const std::uint64_t guess = hi - 1 - (newest - seq);
+    if (slot(guess).seq == seq) {
+      index = guess;
+      return true;
+    }
+  }
+  index = lowerBound(lo, hi, seq, SeqKey);
+  return index < hi && slot(index).seq == seq;
+}
+
+bool SensorHistory::rangeMean(std::uint64_t fromSeq, std::uint64_t toSeq, double& a, double& b, double& c) const {
+  const std::uint64_t hi = _head.load(std::memory_order_acquire);
+  const std::uint64_t lo = oldestIndex();
+  if (lo >= hi || toSeq < fromSeq) return false;
+
+  std::uint64_t i = 0;
+  std::uint64_t j = 0;
+  if (!indexOfSeq(fromSeq, lo, hi, i) || !indexOfSeq(toSeq, lo, hi, j)) return false;
+  // Need the prefix just before i as well, unless i is the very first sample ever pushed.
+  if (i > 0 && i - 1 < lo) return false;
+
+  const Prefix end = _prefix[j & _mask];
+  const Prefix start = i > 0 ? _prefix[(i - 1) & _mask] : Prefix{};
+  const double n = static_cast<double>(j - i + 1);
+  a = RangeSum(end.a, end.errA, start.a, start.errA) / n;
+  b = RangeSum(end.b, end.errB, start.b, start.errB) / n;
+  c = RangeSum(end.c, end.errC, start.c, start.errC) / n;
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::uint64_t oldestUsed = i > 0 ? i - 1 : 0;
+  return _claimed.load(std::memory_order_relaxed) <= oldestUsed + _capacity;
+}
+
+} // namespace common::sensor
@@ -1,13 +1,22 @@
 #include "common/sensor/SensorPipeline.h"
 
+#include "common/config/Config.h"
 #include "common/log/Log.h"
+#include "common/rt/ThreadPolicy.h"
 #include "common/sensor/SensorSimulator.h"
+#include "common/trace/Spans.h"
 
+#include <algorithm>
 #include <chrono>
+#include <string>
 
 namespace common::sensor {
 
-SensorPipeline::SensorPipeline(Params params) : _params(params) {}
+SensorPipeline::SensorPipeline(Params params)
+    : _params(params),
+      _frames(params.channels, params.frameDepth),
+      _history(params.historyCapacity, params.statWindows),
+      _timer(common::rt::PeriodicTimer::WithRate(params.timing, params.rateHz)) {}
 
 SensorPipeline::~SensorPipeline() { stop(); }
 
@@ -23,29 +32,84 @@ void SensorPipeline::stop() {
 
 SensorSnapshot SensorPipeline::latest() const { return _channel.readSnapshot(); }
 
+SensorFrameView SensorPipeline::latestFrame() const { return _frames.latest(); }
+
 void SensorPipeline::run() {
   common::log::SetThreadName("sensor");
+  common::rt::ConfigureCurrentThread("sensor");
 
-  SensorSimulator sim(SensorSimulator::Params{_params.rateHz});
+  SensorSimulator sim(SensorSimulator::Params{_params.rateHz, _frames.channels(), _params.seed});
 
-  const auto period = std::chrono::duration<double>(1.0 / static_cast<double>(std::max(1, _params.rateHz)));
+  FilterChain filters(_frames.channels(), _frames.stride(), _params.filters);
+  const double periodNs = 1e9 / static_cast<double>(std::max(1, _params.rateHz));
+  double filterCostNs = 0.0;
+  std::uint64_t filterCostMaxNs = 0;
+  bool costWarned = false;
+  if (!filters.empty()) {
+    common::log::Info("sensor", "filter stage: " + filters.describe());
+  }
 
+  _timer.start();
   while (_running.load()) {
-    const auto t0 = std::chrono::steady_clock::now();
+    MRCD_TRACE_SPAN_VAR(span, "sensor.sample");
+    double* values = _frames.beginWrite();
+    auto sample = sim.generate(values);
+    MRCD_TRACE_SET_SEQ(span, sample.seq);
+
+    if (!filters.empty()) {
+      const auto f0 = std::chrono::steady_clock::now();
+      filters.process(values);
+      const auto costNs = static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - f0).count());
+      filterCostNs += (static_cast<double>(costNs) - filterCostNs) / 64.0;
+      filterCostMaxNs = std::max(filterCostMaxNs, costNs);
+      if (!costWarned && filterCostNs > 0.5 * periodNs) {
+        costWarned = true;
+        common::log::Warn("sensor", "filter stage uses " + std::to_string(static_cast<std::uint64_t>(filterCostNs)) +
+                                        " ns/sample, more than half the sensor period");
+      }
+
+      const std::size_t n = _frames.channels();
+      sample.valueA = values[0];
+      sample.valueB = n > 1 ? values[1] : 0.0;
+      sample.valueC = n > 2 ? values[2] : 0.0;
+    }
+
+    _frames.publish(sample.seq, sample.monotonicNs);
+    _history.push(sample);
 
     auto& back = _channel.back();
-    back.latest = sim.generate();
+    back.latest = sample;
     back.effectiveRateHz = sim.effectiveRateHz();
     back.missedDeadlines = sim.missedDeadlines();
+    back.channelCount = static_cast<std::uint32_t>(_frames.channels());
+    back.filterCostNs = filterCostNs;
+    back.filterCostMaxNs = filterCostMaxNs;
 
     _channel.publishSwap();
+    _notifier.publish(sample.seq);
+    MRCD_TRACE_SPAN_END(span);
 
-    const auto t1 = std::chrono::steady_clock::now();
-    const auto elapsed = t1 - t0;
-    if (elapsed < period) {
-      std::this_thread::sleep_for(period - elapsed);
-    }
+    _timer.wait();
+  }
+
+  common::log::Info("sensor", "timing: " + common::rt::Describe(_timer.stats()));
+}
+
+SensorPipeline::Params LoadSensorParams(const common::config::Config& cfg) {
+  SensorPipeline::Params p;
+  p.rateHz = cfg.getInt("sensor.rate_hz", 200);
+  p.channels = static_cast<std::size_t>(std::max(1, cfg.getInt("sensor.channels", 3)));
+  p.seed = static_cast<std::uint64_t>(std::max(0, cfg.getInt("sensor.seed", 0)));
+  p.frameDepth = static_cast<std::size_t>(std::max(2, cfg.getInt("sensor.frame_depth", 8)));
+  p.historyCapacity = static_cast<std::size_t>(std::max(2, cfg.getInt("sensor.history_capacity", 4096)));
+  p.statWindows.clear();
+  for (const int w : cfg.getIntList("sensor.stat_windows", {20, 200, 2000})) {
+    if (w > 0) p.statWindows.push_back(static_cast<std::size_t>(w));
   }
+  p.timing = common::rt::LoadTimerParams(cfg, "sensor", common::rt::OverrunPolicy::CatchUp);
+  p.filters = LoadFilterChains(cfg, p.channels, static_cast<double>(p.rateHz));
+  return p;
 }
 
 } // namespace common::sensor
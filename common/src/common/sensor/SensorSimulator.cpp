@@ -1,18 +1,112 @@
 #include "common/sensor/SensorSimulator.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <random>
 
 namespace common::sensor {
 
+namespace {
+constexpr double kTwoPi = 2.0 * 3.1415926535;
+constexpr double kNoiseSigma = 0.02;
+// Rotation recurrences drift in magnitude by ~1 ulp per step; pull them back well before it shows.
+constexpr std::uint32_t kRenormInterval = 256;
+
+std::uint64_t ResolveSeed(std::uint64_t seed) {
+  if (seed != 0) return seed;
+  std::random_device rd;
+  return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
+} // namespace
+
 static std::uint64_t NowMonotonicNs() {
   const auto now = std::chrono::steady_clock::now().time_since_epoch();
   return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
 }
 
 SensorSimulator::SensorSimulator(Params params)
-    : _params(params), _rng(std::random_device{}()), _last(std::chrono::steady_clock::now()) {}
+    : _params(params),
+      _padded((std::max<std::size_t>(1, params.channels) + kLanes - 1) / kLanes * kLanes),
+      _rng(ResolveSeed(params.seed)),
+      _cos(_padded),
+      _sin(_padded),
+      _rotCos(_padded),
+      _rotSin(_padded),
+      _amp(_padded),
+      _frame(_padded),
+      _last(std::chrono::steady_clock::now()) {
+  _params.channels = std::max<std::size_t>(1, _params.channels);
+  const double rate = static_cast<double>(std::max(1, _params.rateHz));
+  for (std::size_t ch = 0; ch < _padded; ++ch) {
+    // Padding lanes run a zero-amplitude oscillator so every block is uniform.
+    const auto shape = ch < _params.channels ? ShapeFor(ch) : ChannelShape{0.0, 0.0, 0.0};
+    const double delta = kTwoPi * shape.freqHz / rate;
+    _cos[ch] = std::cos(shape.phase);
+    _sin[ch] = std::sin(shape.phase);
+    _rotCos[ch] = std::cos(delta);
+    _rotSin[ch] = std::sin(delta);
+    _amp[ch] = shape.amplitude;
+  }
+}
+
+SensorSimulator::ChannelShape SensorSimulator::ShapeFor(std::size_t channel) {
+  // Channels 0..2 keep the original A/B/C signals; the rest are spread over 0.05..1.55 Hz.
+  switch (channel) {
+    case 0:
+      return {1.0, 0.8, 0.0};
+    case 1:
+      return {1.0, 0.3, kTwoPi / 4.0};
+    case 2:
+      return {0.5, 0.1, 0.0};
+    default:
+      break;
+  }
+  const double k = static_cast<double>(channel);
+  return {1.0 / static_cast<double>(1 + channel % 4), 0.05 + 0.1 * static_cast<double>(channel % 16), 0.37 * k};
+}
+
+void SensorSimulator::step() {
+  double* __restrict frame = _frame.data();
+  double* __restrict c = _cos.data();
+  double* __restrict s = _sin.data();
+  const double* __restrict rc = _rotCos.data();
+  const double* __restrict rs = _rotSin.data();
+  const double* __restrict amp = _amp.data();
+
+  const bool renorm = ++_sinceRenorm >= kRenormInterval;
+  if (renorm) _sinceRenorm = 0;
 
-SensorSample SensorSimulator::generate() {
+  // Blocks are taken in pairs: one Box-Muller draw feeds the cos half to block b and the sin half to b + 1.
+  double z0[kLanes];
+  double z1[kLanes];
+  for (std::size_t base = 0; base < _padded; base += 2 * kLanes) {
+    common::rt::GaussianPairs(_rng, z0, z1);
+    for (std::size_t half = 0; half < 2 && base + half * kLanes < _padded; ++half) {
+      const std::size_t off = base + half * kLanes;
+      const double* z = half == 0 ? z0 : z1;
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        const std::size_t i = off + l;
+        frame[i] = amp[i] * s[i] + kNoiseSigma * z[l];
+        const double nc = c[i] * rc[i] - s[i] * rs[i];
+        const double ns = s[i] * rc[i] + c[i] * rs[i];
+        c[i] = nc;
+        s[i] = ns;
+      }
+      if (renorm) {
+        // One Newton step of 1/sqrt(c^2 + s^2) around 1.
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          const std::size_t i = off + l;
+          const double k = 1.5 - 0.5 * (c[i] * c[i] + s[i] * s[i]);
+          c[i] *= k;
+          s[i] *= k;
+        }
+      }
+    }
+  }
+}
+
+SensorSample SensorSimulator::generate(double* out) {
   using clock = std::chrono::steady_clock;
 
   const auto now = clock::now();
@@ -23,15 +117,15 @@ SensorSample SensorSimulator::generate() {
     _effectiveRateHz.store(1.0 / dt);
   }
 
-  const double t = static_cast<double>(_seq) / static_cast<double>(std::max(1, _params.rateHz));
+  step();
+  std::memcpy(out, _frame.data(), _params.channels * sizeof(double));
 
   SensorSample s;
   s.seq = ++_seq;
   s.monotonicNs = NowMonotonicNs();
-
-  s.valueA = std::sin(2.0 * 3.1415926535 * 0.8 * t) + _noise(_rng);
-  s.valueB = std::cos(2.0 * 3.1415926535 * 0.3 * t) + _noise(_rng);
-  s.valueC = 0.5 * std::sin(2.0 * 3.1415926535 * 0.1 * t) + _noise(_rng);
+  s.valueA = out[0];
+  s.valueB = _params.channels > 1 ? out[1] : 0.0;
+  s.valueC = _params.channels > 2 ? out[2] : 0.0;
 
   // Missed-deadline heuristic: if loop period exceeds 2x expected.
   const double expected = 1.0 / static_cast<double>(std::max(1, _params.rateHz));
@@ -42,4 +136,25 @@ SensorSample SensorSimulator::generate() {
   return s;
 }
 
+void SensorSimulator::generateBatch(std::size_t k, double* out, std::size_t stride, SensorSample* headers) {
+  const std::uint64_t startNs = NowMonotonicNs();
+  const double periodNs = 1e9 / static_cast<double>(std::max(1, _params.rateHz));
+
+  for (std::size_t i = 0; i < k; ++i) {
+    step();
+    double* dst = out + i * stride;
+    std::memcpy(dst, _frame.data(), _params.channels * sizeof(double));
+    ++_seq;
+
+    if (headers) {
+      SensorSample& h = headers[i];
+      h.seq = _seq;
+      h.monotonicNs = startNs + static_cast<std::uint64_t>(periodNs * static_cast<double>(i));
+      h.valueA = dst[0];
+      h.valueB = _params.channels > 1 ? dst[1] : 0.0;
+      h.valueC = _params.channels > 2 ? dst[2] : 0.0;
+    }
+  }
+}
+
 } // namespace common::sensor
@@ -0,0 +1,67 @@
+#include "common/status/ProcessStats.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <cstring>
+#endif
+
+#include <cstdio>
+
+namespace common::status {
+
+namespace {
+
+#if defined(__linux__)
+/** "<key>:   1234 kB" from /proc/self/status, in bytes. */
+std::uint64_t ProcStatusKb(const char* key) {
+  std::FILE* f = std::fopen("/proc/self/status", "r");
+  if (!f) return 0;
+  char line[256];
+  std::uint64_t bytes = 0;
+  const std::size_t keyLen = std::strlen(key);
+  while (std::fgets(line, sizeof line, f)) {
+    if (std::strncmp(line, key, keyLen) == 0 && line[keyLen] == ':') {
+      unsigned long long kb = 0;
+      if (std::sscanf(line + keyLen + 1, "%llu", &kb) == 1) bytes = kb * 1024;
+      break;
+    }
+  }
+  std::fclose(f);
+  return bytes;
+}
+#endif
+
+} // namespace
+
+std::uint64_t ResidentBytes() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc{};
+  return GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof pmc) ? pmc.WorkingSetSize : 0;
+#elif defined(__linux__)
+  return ProcStatusKb("VmRSS");
+#else
+  return 0;
+#endif
+}
+
+std::uint64_t PeakResidentBytes() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc{};
+  return GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof pmc) ? pmc.PeakWorkingSetSize : 0;
+#elif defined(__linux__)
+  return ProcStatusKb("VmHWM");
+#else
+  return 0;
+#endif
+}
+
+std::string DescribeMemory() {
+  char buf[64];
+  std::snprintf(buf, sizeof buf, "rss_mb=%.1f peak_rss_mb=%.1f", static_cast<double>(ResidentBytes()) / (1024.0 * 1024.0),
+                static_cast<double>(PeakResidentBytes()) / (1024.0 * 1024.0));
+  return buf;
+}
+
+} // namespace common::status
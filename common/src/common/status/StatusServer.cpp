@@ -0,0 +1,150 @@
+#include "common/status/StatusServer.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+
+#include <Poco/Exception.h>
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerParams.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketAddress.h>
+
+#include <cstdio>
+
+namespace common::status {
+
+namespace {
+
+void AppendLine(std::string& out, const std::string& name, const std::string& value) {
+  out += name;
+  out += ' ';
+  out += value;
+  out += '\n';
+}
+
+/** Free text on one line: backslash, CR and LF become \\, \r and \n, other control characters are dropped. */
+std::string OneLine(const std::string& text) {
+  std::string out;
+  out.reserve(text.size());
+  for (const char c : text) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (c == '\r') {
+      out += "\\r";
+    } else if (static_cast<unsigned char>(c) >= 0x20) {
+      out += c;
+    }
+  }
+  return out;
+}
+
+std::string Number(double v) {
+  char buf[32];
+  std::snprintf(buf, sizeof buf, "%.6g", v);
+  return buf;
+}
+
+class StatusHandler : public Poco::Net::HTTPRequestHandler {
+public:
+  explicit StatusHandler(const StatusServer& server) : _server(server) {}
+
+  void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override {
+    // Match the path only: "/status?x=1" is still the status page.
+    const std::string& uri = request.getURI();
+    const std::string path = uri.substr(0, uri.find_first_of("?#"));
+    response.setContentType("text/plain; charset=utf-8");
+    if (path != "/" && path != "/status") {
+      response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+      response.send() << "not found\n";
+      return;
+    }
+    const std::string body = _server.render();
+    response.setContentLength(static_cast<std::streamsize>(body.size()));
+    response.send() << body;
+  }
+
+private:
+  const StatusServer& _server;
+};
+
+class StatusHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory {
+public:
+  explicit StatusHandlerFactory(const StatusServer& server) : _server(server) {}
+
+  Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&) override {
+    return new StatusHandler(_server);
+  }
+
+private:
+  const StatusServer& _server;
+};
+
+} // namespace
+
+StatusServer::StatusServer(const StatusStore& store, Params params, Extra extra)
+    : _store(store), _params(std::move(params)), _extra(std::move(extra)) {}
+
+StatusServer::~StatusServer() {
+  stop();
+}
+
+bool StatusServer::start() {
+  if (_server) return true;
+  if (_params.port <= 0) return false;
+  try {
+    Poco::Net::ServerSocket socket(Poco::Net::SocketAddress(_params.host, static_cast<Poco::UInt16>(_params.port)));
+    auto* httpParams = new Poco::Net::HTTPServerParams;
+    httpParams->setMaxThreads(1);
+    httpParams->setMaxQueued(8);
+    httpParams->setKeepAlive(false);
+    _server = std::make_unique<Poco::Net::HTTPServer>(new StatusHandlerFactory(*this), socket, httpParams);
+    _server->start();
+  } catch (const Poco::Exception& e) {
+    common::log::Warn("status", "status server on " + _params.host + ":" + std::to_string(_params.port) +
+                                    " not started: " + e.displayText());
+    _server.reset();
+    return false;
+  }
+  common::log::Info("status", "status at http://" + _params.host + ":" + std::to_string(_params.port) + "/status");
+  return true;
+}
+
+void StatusServer::stop() {
+  if (!_server) return;
+  _server->stopAll(true);
+  _server.reset();
+}
+
+std::string StatusServer::render() const {
+  std::string out = FormatStatus(_store.read(), _store.registry().collect());
+  if (_extra) _extra(out);
+  return out;
+}
+
+std::string FormatStatus(const StatusSnapshot& s, const std::vector<MetricsRegistry::Sample>& metrics) {
+  std::string out;
+  out.reserve(64 * (8 + metrics.size()));
+  AppendLine(out, "system_state", ToString(s.systemState));
+  AppendLine(out, "safety_state", ToString(s.safetyState));
+  AppendLine(out, "algo_health", ToString(s.algoHealth));
+  AppendLine(out, "last_error", std::to_string(static_cast<std::uint32_t>(s.lastError)));
+  if (!s.lastErrorMessage.empty()) AppendLine(out, "last_error_message", OneLine(s.lastErrorMessage));
+  if (!s.estopReason.empty()) AppendLine(out, "estop_reason", OneLine(s.estopReason));
+  for (const auto& m : metrics) AppendLine(out, m.name, Number(m.value));
+  return out;
+}
+
+StatusServer::Params LoadStatusServerParams(const common::config::Config& cfg) {
+  StatusServer::Params p;
+  p.host = cfg.getString("status.host", p.host);
+  p.port = cfg.getInt("status.port", p.port);
+  return p;
+}
+
+} // namespace common::status
@@ -0,0 +1,92 @@
+#include "common/trace/SampleTrace.h"
+
+#include <algorithm>
+
+namespace common::trace {
+
+namespace {
+
+using common::rt::FormatUs;
+
+std::string DescribeLine(const char* name, const common::rt::LatencySnapshot& s) {
+  return std::string(name) + " n=" + std::to_string(s.count) + " mean_us=" + FormatUs(static_cast<std::uint64_t>(s.meanNs())) +
+         " p50_us=" + FormatUs(s.percentileNs(0.5)) + " p99_us=" + FormatUs(s.percentileNs(0.99)) + " max_us=" + FormatUs(s.maxNs);
+}
+
+} // namespace
+
+const char* ToString(Stage s) {
+  switch (s) {
+    case Stage::SensorSample: return "sensor_sample";
+    case Stage::SensorPublish: return "sensor_publish";
+    case Stage::ControlPickup: return "control_pickup";
+    case Stage::IpcSend: return "ipc_send";
+    case Stage::WorkerReceive: return "worker_receive";
+    case Stage::ComputeStart: return "compute_start";
+    case Stage::ComputeEnd: return "compute_end";
+    case Stage::ResultReceive: return "result_receive";
+    case Stage::ActuatorApply: return "actuator_apply";
+  }
+  return "unknown";
+}
+
+TraceAggregator::TraceAggregator(Params params)
+    : _params(params), _ring(params.exportCapacity) {
+  _params.exportCapacity = _ring.capacity();
+}
+
+void TraceAggregator::record(const SampleTrace& t) {
+  if (!t.has(Stage::SensorSample) || !t.has(Stage::ActuatorApply)) {
+    _incomplete.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  std::uint64_t prev = t.at(Stage::SensorSample);
+  for (std::size_t i = 1; i < kStageCount; ++i) {
+    const auto now = t.ns[i];
+    if (now == 0) continue;
+    // Cross-thread stamps can be a few ns out of order; clamp instead of wrapping.
+    _hops[i].record(now > prev ? now - prev : 0);
+    prev = std::max(prev, now);
+  }
+  const auto e2e = t.at(Stage::ActuatorApply) - std::min(t.at(Stage::ActuatorApply), t.at(Stage::SensorSample));
+  _endToEnd.record(e2e);
+
+  const auto n = _recorded.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (_params.exportEvery == 0 || n % _params.exportEvery != 0) return;
+
+  (void)_ring.tryPush(t);
+}
+
+std::size_t TraceAggregator::drainSamples(std::vector<SampleTrace>& out) { return _ring.drain(out); }
+
+std::string TraceAggregator::describe() const {
+  std::string out = DescribeLine("end_to_end", endToEnd());
+  for (std::size_t i = 1; i < kStageCount; ++i) {
+    out += "\n  ";
+    out += DescribeLine(ToString(static_cast<Stage>(i)), hop(static_cast<Stage>(i)));
+  }
+  out += "\n  incomplete=" + std::to_string(incomplete()) + " export_dropped=" + std::to_string(exportDropped());
+  return out;
+}
+
+std::string CsvHeader() {
+  std::string out = "sensor_seq";
+  for (std::size_t i = 0; i < kStageCount; ++i) {
+    out += ',';
+    out += ToString(static_cast<Stage>(i));
+    out += "_ns";
+  }
+  return out;
+}
+
+std::string ToCsvRow(const SampleTrace& t) {
+  std::string out = std::to_string(t.sensorSeq);
+  for (const auto ns : t.ns) {
+    out += ',';
+    out += std::to_string(ns);
+  }
+  return out;
+}
+
+} // namespace common::trace
@@ -0,0 +1,206 @@
+#include "common/trace/Spans.h"
+
+#include "common/config/Config.h"
+#include "common/log/Log.h"
+#include "common/rt/SpscRing.h"
+
+#include <Poco/Process.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common::trace {
+
+namespace detail {
+std::atomic<bool> gSpansEnabled{false};
+} // namespace detail
+
+namespace {
+
+struct Event {
+  const char* name;
+  std::uint64_t startNs;
+  std::uint64_t endNs;
+  std::uint64_t seq;
+};
+
+/** Complete events of one thread: the owning thread produces, the flusher consumes. */
+struct Ring {
+  Ring(std::uint32_t capacity, std::uint32_t tid, std::string name)
+      : events(capacity), tid(tid), threadName(std::move(name)) {}
+
+  common::rt::SpscRing<Event> events;
+  const std::uint32_t tid;
+  const std::string threadName;
+  bool nameWritten{false};  // flusher only
+  /** Set when the owning thread exits; the flusher frees the ring once drained. */
+  std::atomic<bool> retired{false};
+};
+
+struct RingHolder {
+  Ring* ring{nullptr};
+  ~RingHolder() {
+    if (ring) ring->retired.store(true, std::memory_order_release);
+  }
+};
+
+std::mutex gMu;  // rings, file, flusher state
+std::vector<std::unique_ptr<Ring>> gRings;
+SpanParams gParams;
+std::string gProcessName;
+std::FILE* gFile = nullptr;
+std::uint32_t gNextTid = 1;
+std::uint64_t gDroppedTotal = 0;
+std::thread gFlusher;
+std::atomic<bool> gFlusherRunning{false};
+
+thread_local RingHolder tRing;
+
+long ProcessId() { return static_cast<long>(Poco::Process::id()); }
+
+std::string Escaped(const std::string& s) {
+  std::string out;
+  for (const char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20) out += c;
+  }
+  return out;
+}
+
+void AppendUs(std::string& out, std::uint64_t ns) {
+  char buf[32];
+  std::snprintf(buf, sizeof buf, "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                static_cast<unsigned long long>(ns % 1000));
+  out += buf;
+}
+
+void AppendEvent(std::string& out, long pid, const Ring& r, const Event& e) {
+  out += "{\"name\":\"";
+  out += e.name;
+  out += "\",\"ph\":\"X\",\"pid\":";
+  out += std::to_string(pid);
+  out += ",\"tid\":";
+  out += std::to_string(r.tid);
+  out += ",\"ts\":";
+  AppendUs(out, e.startNs);
+  out += ",\"dur\":";
+  AppendUs(out, e.endNs > e.startNs ? e.endNs - e.startNs : 0);
+  if (e.seq != 0) {
+    // Flow v2: consecutive events with the same bind_id are linked, across threads and processes.
+    const auto seq = std::to_string(e.seq);
+    out += ",\"args\":{\"seq\":" + seq + "},\"bind_id\":\"seq" + seq + "\",\"flow_in\":true,\"flow_out\":true";
+  }
+  out += "},\n";
+}
+
+/** Caller holds gMu. */
+void DrainLocked() {
+  if (!gFile) return;
+  const long pid = ProcessId();
+  std::string out;
+  std::vector<Event> batch;
+  for (auto it = gRings.begin(); it != gRings.end();) {
+    Ring& r = **it;
+    if (!r.nameWritten) {
+      out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + std::to_string(pid) + ",\"tid\":" +
+             std::to_string(r.tid) + ",\"args\":{\"name\":\"" + Escaped(r.threadName) + "\"}},\n";
+      r.nameWritten = true;
+    }
+    const bool retired = r.retired.load(std::memory_order_acquire);
+    batch.clear();
+    r.events.drain(batch);
+    for (const auto& e : batch) AppendEvent(out, pid, r, e);
+
+    if (retired) {
+      gDroppedTotal += r.events.dropped();
+      it = gRings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (!out.empty()) {
+    std::fwrite(out.data(), 1, out.size(), gFile);
+    std::fflush(gFile);
+  }
+}
+
+void FlusherLoop() {
+  while (gFlusherRunning.load()) {
+    std::this_thread::sleep_for(gParams.flushInterval);
+    std::lock_guard<std::mutex> lk(gMu);
+    DrainLocked();
+  }
+}
+
+Ring* RegisterThread() {
+  std::lock_guard<std::mutex> lk(gMu);
+  std::string name = common::log::CurrentThreadName();
+  const auto tid = gNextTid++;
+  if (name.empty()) name = "thread-" + std::to_string(tid);
+  gRings.push_back(std::make_unique<Ring>(std::max<std::uint32_t>(16, gParams.ringEvents), tid, std::move(name)));
+  return gRings.back().get();
+}
+
+} // namespace
+
+void detail::Emit(const char* name, std::uint64_t startNs, std::uint64_t endNs, std::uint64_t seq) {
+  Ring* r = tRing.ring;
+  if (!r) r = tRing.ring = RegisterThread();
+  (void)r->events.tryPush(Event{name, startNs, endNs, seq});
+}
+
+SpanParams LoadSpanParams(const common::config::Config& cfg) {
+  SpanParams p;
+  p.enabled = cfg.getBool("trace.spans", p.enabled);
+  p.path = cfg.getString("trace.spans_file", p.path);
+  p.flushInterval = std::chrono::milliseconds(std::max(10, cfg.getInt("trace.spans_flush_ms", 100)));
+  p.ringEvents = static_cast<std::uint32_t>(std::max(16, cfg.getInt("trace.spans_ring_events", 8192)));
+  return p;
+}
+
+void StartSpans(const SpanParams& params, const std::string& processName) {
+  if (!params.enabled) return;
+  std::lock_guard<std::mutex> lk(gMu);
+  if (gFile) return;
+
+  gFile = std::fopen(params.path.c_str(), params.truncate ? "wb" : "ab");
+  if (!gFile) {
+    common::log::Warn("trace", "cannot open span trace file: " + params.path);
+    return;
+  }
+  gParams = params;
+  gProcessName = processName;
+
+  // JSON array format: the closing bracket is optional, so several processes can append to one file.
+  std::fseek(gFile, 0, SEEK_END);
+  std::string head = std::ftell(gFile) == 0 ? "[\n" : "";
+  head += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + std::to_string(ProcessId()) +
+          ",\"args\":{\"name\":\"" + Escaped(processName) + "\"}},\n";
+  std::fwrite(head.data(), 1, head.size(), gFile);
+  std::fflush(gFile);
+
+  gFlusherRunning.store(true);
+  gFlusher = std::thread(FlusherLoop);
+  detail::gSpansEnabled.store(true);
+  common::log::Info("trace", "span tracing to " + params.path);
+}
+
+void StopSpans() {
+  detail::gSpansEnabled.store(false);
+  if (gFlusherRunning.exchange(false) && gFlusher.joinable()) gFlusher.join();
+
+  std::lock_guard<std::mutex> lk(gMu);
+  if (!gFile) return;
+  DrainLocked();
+  std::uint64_t dropped = gDroppedTotal;
+  for (const auto& r : gRings) dropped += r->events.dropped();
+  std::fclose(gFile);
+  gFile = nullptr;
+  common::log::Info("trace", "span tracing stopped; dropped " + std::to_string(dropped) + " spans (ring full)");
+}
+
+} // namespace common::trace